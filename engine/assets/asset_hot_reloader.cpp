@@ -1,5 +1,7 @@
 #include "asset_hot_reloader.h"
 #include "core/logging.h"
+#include "core/jobs/job_system.h"
+#include "asset_manager.h"
 #include <algorithm>
 
 namespace action {
@@ -13,6 +15,8 @@ void AssetHotReloader::Initialize(AssetManager* assets, Editor* editor, JobSyste
     m_editor = editor;
     m_jobs = jobs;
     m_importer.Initialize(assets);
+    m_importer.SetJobSystem(jobs);
+    m_importer.SetDerivedDataCache(assets ? assets->GetDerivedDataCache() : nullptr);
     
     // Default import settings for Blender exports
     m_default_import_settings.scale = 1.0f;
@@ -25,6 +29,13 @@ void AssetHotReloader::Initialize(AssetManager* assets, Editor* editor, JobSyste
 
 void AssetHotReloader::Shutdown() {
     Stop();
+    
+    // Import jobs reference this object
+    while (m_imports_in_flight.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+    m_completed_imports.clear();
+    
     m_watch_directories.clear();
     m_watched_files.clear();
     m_imported_assets.clear();
@@ -56,6 +67,10 @@ void AssetHotReloader::AddWatchDirectory(const std::string& directory, bool recu
     // Initial scan
     ScanDirectory(directory, recursive);
     
+    if (m_using_file_events && !m_watcher.AddDirectory(directory, recursive)) {
+        LOG_WARN("No file events for {} until the watcher restarts", directory);
+    }
+    
     LOG_INFO("Added watch directory: {} (recursive={})", directory, recursive);
 }
 
@@ -65,6 +80,7 @@ void AssetHotReloader::RemoveWatchDirectory(const std::string& directory) {
     
     if (it != m_watch_directories.end()) {
         m_watch_directories.erase(it, m_watch_directories.end());
+        m_watcher.RemoveDirectory(directory);
         LOG_INFO("Removed watch directory: {}", directory);
     }
 }
@@ -104,8 +120,20 @@ void AssetHotReloader::Update() {
         m_pending_changes.clear();
     }
     
+    // Created/modified files are imported together as one parallel batch
+    std::vector<std::string> imports;
     for (const auto& [path, event] : changes) {
         OnFileChanged(path, event);
+        
+        bool reimport = event == FileWatchEvent::Created || event == FileWatchEvent::Modified;
+        if (reimport && m_auto_import &&
+            std::find(imports.begin(), imports.end(), path) == imports.end()) {
+            imports.push_back(path);
+        }
+    }
+    
+    if (!imports.empty()) {
+        ImportAssets(imports);
     }
 }
 
@@ -118,6 +146,8 @@ void AssetHotReloader::RefreshAll() {
 }
 
 void AssetHotReloader::WatchThread() {
+    if (m_use_file_events && WatchFileEvents()) return;
+    
     while (m_running) {
         // Sleep for watch interval
         std::this_thread::sleep_for(
@@ -125,88 +155,208 @@ void AssetHotReloader::WatchThread() {
         
         if (!m_running) break;
         
-        // Scan all directories
-        for (const auto& [directory, recursive] : m_watch_directories) {
-            if (!std::filesystem::exists(directory)) continue;
+        PollDirectories();
+    }
+}
+
+bool AssetHotReloader::WatchFileEvents() {
+    if (!DirectoryWatcher::IsSupported() || !m_watcher.Open()) return false;
+    
+    for (const auto& [directory, recursive] : m_watch_directories) {
+        if (!m_watcher.AddDirectory(directory, recursive)) {
+            LOG_WARN("File events unavailable for {}, falling back to polling", directory);
+            m_watcher.Close();
+            return false;
+        }
+    }
+    
+    m_using_file_events = true;
+    LOG_INFO("AssetHotReloader using file events ({} directory watches)", m_watcher.GetWatchCount());
+    
+    // Catch changes made between the initial scan and watch registration
+    PollDirectories();
+    
+    std::vector<DirectoryChangeEvent> events;
+    while (m_running) {
+        events.clear();
+        
+        // Short timeout: bounds Stop() latency and drives the debounce flush
+        if (!m_watcher.Poll(50, events)) {
+            LOG_WARN("File events failed, falling back to polling");
+            m_watcher.Close();
+            m_using_file_events = false;
+            return false;
+        }
+        
+        if (m_watcher.ConsumeOverflow()) {
+            LOG_WARN("File event queue overflowed, rescanning watched directories");
+            PollDirectories();
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& event : events) {
+            if (event.is_directory) {
+                // A removed directory takes its files along without per-file events
+                if (event.change == DirectoryChange::Deleted) {
+                    std::string prefix = event.path + "/";
+                    for (const auto& [path, file] : m_watched_files) {
+                        if (path.compare(0, prefix.size(), prefix) == 0) {
+                            m_pending_file_changes[path] = {now, false};
+                        }
+                    }
+                }
+                continue;
+            }
             
-            try {
-                if (recursive) {
-                    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
-                        if (!m_running) break;
-                        if (!entry.is_regular_file()) continue;
-                        
-                        std::string path = entry.path().string();
-                        if (!ShouldWatch(path)) continue;
+            if (!ShouldWatch(event.path)) continue;
+            
+            PendingFileChange& pending = m_pending_file_changes[event.path];
+            pending.last_event = now;
+            pending.writing = event.change != DirectoryChange::Deleted && !event.write_finished;
+        }
+        
+        FlushPendingFileChanges(now);
+    }
+    
+    m_watcher.Close();
+    m_pending_file_changes.clear();
+    m_using_file_events = false;
+    return true;
+}
+
+void AssetHotReloader::FlushPendingFileChanges(std::chrono::steady_clock::time_point now) {
+    auto debounce = std::chrono::duration<float>(m_debounce_interval);
+    
+    for (auto it = m_pending_file_changes.begin(); it != m_pending_file_changes.end();) {
+        auto quiet = now - it->second.last_event;
+        
+        // Files still open for writing get longer: exporters pause between passes
+        if (quiet < debounce || (it->second.writing && quiet < debounce * 4)) {
+            ++it;
+            continue;
+        }
+        
+        ResolveFileChange(it->first);
+        it = m_pending_file_changes.erase(it);
+    }
+}
+
+void AssetHotReloader::ResolveFileChange(const std::string& path) {
+    // Events only say something happened; the file's final state decides what
+    // (create + delete of a temp file = nothing, delete + create = modified)
+    std::error_code ec;
+    bool exists = std::filesystem::is_regular_file(path, ec);
+    auto write_time = exists ? std::filesystem::last_write_time(path, ec) : std::filesystem::file_time_type{};
+    size_t file_size = exists && !ec ? static_cast<size_t>(std::filesystem::file_size(path, ec)) : 0;
+    exists = exists && !ec;
+    
+    auto it = m_watched_files.find(path);
+    if (exists && it == m_watched_files.end()) {
+        WatchedFile wf;
+        wf.path = path;
+        wf.last_write_time = write_time;
+        wf.file_size = file_size;
+        wf.exists = true;
+        m_watched_files[path] = wf;
+        
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending_changes.push_back({path, FileWatchEvent::Created});
+    } else if (exists && (it->second.last_write_time != write_time || it->second.file_size != file_size)) {
+        it->second.last_write_time = write_time;
+        it->second.file_size = file_size;
+        
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending_changes.push_back({path, FileWatchEvent::Modified});
+    } else if (!exists && it != m_watched_files.end()) {
+        m_watched_files.erase(it);
+        
+        std::lock_guard<std::mutex> lock(m_pending_mutex);
+        m_pending_changes.push_back({path, FileWatchEvent::Deleted});
+    }
+}
+
+void AssetHotReloader::PollDirectories() {
+    // Scan all directories
+    for (const auto& [directory, recursive] : m_watch_directories) {
+        if (!std::filesystem::exists(directory)) continue;
+        
+        try {
+            if (recursive) {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+                    if (!m_running) return;
+                    if (!entry.is_regular_file()) continue;
+                    
+                    std::string path = entry.path().string();
+                    if (!ShouldWatch(path)) continue;
+                    
+                    auto write_time = entry.last_write_time();
+                    auto file_size = entry.file_size();
+                    
+                    auto it = m_watched_files.find(path);
+                    if (it == m_watched_files.end()) {
+                        // New file
+                        WatchedFile wf;
+                        wf.path = path;
+                        wf.last_write_time = write_time;
+                        wf.file_size = file_size;
+                        wf.exists = true;
+                        m_watched_files[path] = wf;
                         
-                        auto write_time = entry.last_write_time();
-                        auto file_size = entry.file_size();
+                        std::lock_guard<std::mutex> lock(m_pending_mutex);
+                        m_pending_changes.push_back({path, FileWatchEvent::Created});
+                    } else if (it->second.last_write_time != write_time) {
+                        // Modified
+                        it->second.last_write_time = write_time;
+                        it->second.file_size = file_size;
                         
-                        auto it = m_watched_files.find(path);
-                        if (it == m_watched_files.end()) {
-                            // New file
-                            WatchedFile wf;
-                            wf.path = path;
-                            wf.last_write_time = write_time;
-                            wf.file_size = file_size;
-                            wf.exists = true;
-                            m_watched_files[path] = wf;
-                            
-                            std::lock_guard<std::mutex> lock(m_pending_mutex);
-                            m_pending_changes.push_back({path, FileWatchEvent::Created});
-                        } else if (it->second.last_write_time != write_time) {
-                            // Modified
-                            it->second.last_write_time = write_time;
-                            it->second.file_size = file_size;
-                            
-                            std::lock_guard<std::mutex> lock(m_pending_mutex);
-                            m_pending_changes.push_back({path, FileWatchEvent::Modified});
-                        }
+                        std::lock_guard<std::mutex> lock(m_pending_mutex);
+                        m_pending_changes.push_back({path, FileWatchEvent::Modified});
                     }
-                } else {
-                    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
-                        if (!m_running) break;
-                        if (!entry.is_regular_file()) continue;
-                        
-                        std::string path = entry.path().string();
-                        if (!ShouldWatch(path)) continue;
+                }
+            } else {
+                for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+                    if (!m_running) return;
+                    if (!entry.is_regular_file()) continue;
+                    
+                    std::string path = entry.path().string();
+                    if (!ShouldWatch(path)) continue;
+                    
+                    auto write_time = entry.last_write_time();
+                    auto file_size = entry.file_size();
+                    
+                    auto it = m_watched_files.find(path);
+                    if (it == m_watched_files.end()) {
+                        WatchedFile wf;
+                        wf.path = path;
+                        wf.last_write_time = write_time;
+                        wf.file_size = file_size;
+                        wf.exists = true;
+                        m_watched_files[path] = wf;
                         
-                        auto write_time = entry.last_write_time();
-                        auto file_size = entry.file_size();
+                        std::lock_guard<std::mutex> lock(m_pending_mutex);
+                        m_pending_changes.push_back({path, FileWatchEvent::Created});
+                    } else if (it->second.last_write_time != write_time) {
+                        it->second.last_write_time = write_time;
+                        it->second.file_size = file_size;
                         
-                        auto it = m_watched_files.find(path);
-                        if (it == m_watched_files.end()) {
-                            WatchedFile wf;
-                            wf.path = path;
-                            wf.last_write_time = write_time;
-                            wf.file_size = file_size;
-                            wf.exists = true;
-                            m_watched_files[path] = wf;
-                            
-                            std::lock_guard<std::mutex> lock(m_pending_mutex);
-                            m_pending_changes.push_back({path, FileWatchEvent::Created});
-                        } else if (it->second.last_write_time != write_time) {
-                            it->second.last_write_time = write_time;
-                            it->second.file_size = file_size;
-                            
-                            std::lock_guard<std::mutex> lock(m_pending_mutex);
-                            m_pending_changes.push_back({path, FileWatchEvent::Modified});
-                        }
+                        std::lock_guard<std::mutex> lock(m_pending_mutex);
+                        m_pending_changes.push_back({path, FileWatchEvent::Modified});
                     }
                 }
-            } catch (const std::exception& e) {
-                LOG_ERROR("Error scanning directory {}: {}", directory, e.what());
             }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error scanning directory {}: {}", directory, e.what());
         }
-        
-        // Check for deleted files
-        for (auto it = m_watched_files.begin(); it != m_watched_files.end();) {
-            if (!std::filesystem::exists(it->first)) {
-                std::lock_guard<std::mutex> lock(m_pending_mutex);
-                m_pending_changes.push_back({it->first, FileWatchEvent::Deleted});
-                it = m_watched_files.erase(it);
-            } else {
-                ++it;
-            }
+    }
+    
+    // Check for deleted files
+    for (auto it = m_watched_files.begin(); it != m_watched_files.end();) {
+        if (!std::filesystem::exists(it->first)) {
+            std::lock_guard<std::mutex> lock(m_pending_mutex);
+            m_pending_changes.push_back({it->first, FileWatchEvent::Deleted});
+            it = m_watched_files.erase(it);
+        } else {
+            ++it;
         }
     }
 }
@@ -252,17 +402,11 @@ void AssetHotReloader::ScanDirectory(const std::string& directory, bool recursiv
 void AssetHotReloader::OnFileChanged(const std::string& path, FileWatchEvent event) {
     switch (event) {
         case FileWatchEvent::Created:
-            LOG_INFO("Asset created: {}", path);
-            if (m_auto_import) {
-                ImportAsset(path);
-            }
+            LOG_INFO("Asset created: {}", path);  // Imported by Update in one batch
             break;
             
         case FileWatchEvent::Modified:
             LOG_INFO("Asset modified: {}", path);
-            if (m_auto_import) {
-                ImportAsset(path);
-            }
             break;
             
         case FileWatchEvent::Deleted:
@@ -295,23 +439,15 @@ bool AssetHotReloader::ImportAsset(const std::string& path) {
         return false;
     }
     
-    // Create mesh handles from imported data
-    std::vector<MeshHandle> meshes = m_importer.CreateMeshes(result.scene, *m_assets);
+    // Create mesh handles from imported data (reimports keep their handles)
+    std::vector<MeshHandle> meshes = m_importer.ReplaceMeshes(result.scene, *m_assets, GetExistingMeshes(path));
     
     if (meshes.empty()) {
         LOG_WARN("No meshes imported from: {}", path);
         return false;
     }
     
-    // Track imported asset
-    ImportedAsset asset;
-    asset.source_path = path;
-    asset.asset_name = result.scene.meshes[0].name;
-    asset.mesh_handle = meshes[0];  // Primary mesh
-    asset.import_time = std::filesystem::file_time_type::clock::now();
-    asset.settings = m_default_import_settings;
-    
-    m_imported_assets[path] = asset;
+    TrackImportedAsset(path, result, meshes);
     
     LOG_INFO("Successfully imported {} ({} meshes, {} vertices, {:.1f}ms)",
              path, meshes.size(), result.scene.total_vertices, result.import_time_ms);
@@ -323,6 +459,70 @@ bool AssetHotReloader::ImportAsset(const std::string& path) {
     return true;
 }
 
+void AssetHotReloader::ImportAssets(const std::vector<std::string>& paths) {
+    std::vector<std::string> supported;
+    for (const auto& path : paths) {
+        if (m_importer.IsFormatSupported(path)) {
+            supported.push_back(path);
+        } else {
+            LOG_WARN("Unsupported format: {}", path);
+        }
+    }
+    
+    if (supported.size() == 1) {
+        ImportAsset(supported[0]);
+        return;
+    }
+    if (supported.empty()) return;
+    
+    LOG_INFO("Importing {} assets", supported.size());
+    
+    std::vector<std::vector<MeshHandle>> existing;
+    existing.reserve(supported.size());
+    for (const auto& path : supported) {
+        existing.push_back(GetExistingMeshes(path));
+    }
+    
+    BatchImportResult batch = m_importer.ImportBatch(supported, m_default_import_settings, true, 0, existing);
+    
+    for (size_t i = 0; i < supported.size(); i++) {
+        const ImportResult& result = batch.results[i];
+        const std::vector<MeshHandle>& meshes = batch.meshes[i];
+        
+        bool success = result.success && !meshes.empty();
+        if (!result.success) {
+            LOG_ERROR("Failed to import {}: {}", supported[i], result.error_message);
+        } else if (meshes.empty()) {
+            LOG_WARN("No meshes imported from: {}", supported[i]);
+        } else {
+            TrackImportedAsset(supported[i], result, meshes);
+        }
+        
+        if (m_reload_callback) {
+            m_reload_callback(supported[i], success);
+        }
+    }
+}
+
+std::vector<MeshHandle> AssetHotReloader::GetExistingMeshes(const std::string& path) const {
+    auto it = m_imported_assets.find(path);
+    if (it == m_imported_assets.end()) return {};
+    return it->second.meshes;
+}
+
+void AssetHotReloader::TrackImportedAsset(const std::string& path, const ImportResult& result,
+                                          const std::vector<MeshHandle>& meshes) {
+    ImportedAsset asset;
+    asset.source_path = path;
+    asset.asset_name = result.scene.meshes[0].name;
+    asset.mesh_handle = meshes[0];  // Primary mesh
+    asset.meshes = meshes;
+    asset.import_time = std::filesystem::file_time_type::clock::now();
+    asset.settings = m_default_import_settings;
+    
+    m_imported_assets[path] = asset;
+}
+
 bool AssetHotReloader::ImportFile(const std::string& filepath) {
     // Public method for manual import via file dialog
     return ImportAsset(filepath);
@@ -346,79 +546,74 @@ void AssetHotReloader::ImportFileAsync(const std::string& filepath) {
     
     LOG_INFO("Starting async import of: {}", filepath);
     
-    // Capture settings by value for the async task
+    // Capture settings by value for the import job
     ImportSettings settings = m_default_import_settings;
-    std::string path = filepath;
-    
-    // Launch async import task
-    PendingAsyncImport pending;
-    pending.filepath = filepath;
-    pending.start_time = std::chrono::steady_clock::now();
-    pending.future = std::async(std::launch::async, [this, path, settings]() {
-        return m_importer.Import(path, settings);
-    });
-    
-    std::lock_guard<std::mutex> lock(m_pending_imports_mutex);
-    m_pending_imports.push_back(std::move(pending));
+    auto start_time = std::chrono::steady_clock::now();
+    
+    auto import_job = [this, filepath, settings, start_time]() {
+        CompletedAsyncImport completed;
+        completed.filepath = filepath;
+        completed.start_time = start_time;
+        completed.result = m_importer.Import(filepath, settings);
+        
+        {
+            std::lock_guard<std::mutex> lock(m_completed_imports_mutex);
+            m_completed_imports.push_back(std::move(completed));
+        }
+        m_imports_in_flight.fetch_sub(1, std::memory_order_release);
+    };
+    
+    m_imports_in_flight.fetch_add(1, std::memory_order_relaxed);
+    if (m_jobs) {
+        m_jobs->Submit(std::move(import_job), JobPriority::Low);
+    } else {
+        import_job();  // No workers: import inline, still completed through HasCompletedImport
+    }
+}
+
+bool AssetHotReloader::IsImportPending() const {
+    std::lock_guard<std::mutex> lock(m_completed_imports_mutex);
+    return m_imports_in_flight.load(std::memory_order_acquire) > 0 || !m_completed_imports.empty();
 }
 
 bool AssetHotReloader::HasCompletedImport() {
-    std::lock_guard<std::mutex> lock(m_pending_imports_mutex);
+    CompletedAsyncImport import;
+    {
+        std::lock_guard<std::mutex> lock(m_completed_imports_mutex);
+        if (m_completed_imports.empty()) return false;
+        
+        // One per call: the caller inspects the imported asset after each
+        import = std::move(m_completed_imports.front());
+        m_completed_imports.erase(m_completed_imports.begin());
+    }
     
-    for (auto it = m_pending_imports.begin(); it != m_pending_imports.end(); ) {
-        // Check if future is ready (non-blocking)
-        if (it->future.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
-            try {
-                ImportResult result = it->future.get();
-                
-                auto elapsed = std::chrono::steady_clock::now() - it->start_time;
-                float elapsed_ms = std::chrono::duration<float, std::milli>(elapsed).count();
-                
-                if (!result.success) {
-                    LOG_ERROR("Async import failed {}: {}", it->filepath, result.error_message);
-                    it = m_pending_imports.erase(it);
-                    continue;
-                }
-                
-                // Create mesh handles on main thread (GPU upload)
-                std::vector<MeshHandle> meshes = m_importer.CreateMeshes(result.scene, *m_assets);
-                
-                if (meshes.empty()) {
-                    LOG_WARN("No meshes created from async import: {}", it->filepath);
-                    it = m_pending_imports.erase(it);
-                    continue;
-                }
-                
-                // Track imported asset
-                ImportedAsset asset;
-                asset.source_path = it->filepath;
-                asset.asset_name = result.scene.meshes[0].name;
-                asset.mesh_handle = meshes[0];
-                asset.import_time = std::filesystem::file_time_type::clock::now();
-                asset.settings = m_default_import_settings;
-                
-                m_imported_assets[it->filepath] = asset;
-                
-                LOG_INFO("Async import completed: {} ({} meshes, {} vertices, {:.1f}ms total)",
-                         it->filepath, meshes.size(), result.scene.total_vertices, elapsed_ms);
-                
-                if (m_reload_callback) {
-                    m_reload_callback(it->filepath, true);
-                }
-                
-                it = m_pending_imports.erase(it);
-                return true;  // Signal that an import completed
-                
-            } catch (const std::exception& e) {
-                LOG_ERROR("Async import exception for {}: {}", it->filepath, e.what());
-                it = m_pending_imports.erase(it);
-            }
-        } else {
-            ++it;
-        }
+    auto elapsed = std::chrono::steady_clock::now() - import.start_time;
+    float elapsed_ms = std::chrono::duration<float, std::milli>(elapsed).count();
+    
+    if (!import.result.success) {
+        LOG_ERROR("Async import failed {}: {}", import.filepath, import.result.error_message);
+        return false;
+    }
+    
+    // Create mesh handles on main thread (GPU upload)
+    std::vector<MeshHandle> meshes = m_importer.ReplaceMeshes(import.result.scene, *m_assets,
+                                                              GetExistingMeshes(import.filepath));
+    
+    if (meshes.empty()) {
+        LOG_WARN("No meshes created from async import: {}", import.filepath);
+        return false;
+    }
+    
+    TrackImportedAsset(import.filepath, import.result, meshes);
+    
+    LOG_INFO("Async import completed: {} ({} meshes, {} vertices, {:.1f}ms total)",
+             import.filepath, meshes.size(), import.result.scene.total_vertices, elapsed_ms);
+    
+    if (m_reload_callback) {
+        m_reload_callback(import.filepath, true);
     }
     
-    return false;
+    return true;  // Signal that an import completed
 }
 
 } // namespace action
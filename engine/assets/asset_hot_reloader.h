@@ -2,6 +2,7 @@
 
 #include "core/types.h"
 #include "asset_importer.h"
+#include "platform/directory_watcher.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -11,7 +12,6 @@
 #include <atomic>
 #include <mutex>
 #include <chrono>
-#include <future>
 
 namespace action {
 
@@ -21,11 +21,12 @@ class Editor;
 class JobSystem;
 
 /*
- * PendingAsyncImport - Tracks an in-progress async import
+ * CompletedAsyncImport - Async import finished on a worker, waiting for
+ * mesh creation on the main thread
  */
-struct PendingAsyncImport {
+struct CompletedAsyncImport {
     std::string filepath;
-    std::future<ImportResult> future;
+    ImportResult result;
     std::chrono::steady_clock::time_point start_time;
 };
 
@@ -56,18 +57,35 @@ struct ImportedAsset {
     std::string source_path;      // Original file path (e.g., Blender export)
     std::string asset_name;       // Name in engine
     MeshHandle mesh_handle;       // Handle to mesh (if applicable)
+    std::vector<MeshHandle> meshes;  // All meshes of the file; reimports replace them in place
     std::filesystem::file_time_type import_time;
     ImportSettings settings;
 };
 
+/*
+ * PendingFileChange - Raw file events seen for a path, waiting for the file to settle
+ */
+struct PendingFileChange {
+    std::chrono::steady_clock::time_point last_event;
+    bool writing = false;  // Written to but not closed yet
+};
+
 /*
  * AssetHotReloader - Watches directories for asset changes and reloads
  * 
+ * Change detection:
+ * - Linux: inotify (DirectoryWatcher). Events are debounced per file until it
+ *   has been quiet for the debounce interval, so exporters that write in
+ *   several passes (Blender) trigger one reimport of the finished file
+ * - Elsewhere, or when inotify is unavailable: polls timestamps every watch interval
+ * 
  * This enables seamless Blender workflow:
  * 1. User exports model from Blender to watched directory
  * 2. Hot reloader detects the new/modified file
  * 3. Asset is automatically imported/reimported
- * 4. Scene instances are updated with new geometry
+ * 4. Scene instances are updated with new geometry: reimports replace the
+ *    existing meshes in place (AssetManager::ReplaceMesh), so handles held by
+ *    nodes and entities stay valid and nothing is rebuilt
  * 
  * Usage:
  *   hotreloader.AddWatchDirectory("assets/models");
@@ -95,9 +113,16 @@ public:
     void SetAutoImport(bool enabled) { m_auto_import = enabled; }
     bool IsAutoImportEnabled() const { return m_auto_import; }
     
-    void SetWatchInterval(float seconds) { m_watch_interval = seconds; }
+    void SetWatchInterval(float seconds) { m_watch_interval = seconds; }  // Polling only
     float GetWatchInterval() const { return m_watch_interval; }
     
+    void SetDebounceInterval(float seconds) { m_debounce_interval = seconds; }
+    float GetDebounceInterval() const { return m_debounce_interval; }
+    
+    // File events when the platform has them (takes effect on Start); false forces polling
+    void SetUseFileEvents(bool enabled) { m_use_file_events = enabled; }
+    bool IsUsingFileEvents() const { return m_using_file_events; }
+    
     void SetDefaultImportSettings(const ImportSettings& settings) { 
         m_default_import_settings = settings; 
     }
@@ -131,9 +156,10 @@ public:
     // Manual import of a file (used by file dialog)
     bool ImportFile(const std::string& filepath);
     
-    // Async import - returns immediately, check IsImportPending() and GetCompletedImport()
+    // Async import on the job system - returns immediately, check IsImportPending()
+    // and HasCompletedImport() (which creates the meshes on the main thread)
     void ImportFileAsync(const std::string& filepath);
-    bool IsImportPending() const { return !m_pending_imports.empty(); }
+    bool IsImportPending() const;
     bool HasCompletedImport();
     
     // Get the importer for format checks
@@ -147,6 +173,18 @@ private:
     // Background watching thread
     void WatchThread();
     
+    // Event-driven watch loop; returns false if file events are unavailable or failed
+    bool WatchFileEvents();
+    
+    // One polling pass: diff all watched directories against m_watched_files
+    void PollDirectories();
+    
+    // Emit changes for debounced paths that have settled
+    void FlushPendingFileChanges(std::chrono::steady_clock::time_point now);
+    
+    // Compare a path's current state with m_watched_files and queue the difference
+    void ResolveFileChange(const std::string& path);
+    
     // Check a single directory for changes
     void ScanDirectory(const std::string& directory, bool recursive);
     
@@ -156,6 +194,16 @@ private:
     // Import/reimport an asset
     bool ImportAsset(const std::string& path);
     
+    // Import/reimport several assets as one parallel batch
+    void ImportAssets(const std::vector<std::string>& paths);
+    
+    // Meshes of an earlier import of path, to be replaced in place (empty if none)
+    std::vector<MeshHandle> GetExistingMeshes(const std::string& path) const;
+    
+    // Record a successful import (main thread, meshes already created)
+    void TrackImportedAsset(const std::string& path, const ImportResult& result,
+                            const std::vector<MeshHandle>& meshes);
+    
     // Check if a file should be watched
     bool ShouldWatch(const std::string& path) const;
     
@@ -165,12 +213,15 @@ private:
     AssetImporter m_importer;
     
     // Async import tracking
-    std::vector<PendingAsyncImport> m_pending_imports;
-    std::mutex m_pending_imports_mutex;
+    std::vector<CompletedAsyncImport> m_completed_imports;
+    mutable std::mutex m_completed_imports_mutex;
+    std::atomic<u32> m_imports_in_flight{0};  // Import jobs still running
     
     // Watch configuration
     std::vector<std::pair<std::string, bool>> m_watch_directories;  // path, recursive
     float m_watch_interval = 0.5f;  // Seconds between scans
+    float m_debounce_interval = 0.2f;  // Seconds a file must be quiet before it is reported
+    bool m_use_file_events = true;
     bool m_auto_import = true;
     ImportSettings m_default_import_settings;
     
@@ -178,6 +229,11 @@ private:
     std::unordered_map<std::string, WatchedFile> m_watched_files;
     std::unordered_map<std::string, ImportedAsset> m_imported_assets;
     
+    // File events (watch thread only, except Add/RemoveDirectory)
+    DirectoryWatcher m_watcher;
+    std::unordered_map<std::string, PendingFileChange> m_pending_file_changes;
+    std::atomic<bool> m_using_file_events{false};
+    
     // Threading
     std::thread m_watch_thread;
     std::atomic<bool> m_running{false};
@@ -1,11 +1,15 @@
 #include "asset_importer.h"
 #include "core/logging.h"
+#include "core/jobs/job_system.h"
+#include "core/profiler.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 // Assimp includes
 #include <assimp/Importer.hpp>
@@ -50,30 +54,245 @@ ImportResult AssetImporter::Import(const std::string& filepath, const ImportSett
     
     ReportProgress(0.0f, "Loading " + filepath);
     
-    // Use Assimp for all formats
-    result = ImportWithAssimp(filepath, settings);
+    // Derived data: unchanged source + settings skip Assimp and all post-processing
+    u64 cache_key = 0;
+    if (m_derived_data && m_derived_data->IsEnabled()) {
+        cache_key = ComputeImportKey(filepath, settings);
+        
+        std::vector<u8> blob;
+        if (cache_key != 0 && m_derived_data->Get(cache_key, blob)) {
+            if (DeserializeImport(blob, result)) {
+                result.from_cache = true;
+            } else {
+                m_derived_data->Remove(cache_key);
+                result = {};
+            }
+        }
+    }
     
-    if (result.success) {
-        // Apply post-processing
-        ReportProgress(0.8f, "Processing...");
-        ApplyTransform(result.scene, settings);
-        CalculateBounds(result.scene);
+    if (!result.from_cache) {
+        // Use Assimp for all formats
+        result = ImportWithAssimp(filepath, settings);
         
+        if (result.success) {
+            // Mesh bounds were computed by the mesh jobs
+            result.scene.scene_bounds = AABB();
+            for (const auto& mesh : result.scene.meshes) {
+                result.scene.scene_bounds.expand(mesh.bounds.min);
+                result.scene.scene_bounds.expand(mesh.bounds.max);
+            }
+            
+            if (settings.optimize_meshes) {
+                ReportProgress(0.85f, "Optimizing meshes...");
+                OptimizeMeshes(result.scene, settings.optimize, result);
+            }
+            
+            if (cache_key != 0) {
+                DerivedDataWriter writer;
+                SerializeImport(result, writer);
+                m_derived_data->Put(cache_key, writer.GetData());
+            }
+        }
+    }
+    
+    if (result.success) {
         result.scene.source_path = filepath;
         
+        if (!settings.cook_directory.empty()) {
+            ReportProgress(0.9f, "Cooking meshes...");
+            CookMeshes(result.scene, settings.cook_directory, settings.cook, result.cooked_mesh_paths);
+        }
+        
         auto end_time = std::chrono::high_resolution_clock::now();
         result.import_time_ms = std::chrono::duration<float, std::milli>(end_time - start_time).count();
         
-        LOG_INFO("Imported '{}': {} meshes, {} materials, {} verts, {} tris in {:.1f}ms",
-                 filepath, result.scene.meshes.size(), result.scene.materials.size(),
+        LOG_INFO("Imported '{}'{}: {} meshes, {} materials, {} verts, {} tris in {:.1f}ms",
+                 filepath, result.from_cache ? " (cached)" : "",
+                 result.scene.meshes.size(), result.scene.materials.size(),
                  result.scene.total_vertices, result.scene.total_triangles,
                  result.import_time_ms);
+        if (settings.optimize_meshes && !result.from_cache) {
+            LOG_INFO("  Optimized in {:.1f}ms: ACMR {:.3f} -> {:.3f}",
+                     result.optimize_time_ms, result.acmr_before, result.acmr_after);
+        }
     }
     
     ReportProgress(1.0f, "Done");
     return result;
 }
 
+// ============================================================================
+// Derived data cache
+// ============================================================================
+
+namespace {
+
+u64 HashFile(const std::filesystem::path& path, u64 seed) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return 0;
+    
+    std::vector<u8> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) return 0;
+    
+    return DerivedDataCache::HashBytes(bytes, seed);
+}
+
+u64 HashString(const std::string& value) {
+    return DerivedDataCache::HashBytes({reinterpret_cast<const u8*>(value.data()), value.size()});
+}
+
+void WriteNode(DerivedDataWriter& writer, const ImportedNode& node) {
+    writer.WriteString(node.name);
+    writer.Write(node.position);
+    writer.Write(node.rotation);
+    writer.Write(node.scale);
+    writer.WriteArray(node.mesh_indices);
+    writer.Write<u64>(node.children.size());
+    for (const auto& child : node.children) {
+        WriteNode(writer, child);
+    }
+}
+
+bool ReadNode(DerivedDataReader& reader, ImportedNode& node, u32 depth) {
+    if (depth > 256) return false;  // Corrupt blob, not a real hierarchy
+    
+    u64 child_count = 0;
+    if (!reader.ReadString(node.name) || !reader.Read(node.position) || !reader.Read(node.rotation) ||
+        !reader.Read(node.scale) || !reader.ReadArray(node.mesh_indices) || !reader.Read(child_count) ||
+        child_count > reader.Remaining()) {
+        return false;
+    }
+    
+    node.children.resize(child_count);
+    for (auto& child : node.children) {
+        if (!ReadNode(reader, child, depth + 1)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+u64 AssetImporter::ComputeImportKey(const std::string& filepath, const ImportSettings& settings) const {
+    PROFILE_SCOPE("AssetImporter::ComputeImportKey");
+    
+    u64 key = HashFile(filepath, ASSET_IMPORTER_VERSION);
+    if (key == 0) return 0;
+    
+    // Everything that changes the imported scene (cooking is keyed separately)
+    DerivedDataWriter writer;
+    writer.Write(settings.scale);
+    writer.Write(settings.flip_uvs);
+    writer.Write(settings.flip_winding);
+    writer.Write(settings.generate_normals);
+    writer.Write(settings.generate_tangents);
+    writer.Write(settings.merge_meshes);
+    writer.Write(settings.optimize_meshes);
+    writer.Write(settings.optimize.cache_size);
+    writer.Write(settings.optimize.optimize_overdraw);
+    writer.Write(settings.optimize.overdraw_threshold);
+    writer.Write(settings.fast_import);
+    writer.Write(settings.import_materials);
+    writer.Write(settings.import_textures);
+    writer.Write(settings.import_animations);
+    writer.Write(settings.source_up_axis);
+    key = DerivedDataCache::HashCombine(key, DerivedDataCache::HashBytes(writer.GetData()));
+    
+    // Texture paths are resolved against the model directory, and formats like
+    // OBJ/glTF pull in sidecar files (model.mtl, model.bin) sharing the stem
+    std::filesystem::path source(filepath);
+    std::filesystem::path directory = source.parent_path();
+    key = DerivedDataCache::HashCombine(key, HashString(directory.string()));
+    
+    std::error_code ec;
+    std::vector<std::filesystem::path> sidecars;
+    for (const auto& entry : std::filesystem::directory_iterator(directory.empty() ? "." : directory, ec)) {
+        const auto& path = entry.path();
+        if (path.stem() == source.stem() && path.filename() != source.filename() && entry.is_regular_file(ec)) {
+            sidecars.push_back(path);
+        }
+    }
+    std::sort(sidecars.begin(), sidecars.end());
+    for (const auto& path : sidecars) {
+        key = DerivedDataCache::HashCombine(key, HashString(path.filename().string()));
+        key = DerivedDataCache::HashCombine(key, HashFile(path, 0));
+    }
+    
+    return key;
+}
+
+void AssetImporter::SerializeImport(const ImportResult& result, DerivedDataWriter& writer) {
+    const ImportedScene& scene = result.scene;
+    
+    writer.Write<u64>(scene.meshes.size());
+    for (const auto& mesh : scene.meshes) {
+        writer.WriteString(mesh.name);
+        writer.WriteArray(mesh.vertices);
+        writer.WriteArray(mesh.indices);
+        writer.Write(mesh.bounds);
+        writer.Write(mesh.material_index);
+    }
+    
+    writer.Write<u64>(scene.materials.size());
+    for (const auto& material : scene.materials) {
+        writer.WriteString(material.name);
+        writer.Write(material.diffuse_color);
+        writer.Write(material.specular_color);
+        writer.Write(material.roughness);
+        writer.Write(material.metallic);
+        writer.Write(material.opacity);
+        writer.WriteString(material.diffuse_texture);
+        writer.WriteString(material.normal_texture);
+        writer.WriteString(material.roughness_texture);
+        writer.WriteString(material.metallic_texture);
+    }
+    
+    WriteNode(writer, scene.root_node);
+    writer.Write(scene.scene_bounds);
+    writer.Write(scene.total_vertices);
+    writer.Write(scene.total_triangles);
+    writer.Write(scene.total_nodes);
+    writer.Write(result.acmr_before);
+    writer.Write(result.acmr_after);
+}
+
+bool AssetImporter::DeserializeImport(std::span<const u8> blob, ImportResult& out_result) {
+    DerivedDataReader reader(blob);
+    ImportedScene& scene = out_result.scene;
+    
+    u64 mesh_count = 0;
+    if (!reader.Read(mesh_count) || mesh_count > reader.Remaining()) return false;
+    scene.meshes.resize(mesh_count);
+    for (auto& mesh : scene.meshes) {
+        if (!reader.ReadString(mesh.name) || !reader.ReadArray(mesh.vertices) || !reader.ReadArray(mesh.indices) ||
+            !reader.Read(mesh.bounds) || !reader.Read(mesh.material_index)) {
+            return false;
+        }
+    }
+    
+    u64 material_count = 0;
+    if (!reader.Read(material_count) || material_count > reader.Remaining()) return false;
+    scene.materials.resize(material_count);
+    for (auto& material : scene.materials) {
+        if (!reader.ReadString(material.name) || !reader.Read(material.diffuse_color) ||
+            !reader.Read(material.specular_color) || !reader.Read(material.roughness) ||
+            !reader.Read(material.metallic) || !reader.Read(material.opacity) ||
+            !reader.ReadString(material.diffuse_texture) || !reader.ReadString(material.normal_texture) ||
+            !reader.ReadString(material.roughness_texture) || !reader.ReadString(material.metallic_texture)) {
+            return false;
+        }
+    }
+    
+    if (!ReadNode(reader, scene.root_node, 0)) return false;
+    
+    bool ok = reader.Read(scene.scene_bounds) && reader.Read(scene.total_vertices) &&
+              reader.Read(scene.total_triangles) && reader.Read(scene.total_nodes) &&
+              reader.Read(out_result.acmr_before) && reader.Read(out_result.acmr_after);
+    
+    out_result.success = ok && reader.Remaining() == 0;
+    return out_result.success;
+}
+
 // ============================================================================
 // Assimp Importer - Universal format support
 // ============================================================================
@@ -95,8 +314,7 @@ ImportResult AssetImporter::ImportWithAssimp(const std::string& filepath, const
             flags |= aiProcess_CalcTangentSpace;
         }
         if (settings.optimize_meshes) {
-            flags |= aiProcess_JoinIdenticalVertices;
-            flags |= aiProcess_OptimizeMeshes;
+            flags |= aiProcess_OptimizeMeshes;  // Welding is done by the engine optimizer
             flags |= aiProcess_RemoveRedundantMaterials;
         }
         flags |= aiProcess_ValidateDataStructure;
@@ -138,10 +356,13 @@ ImportResult AssetImporter::ImportWithAssimp(const std::string& filepath, const
     
     ReportProgress(0.5f, "Extracting geometry...");
     
-    // Extract all meshes
-    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[i];
-        ImportedMesh imported_mesh = ProcessMesh(mesh, scene, settings);
+    // Meshes are independent: extract, scale, convert axes and bound each in its own job
+    u32 mesh_count = scene->mNumMeshes;
+    result.scene.meshes.resize(mesh_count);
+    
+    auto process = [&](u32 index, u32) {
+        ImportedMesh& imported_mesh = result.scene.meshes[index];
+        imported_mesh = ProcessMesh(scene->mMeshes[index], scene, settings);
         
         // Apply scale if set
         if (settings.scale != 1.0f) {
@@ -152,7 +373,19 @@ ImportResult AssetImporter::ImportWithAssimp(const std::string& filepath, const
             }
         }
         
-        result.scene.meshes.push_back(imported_mesh);
+        ApplyTransform(imported_mesh, settings);
+        CalculateBounds(imported_mesh);
+    };
+    
+    if (m_jobs && mesh_count > 1) {
+        m_jobs->Wait(m_jobs->ParallelFor(mesh_count, process, 1));
+    } else {
+        for (u32 i = 0; i < mesh_count; i++) {
+            process(i, 0);
+        }
+    }
+    
+    for (const auto& imported_mesh : result.scene.meshes) {
         result.scene.total_vertices += (u32)imported_mesh.vertices.size();
         result.scene.total_triangles += (u32)imported_mesh.indices.size() / 3;
     }
@@ -353,40 +586,32 @@ ImportResult AssetImporter::ImportFBX(const std::string& filepath, const ImportS
 // Helper Functions
 // ============================================================================
 
-void AssetImporter::ApplyTransform(ImportedScene& scene, const ImportSettings& settings) {
+void AssetImporter::ApplyTransform(ImportedMesh& mesh, const ImportSettings& settings) {
     // Note: Scale and axis conversion now handled by Assimp or ProcessMesh
     // This function kept for any additional post-processing needed
     
     // Apply axis conversion (Z-up to Y-up) if Assimp didn't fully handle it
     if (settings.source_up_axis == ImportSettings::UpAxis::Z) {
-        for (auto& mesh : scene.meshes) {
-            for (auto& vert : mesh.vertices) {
-                // Rotate -90 degrees around X axis (swap Y and Z, negate new Z)
-                float y = vert.position.y;
-                float z = vert.position.z;
-                vert.position.y = z;
-                vert.position.z = -y;
-                
-                // Also rotate normals
-                y = vert.normal.y;
-                z = vert.normal.z;
-                vert.normal.y = z;
-                vert.normal.z = -y;
-            }
+        for (auto& vert : mesh.vertices) {
+            // Rotate -90 degrees around X axis (swap Y and Z, negate new Z)
+            float y = vert.position.y;
+            float z = vert.position.z;
+            vert.position.y = z;
+            vert.position.z = -y;
+            
+            // Also rotate normals
+            y = vert.normal.y;
+            z = vert.normal.z;
+            vert.normal.y = z;
+            vert.normal.z = -y;
         }
     }
 }
 
-void AssetImporter::CalculateBounds(ImportedScene& scene) {
-    scene.scene_bounds = AABB();
-    
-    for (auto& mesh : scene.meshes) {
-        mesh.bounds = AABB();
-        for (const auto& vert : mesh.vertices) {
-            mesh.bounds.expand(vert.position);
-        }
-        scene.scene_bounds.expand(mesh.bounds.min);
-        scene.scene_bounds.expand(mesh.bounds.max);
+void AssetImporter::CalculateBounds(ImportedMesh& mesh) {
+    mesh.bounds = AABB();
+    for (const auto& vert : mesh.vertices) {
+        mesh.bounds.expand(vert.position);
     }
 }
 
@@ -434,27 +659,250 @@ void AssetImporter::FlipUVs(ImportedMesh& mesh) {
 }
 
 void AssetImporter::ReportProgress(float progress, const std::string& status) {
-    if (m_progress_callback) {
+    if (m_progress_callback && !m_batch_active.load(std::memory_order_relaxed)) {
         m_progress_callback(progress, status);
     }
 }
 
+void AssetImporter::OptimizeMeshes(ImportedScene& scene, const MeshOptimizeSettings& settings,
+                                   ImportResult& out_result) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    u32 mesh_count = static_cast<u32>(scene.meshes.size());
+    std::vector<MeshOptimizeStats> stats(mesh_count);
+    
+    auto optimize = [&](u32 index, u32) {
+        ImportedMesh& mesh = scene.meshes[index];
+        stats[index] = OptimizeMesh(mesh.vertices, mesh.indices, settings);
+    };
+    
+    // Meshes are independent; one job each (the optimizer itself is serial)
+    if (m_jobs && mesh_count > 1) {
+        m_jobs->Wait(m_jobs->ParallelFor(mesh_count, optimize, 1));
+    } else {
+        for (u32 i = 0; i < mesh_count; i++) {
+            optimize(i, 0);
+        }
+    }
+    
+    // Triangle-weighted scene ACMR; vertex totals change with welding
+    double weighted_before = 0.0;
+    double weighted_after = 0.0;
+    u32 triangles = 0;
+    scene.total_vertices = 0;
+    for (u32 i = 0; i < mesh_count; i++) {
+        u32 mesh_triangles = static_cast<u32>(scene.meshes[i].indices.size() / 3);
+        weighted_before += stats[i].acmr_before * mesh_triangles;
+        weighted_after += stats[i].acmr_after * mesh_triangles;
+        triangles += mesh_triangles;
+        scene.total_vertices += stats[i].vertices_after;
+    }
+    
+    if (triangles > 0) {
+        out_result.acmr_before = static_cast<float>(weighted_before / triangles);
+        out_result.acmr_after = static_cast<float>(weighted_after / triangles);
+    }
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    out_result.optimize_time_ms = std::chrono::duration<float, std::milli>(end_time - start_time).count();
+}
+
+BatchImportResult AssetImporter::ImportBatch(const std::vector<std::string>& filepaths,
+                                             const ImportSettings& settings, bool create_meshes,
+                                             u32 max_files_in_flight,
+                                             std::span<const std::vector<MeshHandle>> existing_meshes) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    BatchImportResult batch;
+    u32 file_count = static_cast<u32>(filepaths.size());
+    batch.results.resize(file_count);
+    batch.meshes.resize(file_count);
+    if (file_count == 0) return batch;
+    
+    if (create_meshes && !m_assets) {
+        LOG_WARN("ImportBatch: no AssetManager, meshes will not be created");
+        create_meshes = false;
+    }
+    
+    // Interleaved per-file progress would be meaningless; report finished files instead
+    m_batch_active.store(true, std::memory_order_relaxed);
+    auto report = [this](float progress, const std::string& status) {
+        if (m_progress_callback) {
+            m_progress_callback(progress, status);
+        }
+    };
+    report(0.0f, "Importing " + std::to_string(file_count) + " files...");
+    
+    u32 committed = 0;
+    auto commit = [&](u32 index) {
+        ImportResult& result = batch.results[index];
+        if (result.success) {
+            batch.succeeded++;
+            if (create_meshes) {
+                std::span<const MeshHandle> existing;
+                if (index < existing_meshes.size()) existing = existing_meshes[index];
+                batch.meshes[index] = ReplaceMeshes(result.scene, *m_assets, existing);
+            }
+        } else {
+            batch.failed++;
+        }
+        committed++;
+        report(static_cast<float>(committed) / file_count, "Imported " + filepaths[index]);
+    };
+    
+    if (m_jobs) {
+        // Bounded concurrency: each lane job pulls the next file until none are left
+        std::atomic<u32> next_file{0};
+        std::mutex finished_mutex;
+        std::vector<u32> finished;
+        
+        auto import_lane = [&](u32, u32) {
+            for (u32 i = next_file.fetch_add(1); i < file_count; i = next_file.fetch_add(1)) {
+                batch.results[i] = Import(filepaths[i], settings);
+                
+                std::lock_guard lock(finished_mutex);
+                finished.push_back(i);
+            }
+        };
+        
+        u32 lanes = max_files_in_flight > 0 ? max_files_in_flight : std::max(1u, m_jobs->GetWorkerCount());
+        lanes = std::min(lanes, file_count);
+        
+        // Low priority: the per-mesh jobs of files already parsing run first
+        JobHandle handle = m_jobs->ParallelFor(lanes, import_lane, 1, JobPriority::Low);
+        
+        // GPU work stays on this thread, overlapped with the files still parsing
+        std::vector<u32> ready;
+        while (committed < file_count) {
+            {
+                std::lock_guard lock(finished_mutex);
+                ready.swap(finished);
+            }
+            
+            if (ready.empty()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            
+            for (u32 index : ready) {
+                commit(index);
+            }
+            ready.clear();
+        }
+        
+        m_jobs->Wait(handle);
+    } else {
+        for (u32 i = 0; i < file_count; i++) {
+            batch.results[i] = Import(filepaths[i], settings);
+            commit(i);
+        }
+    }
+    
+    m_batch_active.store(false, std::memory_order_relaxed);
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    batch.import_time_ms = std::chrono::duration<float, std::milli>(end_time - start_time).count();
+    
+    LOG_INFO("Batch import: {}/{} files in {:.1f}ms ({} failed)",
+             batch.succeeded, file_count, batch.import_time_ms, batch.failed);
+    
+    return batch;
+}
+
+bool AssetImporter::CookMeshes(const ImportedScene& scene, const std::string& directory,
+                               const MeshCookSettings& settings, std::vector<std::string>& out_paths) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        LOG_ERROR("Cannot create cook directory {}: {}", directory, ec.message());
+        return false;
+    }
+    
+    std::string stem = std::filesystem::path(scene.source_path).stem().string();
+    bool all_written = true;
+    
+    for (size_t i = 0; i < scene.meshes.size(); i++) {
+        const ImportedMesh& imported_mesh = scene.meshes[i];
+        
+        // Cooked bytes are derived data of the mesh content and cook settings
+        u64 cook_key = 0;
+        std::vector<u8> bytes;
+        bool cooked = false;
+        if (m_derived_data && m_derived_data->IsEnabled()) {
+            cook_key = DerivedDataCache::HashBytes(
+                {reinterpret_cast<const u8*>(imported_mesh.vertices.data()), imported_mesh.vertices.size() * sizeof(Vertex)},
+                COOKED_MESH_VERSION);
+            cook_key = DerivedDataCache::HashCombine(cook_key, DerivedDataCache::HashBytes(
+                {reinterpret_cast<const u8*>(imported_mesh.indices.data()), imported_mesh.indices.size() * sizeof(u32)}));
+            cook_key = DerivedDataCache::HashCombine(cook_key, DerivedDataCache::HashBytes(
+                {reinterpret_cast<const u8*>(settings.lod_ratios.data()), settings.lod_ratios.size() * sizeof(float)},
+                settings.min_lod_triangles));
+            cooked = m_derived_data->Get(cook_key, bytes);
+        }
+        
+        if (!cooked) {
+            MeshData mesh_data;
+            mesh_data.name = imported_mesh.name;
+            mesh_data.vertices = imported_mesh.vertices;
+            mesh_data.indices = imported_mesh.indices;
+            
+            cooked = CookMesh(mesh_data, settings, bytes);
+            if (cooked && cook_key != 0) {
+                m_derived_data->Put(cook_key, bytes);
+            }
+        }
+        
+        std::string path = (std::filesystem::path(directory) / (stem + "_" + std::to_string(i) + ".mesh")).string();
+        if (cooked && WriteCookedMeshBytes(path, bytes)) {
+            out_paths.push_back(path);
+        } else {
+            all_written = false;
+        }
+    }
+    
+    LOG_INFO("Cooked {}/{} meshes to {}", out_paths.size(), scene.meshes.size(), directory);
+    return all_written;
+}
+
 std::vector<MeshHandle> AssetImporter::CreateMeshes(const ImportedScene& scene, AssetManager& assets) {
+    return ReplaceMeshes(scene, assets, {});
+}
+
+std::vector<MeshHandle> AssetImporter::ReplaceMeshes(const ImportedScene& scene, AssetManager& assets,
+                                                     std::span<const MeshHandle> existing) {
     std::vector<MeshHandle> handles;
     
-    for (const auto& imported_mesh : scene.meshes) {
+    for (size_t i = 0; i < scene.meshes.size(); i++) {
+        const ImportedMesh& imported_mesh = scene.meshes[i];
+        
         MeshData mesh_data;
         mesh_data.name = imported_mesh.name;
         mesh_data.vertices = imported_mesh.vertices;
         mesh_data.indices = imported_mesh.indices;
         mesh_data.bounds = imported_mesh.bounds;
         
+        // Same handle: entities and nodes pick up the new geometry without being rebuilt
+        if (i < existing.size() && assets.ReplaceMesh(existing[i], std::move(mesh_data))) {
+            handles.push_back(existing[i]);
+            continue;
+        }
+        
+        // New mesh in the file, or the old one is gone (mesh_data untouched by a failed replace).
+        // The new handle takes the old one's place, so its reference goes like a removed mesh's.
+        if (i < existing.size()) {
+            assets.Release(existing[i]);
+        }
         MeshHandle handle = assets.CreateMesh(mesh_data);
         if (handle.is_valid()) {
             handles.push_back(handle);
         }
     }
     
+    // Meshes removed from the file: drop the reference CreateMesh handed out
+    for (size_t i = scene.meshes.size(); i < existing.size(); i++) {
+        assets.Release(existing[i]);
+    }
+    
     return handles;
 }
 
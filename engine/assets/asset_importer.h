@@ -3,10 +3,15 @@
 #include "core/types.h"
 #include "core/math/math.h"
 #include "assets/asset_manager.h"
+#include "assets/mesh_format.h"
+#include "assets/mesh_optimizer.h"
+#include "assets/derived_data_cache.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <atomic>
+#include <span>
 
 // Forward declarations for Assimp types
 struct aiNode;
@@ -15,6 +20,11 @@ struct aiMesh;
 
 namespace action {
 
+class JobSystem;
+
+// Bump whenever import output changes: invalidates derived data of every import
+constexpr u32 ASSET_IMPORTER_VERSION = 1;
+
 /*
  * ImportedMesh - Data from an imported mesh
  */
@@ -93,9 +103,14 @@ struct ImportSettings {
     
     // Optimization
     bool merge_meshes = false;     // Combine all meshes into one
-    bool optimize_meshes = false;  // Optimize vertex cache (slow for large models)
+    bool optimize_meshes = true;   // Weld + vertex cache/overdraw/fetch order (engine optimizer)
+    MeshOptimizeSettings optimize;
     bool fast_import = true;       // Skip expensive post-processing for speed
     
+    // Cooking: write an engine-native .mesh per imported mesh (empty = off)
+    std::string cook_directory;
+    MeshCookSettings cook;
+    
     // Import components
     bool import_materials = true;
     bool import_textures = true;
@@ -114,8 +129,30 @@ struct ImportResult {
     std::string error_message;
     ImportedScene scene;
     
+    // Scene came from the derived data cache (no Assimp, no post-processing)
+    bool from_cache = false;
+    
+    // Cooked .mesh files written (when ImportSettings::cook_directory is set)
+    std::vector<std::string> cooked_mesh_paths;
+    
     // Import statistics
     float import_time_ms = 0.0f;
+    
+    // Mesh optimization (triangle-weighted ACMR, 32-entry FIFO cache)
+    float acmr_before = 0.0f;
+    float acmr_after = 0.0f;
+    float optimize_time_ms = 0.0f;
+};
+
+/*
+ * BatchImportResult - Result of importing many files at once
+ */
+struct BatchImportResult {
+    std::vector<ImportResult> results;            // One per input path, same order
+    std::vector<std::vector<MeshHandle>> meshes;  // Per file (empty unless meshes were created)
+    u32 succeeded = 0;
+    u32 failed = 0;
+    float import_time_ms = 0.0f;
 };
 
 /*
@@ -134,9 +171,25 @@ public:
     // Initialize importer
     void Initialize(AssetManager* assets);
     
-    // Import a 3D model file
+    // Optional: optimize meshes of a scene in parallel (serial without one)
+    void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+    
+    // Optional: reuse import and cook output keyed by source bytes + settings
+    void SetDerivedDataCache(DerivedDataCache* cache) { m_derived_data = cache; }
+    
+    // Import a 3D model file (thread-safe; meshes are processed as parallel jobs)
     ImportResult Import(const std::string& filepath, const ImportSettings& settings = {});
     
+    // Import many files on the job system (serially without one):
+    // - Up to max_files_in_flight files are parsed at once (0 = one per worker)
+    // - Each file's meshes are processed and optimized as separate jobs
+    // - GPU mesh creation runs on the calling thread as soon as a file finishes
+    // - existing_meshes (optional, per file): meshes of an earlier import, replaced in place
+    // Progress is reported once per finished file, on the calling thread.
+    BatchImportResult ImportBatch(const std::vector<std::string>& filepaths, const ImportSettings& settings = {},
+                                  bool create_meshes = true, u32 max_files_in_flight = 0,
+                                  std::span<const std::vector<MeshHandle>> existing_meshes = {});
+    
     // Check if a file format is supported
     bool IsFormatSupported(const std::string& filepath) const;
     
@@ -146,13 +199,28 @@ public:
     // Convert imported scene to engine mesh handles
     std::vector<MeshHandle> CreateMeshes(const ImportedScene& scene, AssetManager& assets);
     
-    // Progress callback for long imports
+    // Reimport: mesh i replaces existing[i] in place (same handle, instances keep
+    // drawing it); extra meshes are created, surplus existing ones released
+    std::vector<MeshHandle> ReplaceMeshes(const ImportedScene& scene, AssetManager& assets,
+                                          std::span<const MeshHandle> existing);
+    
+    // Optimize every mesh of the scene (one job per mesh); fills the ACMR stats
+    void OptimizeMeshes(ImportedScene& scene, const MeshOptimizeSettings& settings, ImportResult& out_result);
+    
+    // Write each mesh of the scene as <directory>/<source>_<index>.mesh
+    bool CookMeshes(const ImportedScene& scene, const std::string& directory,
+                    const MeshCookSettings& settings, std::vector<std::string>& out_paths);
+    
+    // Progress callback for long imports (Import: from the importing thread)
     using ProgressCallback = std::function<void(float progress, const std::string& status)>;
     void SetProgressCallback(ProgressCallback callback) { m_progress_callback = callback; }
     
 private:
     AssetManager* m_assets = nullptr;
+    JobSystem* m_jobs = nullptr;
+    DerivedDataCache* m_derived_data = nullptr;
     ProgressCallback m_progress_callback;
+    std::atomic<bool> m_batch_active{false};  // Per-file progress is muted during ImportBatch
     
     // Format-specific importers
     ImportResult ImportGLTF(const std::string& filepath, const ImportSettings& settings);
@@ -166,9 +234,14 @@ private:
     void ExtractMaterials(const aiScene* scene, ImportedScene& out_scene, const std::string& model_path);
     u32 CountNodes(const ImportedNode& node);
     
-    // Helper functions
-    void ApplyTransform(ImportedScene& scene, const ImportSettings& settings);
-    void CalculateBounds(ImportedScene& scene);
+    // Derived data: key covers source bytes, sidecar files, settings and ASSET_IMPORTER_VERSION
+    u64 ComputeImportKey(const std::string& filepath, const ImportSettings& settings) const;
+    static void SerializeImport(const ImportResult& result, DerivedDataWriter& writer);
+    static bool DeserializeImport(std::span<const u8> blob, ImportResult& out_result);
+    
+    // Helper functions (per mesh, run inside the mesh jobs)
+    void ApplyTransform(ImportedMesh& mesh, const ImportSettings& settings);
+    void CalculateBounds(ImportedMesh& mesh);
     void GenerateNormals(ImportedMesh& mesh);
     void GenerateTangents(ImportedMesh& mesh);
     void FlipWindingOrder(ImportedMesh& mesh);
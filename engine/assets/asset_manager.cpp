@@ -1,25 +1,67 @@
 #include "asset_manager.h"
+#include "mesh_format.h"
 #include "core/logging.h"
 #include "core/profiler.h"
 #include "core/math/math.h"
 #include "platform/vulkan/vulkan_context.h"
+#include "platform/mapped_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <filesystem>
 #include <cstring>
+#include <memory>
 
 namespace action {
 
+namespace {
+
+// IDs must come from MakeAssetID: a StringID constructed from a raw path is
+// neither normalized nor interned, so there is no path to load it from
+bool IsLoadableID(AssetID id) {
+    if (!id.IsValid()) return false;
+    if (id.GetString().empty()) {
+        LOG_ERROR("Asset ID {} has no interned path (not created with MakeAssetID)", id.ToHex());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 bool AssetManager::Initialize(const AssetManagerConfig& config) {
     m_config = config;
+    m_start_time = std::chrono::steady_clock::now();
     
     LOG_INFO("AssetManager initialized");
     LOG_INFO("  Texture pool: {} MB", config.texture_pool_size / (1024 * 1024));
     LOG_INFO("  Mesh pool: {} MB", config.mesh_pool_size / (1024 * 1024));
     LOG_INFO("  Upload budget: {} MB/frame", config.upload_budget_per_frame / (1024 * 1024));
     
+    // Not fatal: without a cache every load decodes
+    m_derived_data.Initialize(config.derived_data);
+    
     return true;
 }
 
 void AssetManager::Shutdown() {
+    // Jobs capture this; let in-flight reads/decodes drain before tearing down
+    while (m_loads_in_flight.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+    
+    {
+        std::lock_guard lock(m_queue_mutex);
+        m_load_queue.clear();
+    }
+    {
+        std::lock_guard lock(m_ready_mutex);
+        m_ready.clear();
+    }
+    m_mesh_callbacks.clear();
+    m_texture_callbacks.clear();
+    
     // Release all GPU resources
     if (m_vulkan_context) {
         VkDevice device = m_vulkan_context->GetDevice();
@@ -28,31 +70,40 @@ void AssetManager::Shutdown() {
         vkDeviceWaitIdle(device);
         
         // Destroy mesh GPU resources
-        for (auto& [handle, mesh] : m_meshes) {
-            if (mesh.gpu_vertex_buffer) {
-                vkDestroyBuffer(device, reinterpret_cast<VkBuffer>(mesh.gpu_vertex_buffer), nullptr);
-                mesh.gpu_vertex_buffer = nullptr;
-            }
-            if (mesh.gpu_vertex_memory) {
-                vkFreeMemory(device, reinterpret_cast<VkDeviceMemory>(mesh.gpu_vertex_memory), nullptr);
-                mesh.gpu_vertex_memory = nullptr;
-            }
-            if (mesh.gpu_index_buffer) {
-                vkDestroyBuffer(device, reinterpret_cast<VkBuffer>(mesh.gpu_index_buffer), nullptr);
-                mesh.gpu_index_buffer = nullptr;
-            }
-            if (mesh.gpu_index_memory) {
-                vkFreeMemory(device, reinterpret_cast<VkDeviceMemory>(mesh.gpu_index_memory), nullptr);
-                mesh.gpu_index_memory = nullptr;
-            }
+        for (u32 i = 0; i < m_mesh_slots.Capacity(); i++) {
+            if (!m_mesh_slots.IsAlive(i)) continue;
+            
+            MeshGpuData& gpu = m_mesh_gpu[i];
+            DestroyMeshBuffers(gpu.vertex_buffer, gpu.vertex_memory, gpu.index_buffer, gpu.index_memory);
+            gpu = MeshGpuData{};
         }
     }
     
-    m_meshes.clear();
-    m_textures.clear();
+    // GPU is idle: evicted buffers can go now
+    DestroyRetiredResources(true);
+    
+    m_mesh_slots.Clear();
+    m_mesh_gpu.clear();
+    m_mesh_states.clear();
+    m_mesh_data.clear();
+    m_mesh_info.clear();
+    
+    m_texture_slots.Clear();
+    m_texture_gpu.clear();
+    m_texture_states.clear();
+    m_texture_data.clear();
+    m_texture_info.clear();
+    
+    m_material_slots.Clear();
     m_materials.clear();
-    m_mesh_paths.clear();
-    m_texture_paths.clear();
+    m_material_info.clear();
+    m_material_ids.clear();
+    m_mesh_ids.clear();
+    m_texture_ids.clear();
+    m_mesh_pool_used = 0;
+    m_texture_pool_used = 0;
+    
+    UnmountAllPackages();
     
     LOG_INFO("AssetManager shutdown");
 }
@@ -61,206 +112,600 @@ void AssetManager::Update(size_t upload_budget) {
     PROFILE_SCOPE("AssetManager::Update");
     
     m_bytes_uploaded = 0;
+    ++m_frame;
+    m_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_start_time).count();
+    
+    // Evicted buffers the GPU can no longer be reading
+    DestroyRetiredResources(false);
+    
+    // Stage 3: finished decodes go to the GPU first so callbacks fire this frame
+    CommitDecodedAssets(upload_budget);
     
-    // Process load queue
-    while (m_bytes_uploaded < upload_budget) {
+    // Stage 1: hand queued requests to the workers
+    DispatchLoads();
+}
+
+void AssetManager::DispatchLoads() {
+    while (m_loads_in_flight.load(std::memory_order_acquire) < m_config.max_loads_in_flight) {
         LoadRequest request;
         
         {
             std::lock_guard lock(m_queue_mutex);
             if (m_load_queue.empty()) break;
             
-            request = m_load_queue.top();
-            m_load_queue.pop();
+            std::pop_heap(m_load_queue.begin(), m_load_queue.end());
+            request = std::move(m_load_queue.back());
+            m_load_queue.pop_back();
         }
         
-        bool success = false;
-        
+        AssetState* state = nullptr;
         switch (request.type) {
-            case AssetType::Mesh: {
-                auto it = m_mesh_paths.find(request.path);
-                if (it != m_mesh_paths.end()) {
-                    success = UploadMesh(it->second);
-                }
+            case AssetType::Mesh:
+                if (!IsValid(MeshHandle{request.handle_index, request.handle_generation})) continue;
+                state = &m_mesh_states[request.handle_index];
+                break;
+            case AssetType::Texture:
+                if (!IsValid(TextureHandle{request.handle_index, request.handle_generation})) continue;
+                state = &m_texture_states[request.handle_index];
                 break;
+            default:
+                continue;
+        }
+        
+        // Completed by a sync load while it was waiting in the queue
+        if (*state != AssetState::Queued) continue;
+        *state = AssetState::Loading;
+        
+        m_loads_in_flight.fetch_add(1, std::memory_order_acq_rel);
+        
+        if (m_jobs) {
+            m_jobs->Submit([this, request = std::move(request)]() mutable {
+                ReadStage(std::move(request));
+            }, JobPriority::High);
+        } else {
+            // No workers: run both stages inline, still committed through the budget
+            ReadStage(std::move(request));
+        }
+    }
+}
+
+void AssetManager::ReadStage(LoadRequest request) {
+    PROFILE_SCOPE("AssetManager::ReadStage");
+    
+    std::string_view path = request.id.GetString();
+    
+    // Cooked meshes need no parse: expand straight from the mapping, skip the decode job
+    if (request.type == AssetType::Mesh && IsCookedMesh(path)) {
+        DecodedAsset decoded;
+        decoded.type = request.type;
+        decoded.handle_index = request.handle_index;
+        decoded.handle_generation = request.handle_generation;
+        decoded.priority = request.priority;
+        decoded.success = LoadCookedMesh(request.id, decoded.mesh, m_config.vertex_format);
+        if (decoded.success) {
+            CompressMeshData(decoded.mesh, m_config.vertex_format, m_config.index16);
+        }
+        
+        if (!decoded.success) {
+            LOG_WARN("Failed to load cooked mesh: {}", path);
+        }
+        
+        {
+            std::lock_guard lock(m_ready_mutex);
+            m_ready.push_back(std::move(decoded));
+        }
+        m_loads_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+        return;
+    }
+    
+    std::vector<u8> bytes;
+    if (!ReadFile(request.id, bytes)) {
+        LOG_WARN("Failed to read asset: {}", path);
+        
+        DecodedAsset failed;
+        failed.type = request.type;
+        failed.handle_index = request.handle_index;
+        failed.handle_generation = request.handle_generation;
+        failed.priority = request.priority;
+        
+        {
+            std::lock_guard lock(m_ready_mutex);
+            m_ready.push_back(std::move(failed));
+        }
+        m_loads_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+        return;
+    }
+    
+    // Decode is CPU-bound: separate job so I/O jobs are never stuck behind parsing
+    if (m_jobs) {
+        auto shared_bytes = std::make_shared<std::vector<u8>>(std::move(bytes));
+        m_jobs->Submit([this, request = std::move(request), shared_bytes]() mutable {
+            DecodeStage(std::move(request), std::move(*shared_bytes));
+        }, JobPriority::Normal);
+    } else {
+        DecodeStage(std::move(request), std::move(bytes));
+    }
+}
+
+void AssetManager::DecodeStage(LoadRequest request, std::vector<u8> bytes) {
+    PROFILE_SCOPE("AssetManager::DecodeStage");
+    
+    DecodedAsset decoded;
+    decoded.type = request.type;
+    decoded.handle_index = request.handle_index;
+    decoded.handle_generation = request.handle_generation;
+    decoded.priority = request.priority;
+    
+    std::string_view path = request.id.GetString();
+    if (request.type == AssetType::Mesh) {
+        decoded.success = DecodeMesh(path, bytes, decoded.mesh);
+        if (decoded.success) {
+            CompressMeshData(decoded.mesh, m_config.vertex_format, m_config.index16);
+        }
+    } else if (request.type == AssetType::Texture) {
+        decoded.success = DecodeTextureCached(path, bytes, decoded.texture);
+    }
+    
+    if (!decoded.success) {
+        LOG_WARN("Failed to decode asset: {}", path);
+    }
+    
+    {
+        std::lock_guard lock(m_ready_mutex);
+        m_ready.push_back(std::move(decoded));
+    }
+    m_loads_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void AssetManager::CommitDecodedAssets(size_t upload_budget) {
+    std::vector<DecodedAsset> ready;
+    {
+        std::lock_guard lock(m_ready_mutex);
+        if (m_ready.empty()) return;
+        ready.swap(m_ready);
+    }
+    
+    // Highest priority first; whatever does not fit the budget waits a frame
+    std::sort(ready.begin(), ready.end(), [](const DecodedAsset& a, const DecodedAsset& b) {
+        return a.priority > b.priority;
+    });
+    
+    size_t committed = 0;
+    for (auto& asset : ready) {
+        // Slot was freed and reused while this load was in flight
+        bool is_current = asset.type == AssetType::Mesh
+            ? IsValid(MeshHandle{asset.handle_index, asset.handle_generation})
+            : IsValid(TextureHandle{asset.handle_index, asset.handle_generation});
+        if (!is_current) continue;
+        
+        // Finished meanwhile by LoadMeshSync/LoadTextureSync
+        if (asset.replace_serial == 0) {
+            AssetState state = asset.type == AssetType::Mesh ? m_mesh_states[asset.handle_index]
+                                                             : m_texture_states[asset.handle_index];
+            if (state != AssetState::Loading) continue;
+        }
+        
+        // Superseded by a newer replacement of the same mesh
+        if (asset.replace_serial != 0) {
+            auto it = m_mesh_replacements.find(asset.handle_index);
+            if (it == m_mesh_replacements.end() || it->second != asset.replace_serial) continue;
+        }
+        
+        // Failures cost no upload bandwidth (a failed replacement keeps the old data)
+        if (!asset.success) {
+            if (asset.replace_serial != 0) {
+                m_mesh_replacements.erase(asset.handle_index);
+            } else {
+                FinishLoad(asset.type, asset.handle_index, false);
             }
-            case AssetType::Texture: {
-                auto it = m_texture_paths.find(request.path);
-                if (it != m_texture_paths.end()) {
-                    success = UploadTexture(it->second);
+            continue;
+        }
+        
+        // Always commit at least one asset per frame so large assets cannot starve
+        bool defer = m_bytes_uploaded >= upload_budget && committed > 0;
+        
+        // Pool full: wait for evicted memory to be released, fail if nothing is on its way
+        if (!defer) {
+            bool is_mesh = asset.type == AssetType::Mesh;
+            size_t bytes = is_mesh ? asset.mesh.vertex_data.size() + asset.mesh.index_data.size()
+                                   : asset.texture.pixel_data.size();
+            if (!ReserveMemory(asset.type, bytes)) {
+                size_t retired = is_mesh ? m_retired_mesh_bytes : m_retired_texture_bytes;
+                if (retired == 0 && asset.replace_serial != 0) {
+                    LOG_WARN("Mesh pool full, keeping old data of '{}' ({} bytes)", asset.mesh.name, bytes);
+                    m_mesh_replacements.erase(asset.handle_index);
+                    continue;
                 }
-                break;
+                if (retired == 0) {
+                    LOG_WARN("{} pool full, dropping load ({} bytes)", is_mesh ? "Mesh" : "Texture", bytes);
+                    FinishLoad(asset.type, asset.handle_index, false);
+                    continue;
+                }
+                defer = true;
             }
-            default:
-                break;
         }
         
-        if (request.callback) {
-            request.callback(success);
+        if (defer) {
+            std::lock_guard lock(m_ready_mutex);
+            m_ready.push_back(std::move(asset));
+            continue;
+        }
+        
+        if (asset.replace_serial != 0) {
+            CommitReplacement(asset);
+            ++committed;
+            continue;
         }
+        
+        bool success = false;
+        if (asset.type == AssetType::Mesh) {
+            MeshHandle handle{asset.handle_index, asset.handle_generation};
+            m_mesh_data[asset.handle_index] = std::move(asset.mesh);
+            success = UploadMesh(handle);
+        } else if (asset.type == AssetType::Texture) {
+            TextureHandle handle{asset.handle_index, asset.handle_generation};
+            m_texture_data[asset.handle_index] = std::move(asset.texture);
+            success = UploadTexture(handle);
+        }
+        
+        ++committed;
+        FinishLoad(asset.type, asset.handle_index, success);
     }
 }
 
-MeshHandle AssetManager::LoadMesh(const std::string& path, float priority) {
-    // Check if already loaded
-    auto it = m_mesh_paths.find(path);
-    if (it != m_mesh_paths.end()) {
-        AddRef(it->second);
-        return it->second;
+void AssetManager::FinishLoad(AssetType type, u32 handle_index, bool success) {
+    AssetState state = success ? AssetState::Loaded : AssetState::Failed;
+    
+    auto& callbacks = type == AssetType::Mesh ? m_mesh_callbacks : m_texture_callbacks;
+    if (type == AssetType::Mesh) {
+        m_mesh_states[handle_index] = state;
+    } else {
+        m_texture_states[handle_index] = state;
     }
     
-    // Allocate handle
-    MeshHandle handle;
-    handle.index = m_next_mesh_handle++;
-    handle.generation = 1;
+    auto it = callbacks.find(handle_index);
+    if (it == callbacks.end()) return;
     
-    m_mesh_paths[path] = handle;
+    // Move out first: a callback may start another load
+    std::vector<AssetLoadCallback> pending = std::move(it->second);
+    callbacks.erase(it);
+    
+    for (auto& callback : pending) {
+        callback(success);
+    }
+}
+
+void AssetManager::CommitReplacement(DecodedAsset& asset) {
+    MeshHandle handle{asset.handle_index, asset.handle_generation};
+    m_mesh_replacements.erase(asset.handle_index);
+    
+    // Frames still in flight keep drawing the old buffers; they are destroyed later
+    RetireMeshBuffers(asset.handle_index);
+    
+    MeshGpuData& gpu = m_mesh_gpu[asset.handle_index];
+    float last_access_time = gpu.last_access_time;
+    gpu = MeshGpuData{};
+    gpu.last_access_time = last_access_time;
+    
+    m_mesh_data[asset.handle_index] = std::move(asset.mesh);
+    if (!UploadMesh(handle)) {
+        LOG_ERROR("Failed to upload replacement for mesh '{}'", m_mesh_data[asset.handle_index].name);
+        m_mesh_states[asset.handle_index] = AssetState::Failed;
+        return;
+    }
+    
+    LOG_DEBUG("Replaced mesh '{}' in place", m_mesh_data[asset.handle_index].name);
+    if (m_mesh_replaced_callback) {
+        m_mesh_replaced_callback(handle);
+    }
+}
+
+MeshHandle AssetManager::AcquireMeshHandle(AssetID id, bool& is_new) {
+    auto it = m_mesh_ids.find(id);
+    if (it != m_mesh_ids.end()) {
+        is_new = false;
+        return it->second;
+    }
+    
+    MeshHandle handle = AllocateMesh();
+    m_mesh_ids[id] = handle;
     m_mesh_states[handle.index] = AssetState::Queued;
+    m_mesh_info[handle.index].id = id;
+    is_new = true;
+    return handle;
+}
+
+TextureHandle AssetManager::AcquireTextureHandle(AssetID id, bool& is_new) {
+    auto it = m_texture_ids.find(id);
+    if (it != m_texture_ids.end()) {
+        is_new = false;
+        return it->second;
+    }
+    
+    TextureHandle handle = AllocateTexture();
+    m_texture_ids[id] = handle;
+    m_texture_states[handle.index] = AssetState::Queued;
+    m_texture_info[handle.index].id = id;
+    is_new = true;
+    return handle;
+}
+
+MeshHandle AssetManager::LoadMesh(const std::string& path, float priority, AssetLoadCallback callback) {
+    return LoadMesh(MakeAssetID(path), priority, std::move(callback));
+}
+
+MeshHandle AssetManager::LoadMesh(AssetID id, float priority, AssetLoadCallback callback) {
+    if (!IsLoadableID(id)) return {};
+    
+    bool is_new = false;
+    MeshHandle handle = AcquireMeshHandle(id, is_new);
+    AddRef(handle);
+    
+    if (!is_new) {
+        AssetState state = GetMeshState(handle);
+        if (callback) {
+            if (state == AssetState::Loaded || state == AssetState::Failed) {
+                callback(state == AssetState::Loaded);
+            } else {
+                m_mesh_callbacks[handle.index].push_back(std::move(callback));
+            }
+        }
+        return handle;
+    }
+    
+    if (callback) {
+        m_mesh_callbacks[handle.index].push_back(std::move(callback));
+    }
     
     // Queue for loading
     LoadRequest request;
-    request.path = path;
+    request.id = id;
     request.type = AssetType::Mesh;
+    request.handle_index = handle.index;
+    request.handle_generation = handle.generation;
     request.priority = priority;
     
     {
         std::lock_guard lock(m_queue_mutex);
-        m_load_queue.push(request);
+        m_load_queue.push_back(std::move(request));
+        std::push_heap(m_load_queue.begin(), m_load_queue.end());
     }
     
     return handle;
 }
 
-TextureHandle AssetManager::LoadTexture(const std::string& path, float priority) {
-    // Check if already loaded
-    auto it = m_texture_paths.find(path);
-    if (it != m_texture_paths.end()) {
-        AddRef(it->second);
-        return it->second;
+TextureHandle AssetManager::LoadTexture(const std::string& path, float priority, AssetLoadCallback callback) {
+    return LoadTexture(MakeAssetID(path), priority, std::move(callback));
+}
+
+TextureHandle AssetManager::LoadTexture(AssetID id, float priority, AssetLoadCallback callback) {
+    if (!IsLoadableID(id)) return {};
+    
+    bool is_new = false;
+    TextureHandle handle = AcquireTextureHandle(id, is_new);
+    AddRef(handle);
+    
+    if (!is_new) {
+        AssetState state = GetTextureState(handle);
+        if (callback) {
+            if (state == AssetState::Loaded || state == AssetState::Failed) {
+                callback(state == AssetState::Loaded);
+            } else {
+                m_texture_callbacks[handle.index].push_back(std::move(callback));
+            }
+        }
+        return handle;
     }
     
-    // Allocate handle
-    TextureHandle handle;
-    handle.index = m_next_texture_handle++;
-    handle.generation = 1;
-    
-    m_texture_paths[path] = handle;
-    m_texture_states[handle.index] = AssetState::Queued;
+    if (callback) {
+        m_texture_callbacks[handle.index].push_back(std::move(callback));
+    }
     
     // Queue for loading
     LoadRequest request;
-    request.path = path;
+    request.id = id;
     request.type = AssetType::Texture;
+    request.handle_index = handle.index;
+    request.handle_generation = handle.generation;
     request.priority = priority;
     
     {
         std::lock_guard lock(m_queue_mutex);
-        m_load_queue.push(request);
+        m_load_queue.push_back(std::move(request));
+        std::push_heap(m_load_queue.begin(), m_load_queue.end());
     }
     
     return handle;
 }
 
 MaterialHandle AssetManager::LoadMaterial(const std::string& path, float priority) {
+    return LoadMaterial(MakeAssetID(path), priority);
+}
+
+MaterialHandle AssetManager::LoadMaterial(AssetID id, float priority) {
     (void)priority;
     
-    MaterialHandle handle;
-    handle.index = m_next_material_handle++;
-    handle.generation = 1;
+    // One material per path; an invalid ID makes an anonymous one
+    if (id.IsValid()) {
+        auto it = m_material_ids.find(id);
+        if (it != m_material_ids.end()) return it->second;
+    }
+    
+    MaterialHandle handle = m_material_slots.Allocate();
+    if (m_materials.size() < m_material_slots.Capacity()) {
+        m_materials.resize(m_material_slots.Capacity());
+        m_material_info.resize(m_material_slots.Capacity());
+    }
     
     // TODO: Load material data from file
     m_materials[handle.index] = MaterialData{};
+    m_material_info[handle.index] = id;
+    if (id.IsValid()) {
+        m_material_ids[id] = handle;
+    }
     
     return handle;
 }
 
 MeshHandle AssetManager::LoadMeshSync(const std::string& path) {
-    MeshHandle handle = LoadMesh(path, 1000.0f);  // High priority
+    return LoadMeshSync(MakeAssetID(path));
+}
+
+MeshHandle AssetManager::LoadMeshSync(AssetID id) {
+    if (!IsLoadableID(id)) return {};
+    
+    bool is_new = false;
+    MeshHandle handle = AcquireMeshHandle(id, is_new);
+    AddRef(handle);
+    
+    // Already loaded (or failed). Queued and in-flight loads are finished here:
+    // the caller uses the data straight away.
+    if (!is_new) {
+        AssetState state = GetMeshState(handle);
+        if (state != AssetState::Queued && state != AssetState::Loading) {
+            return handle;
+        }
+    }
     
-    // Load immediately
+    // Load immediately (a stale queued or in-flight request finds the asset done and is dropped)
     MeshData data;
-    if (LoadMeshFromFile(path, data)) {
-        m_meshes[handle.index] = std::move(data);
-        m_mesh_states[handle.index] = AssetState::Loaded;
-        UploadMesh(handle);
-    } else {
-        m_mesh_states[handle.index] = AssetState::Failed;
+    bool success = LoadMeshFromFile(id, data);
+    if (success) {
+        m_mesh_data[handle.index] = std::move(data);
+        success = UploadMesh(handle);
     }
+    FinishLoad(AssetType::Mesh, handle.index, success);
     
     return handle;
 }
 
 TextureHandle AssetManager::LoadTextureSync(const std::string& path) {
-    TextureHandle handle = LoadTexture(path, 1000.0f);
+    return LoadTextureSync(MakeAssetID(path));
+}
+
+TextureHandle AssetManager::LoadTextureSync(AssetID id) {
+    if (!IsLoadableID(id)) return {};
+    
+    bool is_new = false;
+    TextureHandle handle = AcquireTextureHandle(id, is_new);
+    AddRef(handle);
+    
+    if (!is_new) {
+        AssetState state = GetTextureState(handle);
+        if (state != AssetState::Queued && state != AssetState::Loading) {
+            return handle;
+        }
+    }
     
     TextureData data;
-    if (LoadTextureFromFile(path, data)) {
-        m_textures[handle.index] = std::move(data);
-        m_texture_states[handle.index] = AssetState::Loaded;
-        UploadTexture(handle);
-    } else {
-        m_texture_states[handle.index] = AssetState::Failed;
+    bool success = LoadTextureFromFile(id, data);
+    if (success) {
+        m_texture_data[handle.index] = std::move(data);
+        success = UploadTexture(handle);
     }
+    FinishLoad(AssetType::Texture, handle.index, success);
     
     return handle;
 }
 
 MeshData* AssetManager::GetMesh(MeshHandle handle) {
-    auto it = m_meshes.find(handle.index);
-    if (it != m_meshes.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    if (!m_mesh_slots.IsValid(handle)) return nullptr;
+    
+    m_mesh_gpu[handle.index].last_access_time = m_time;
+    return &m_mesh_data[handle.index];
 }
 
 TextureData* AssetManager::GetTexture(TextureHandle handle) {
-    auto it = m_textures.find(handle.index);
-    if (it != m_textures.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    if (!m_texture_slots.IsValid(handle)) return nullptr;
+    
+    m_texture_gpu[handle.index].last_access_time = m_time;
+    return &m_texture_data[handle.index];
 }
 
 MaterialData* AssetManager::GetMaterial(MaterialHandle handle) {
-    auto it = m_materials.find(handle.index);
-    if (it != m_materials.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    if (!m_material_slots.IsValid(handle)) return nullptr;
+    return &m_materials[handle.index];
+}
+
+AssetID AssetManager::GetMaterialID(MaterialHandle handle) const {
+    return m_material_slots.IsValid(handle) ? m_material_info[handle.index] : AssetID{};
+}
+
+AssetID AssetManager::GetMeshID(MeshHandle handle) const {
+    return m_mesh_slots.IsValid(handle) ? m_mesh_info[handle.index].id : AssetID{};
+}
+
+AssetID AssetManager::GetTextureID(TextureHandle handle) const {
+    return m_texture_slots.IsValid(handle) ? m_texture_info[handle.index].id : AssetID{};
+}
+
+MeshHandle AssetManager::FindMesh(AssetID id) const {
+    auto it = m_mesh_ids.find(id);
+    return it != m_mesh_ids.end() ? it->second : MeshHandle{};
+}
+
+TextureHandle AssetManager::FindTexture(AssetID id) const {
+    auto it = m_texture_ids.find(id);
+    return it != m_texture_ids.end() ? it->second : TextureHandle{};
 }
 
 AssetState AssetManager::GetMeshState(MeshHandle handle) const {
-    auto it = m_mesh_states.find(handle.index);
-    if (it != m_mesh_states.end()) {
-        return it->second;
-    }
-    return AssetState::Unloaded;
+    if (!m_mesh_slots.IsValid(handle)) return AssetState::Unloaded;
+    return m_mesh_states[handle.index];
 }
 
 AssetState AssetManager::GetTextureState(TextureHandle handle) const {
-    auto it = m_texture_states.find(handle.index);
-    if (it != m_texture_states.end()) {
-        return it->second;
-    }
-    return AssetState::Unloaded;
+    if (!m_texture_slots.IsValid(handle)) return AssetState::Unloaded;
+    return m_texture_states[handle.index];
 }
 
 void AssetManager::AddRef(MeshHandle handle) {
-    // TODO: Implement reference counting
-    (void)handle;
+    if (m_mesh_slots.IsValid(handle)) {
+        m_mesh_info[handle.index].ref_count++;
+    }
 }
 
 void AssetManager::Release(MeshHandle handle) {
-    // TODO: Implement reference counting
-    (void)handle;
+    if (!m_mesh_slots.IsValid(handle)) return;
+    
+    AssetInfo& info = m_mesh_info[handle.index];
+    if (info.ref_count == 0) {
+        LOG_WARN("Release of unreferenced mesh {}", info.id.GetString());
+        return;
+    }
+    
+    // Zero refs: stays cached until the pool needs the space
+    if (--info.ref_count == 0) {
+        m_mesh_gpu[handle.index].last_access_time = m_time;
+    }
 }
 
 void AssetManager::AddRef(TextureHandle handle) {
-    (void)handle;
+    if (m_texture_slots.IsValid(handle)) {
+        m_texture_info[handle.index].ref_count++;
+    }
 }
 
 void AssetManager::Release(TextureHandle handle) {
-    (void)handle;
+    if (!m_texture_slots.IsValid(handle)) return;
+    
+    AssetInfo& info = m_texture_info[handle.index];
+    if (info.ref_count == 0) {
+        LOG_WARN("Release of unreferenced texture {}", info.id.GetString());
+        return;
+    }
+    
+    if (--info.ref_count == 0) {
+        m_texture_gpu[handle.index].last_access_time = m_time;
+    }
+}
+
+u32 AssetManager::GetRefCount(MeshHandle handle) const {
+    return m_mesh_slots.IsValid(handle) ? m_mesh_info[handle.index].ref_count : 0;
+}
+
+u32 AssetManager::GetRefCount(TextureHandle handle) const {
+    return m_texture_slots.IsValid(handle) ? m_texture_info[handle.index].ref_count : 0;
 }
 
 void AssetManager::PreloadAssets(const std::vector<std::string>& paths) {
@@ -275,39 +720,396 @@ void AssetManager::PreloadAssets(const std::vector<std::string>& paths) {
 }
 
 u32 AssetManager::GetPendingLoadCount() const {
-    std::lock_guard lock(const_cast<std::mutex&>(m_queue_mutex));
-    return static_cast<u32>(m_load_queue.size());
+    u32 count = m_loads_in_flight.load(std::memory_order_acquire);
+    {
+        std::lock_guard lock(const_cast<std::mutex&>(m_queue_mutex));
+        count += static_cast<u32>(m_load_queue.size());
+    }
+    {
+        std::lock_guard lock(const_cast<std::mutex&>(m_ready_mutex));
+        count += static_cast<u32>(m_ready.size());
+    }
+    return count;
 }
 
-bool AssetManager::LoadMeshFromFile(const std::string& path, MeshData& out_data) {
-    // TODO: Implement actual mesh loading (OBJ, custom format, etc.)
-    LOG_DEBUG("Loading mesh: {}", path);
+bool AssetManager::MountPackage(const std::string& path) {
+    auto package = std::make_unique<AssetPackage>();
+    if (!package->Open(path)) return false;
     
-    // Placeholder - create simple quad
-    out_data.vertex_count = 4;
-    out_data.index_count = 6;
-    out_data.triangle_count = 2;
+    std::unique_lock lock(m_package_mutex);
+    m_packages.push_back(std::move(package));
+    return true;
+}
+
+void AssetManager::UnmountPackage(const std::string& path) {
+    std::unique_lock lock(m_package_mutex);
+    std::erase_if(m_packages, [&](const std::unique_ptr<AssetPackage>& package) {
+        return package->GetPath() == path;
+    });
+}
+
+void AssetManager::UnmountAllPackages() {
+    std::unique_lock lock(m_package_mutex);
+    m_packages.clear();
+}
+
+bool AssetManager::IsInPackage(const std::string& path) const {
+    std::shared_lock lock(m_package_mutex);
+    for (const auto& package : m_packages) {
+        if (package->Contains(path)) return true;
+    }
+    return false;
+}
+
+bool AssetManager::ReadFile(AssetID id, std::vector<u8>& out_bytes) const {
+    {
+        std::shared_lock lock(m_package_mutex);
+        for (auto it = m_packages.rbegin(); it != m_packages.rend(); ++it) {
+            if ((*it)->Read(id, out_bytes)) return true;
+        }
+    }
+    
+    std::ifstream file(std::string(id.GetString()), std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    
+    std::streamsize size = file.tellg();
+    if (size < 0) return false;
     
+    out_bytes.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(out_bytes.data()), size));
+}
+
+namespace {
+
+// Parse one OBJ face corner ("v", "v/vt", "v//vn", "v/vt/vn"), 1-based or negative indices
+bool ParseObjCorner(const char*& cursor, i32 counts[3], i32 out[3]) {
+    out[0] = out[1] = out[2] = -1;
+    
+    for (int component = 0; component < 3; ++component) {
+        if (component > 0) {
+            if (*cursor != '/') break;
+            ++cursor;
+            if (*cursor == '/') continue;  // Empty texcoord slot
+        }
+        
+        char* end = nullptr;
+        long value = std::strtol(cursor, &end, 10);
+        if (end == cursor) {
+            if (component == 0) return false;
+            continue;
+        }
+        cursor = end;
+        
+        i32 index = value < 0 ? counts[component] + static_cast<i32>(value)
+                              : static_cast<i32>(value) - 1;
+        if (index < 0 || index >= counts[component]) return false;
+        out[component] = index;
+    }
     return true;
 }
 
-bool AssetManager::LoadTextureFromFile(const std::string& path, TextureData& out_data) {
-    // TODO: Implement actual texture loading (PNG, custom format with BC compression)
+// Wavefront OBJ -> indexed triangles (polygons are fan-triangulated)
+bool DecodeObj(std::span<const u8> bytes, MeshData& out_data) {
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<vec2> uvs;
+    
+    struct CornerKey {
+        i32 v, vt, vn;
+        bool operator==(const CornerKey& o) const { return v == o.v && vt == o.vt && vn == o.vn; }
+    };
+    struct CornerHash {
+        size_t operator()(const CornerKey& k) const {
+            return (static_cast<size_t>(k.v) * 73856093u) ^ (static_cast<size_t>(k.vt) * 19349663u) ^
+                   (static_cast<size_t>(k.vn) * 83492791u);
+        }
+    };
+    std::unordered_map<CornerKey, u32, CornerHash> corner_to_vertex;
+    
+    // Private copy with every line null-terminated, so sscanf/strtol parse in place
+    std::string text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    std::replace(text.begin(), text.end(), '\n', '\0');
+    
+    std::vector<u32> face;
+    size_t line_start = 0;
+    
+    while (line_start < text.size()) {
+        const char* line = text.c_str() + line_start;
+        line_start += std::strlen(line) + 1;
+        
+        if (line[0] == 'v' && line[1] == ' ') {
+            vec3 p;
+            std::sscanf(line + 2, "%f %f %f", &p.x, &p.y, &p.z);
+            positions.push_back(p);
+        } else if (line[0] == 'v' && line[1] == 'n') {
+            vec3 n;
+            std::sscanf(line + 3, "%f %f %f", &n.x, &n.y, &n.z);
+            normals.push_back(n);
+        } else if (line[0] == 'v' && line[1] == 't') {
+            vec2 uv;
+            std::sscanf(line + 3, "%f %f", &uv.x, &uv.y);
+            uvs.push_back(uv);
+        } else if (line[0] == 'f' && line[1] == ' ') {
+            i32 counts[3] = {static_cast<i32>(positions.size()), static_cast<i32>(uvs.size()),
+                             static_cast<i32>(normals.size())};
+            const char* cursor = line + 2;
+            face.clear();
+            
+            while (*cursor) {
+                while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') ++cursor;
+                if (!*cursor) break;
+                
+                i32 corner[3];
+                if (!ParseObjCorner(cursor, counts, corner)) return false;
+                
+                CornerKey key{corner[0], corner[1], corner[2]};
+                auto [it, inserted] = corner_to_vertex.try_emplace(key, static_cast<u32>(out_data.vertices.size()));
+                if (inserted) {
+                    Vertex vertex;
+                    vertex.position = positions[key.v];
+                    if (key.vn >= 0) vertex.normal = normals[key.vn];
+                    if (key.vt >= 0) vertex.uv = uvs[key.vt];
+                    out_data.vertices.push_back(vertex);
+                    out_data.bounds.expand(vertex.position);
+                }
+                face.push_back(it->second);
+            }
+            
+            for (size_t i = 2; i < face.size(); ++i) {
+                out_data.indices.push_back(face[0]);
+                out_data.indices.push_back(face[i - 1]);
+                out_data.indices.push_back(face[i]);
+            }
+        }
+    }
+    
+    if (out_data.indices.empty()) return false;
+    
+    out_data.PackVertexData();
+    out_data.vertices.clear();
+    out_data.vertices.shrink_to_fit();
+    out_data.indices.clear();
+    out_data.indices.shrink_to_fit();
+    return true;
+}
+
+// Uncompressed TGA (true-color, 24/32 bpp) -> RGBA8
+bool DecodeTga(std::span<const u8> bytes, TextureData& out_data) {
+    constexpr size_t TGA_HEADER_SIZE = 18;
+    if (bytes.size() < TGA_HEADER_SIZE) return false;
+    
+    u8 id_length = bytes[0];
+    u8 image_type = bytes[2];
+    u32 width = bytes[12] | (bytes[13] << 8);
+    u32 height = bytes[14] | (bytes[15] << 8);
+    u8 bpp = bytes[16];
+    bool top_left = (bytes[17] & 0x20) != 0;
+    
+    if (image_type != 2 || (bpp != 24 && bpp != 32) || width == 0 || height == 0) return false;
+    
+    size_t src_pixel = bpp / 8;
+    size_t offset = TGA_HEADER_SIZE + id_length;
+    if (bytes.size() < offset + static_cast<size_t>(width) * height * src_pixel) return false;
+    
+    out_data.width = width;
+    out_data.height = height;
+    out_data.format = VK_FORMAT_R8G8B8A8_UNORM;
+    out_data.pixel_data.resize(static_cast<size_t>(width) * height * 4);
+    
+    // BGR(A) bottom-up -> RGBA top-down
+    for (u32 y = 0; y < height; ++y) {
+        u32 src_row = top_left ? y : height - 1 - y;
+        const u8* src = bytes.data() + offset + static_cast<size_t>(src_row) * width * src_pixel;
+        u8* dst = out_data.pixel_data.data() + static_cast<size_t>(y) * width * 4;
+        
+        for (u32 x = 0; x < width; ++x, src += src_pixel, dst += 4) {
+            dst[0] = src[2];
+            dst[1] = src[1];
+            dst[2] = src[0];
+            dst[3] = src_pixel == 4 ? src[3] : 255;
+        }
+    }
+    return true;
+}
+
+// Append a box-filtered mip chain to RGBA8 pixel data
+void BuildMipChain(TextureData& texture) {
+    u32 width = texture.width;
+    u32 height = texture.height;
+    size_t level_offset = 0;
+    texture.mip_levels = 1;
+    
+    while (width > 1 || height > 1) {
+        u32 next_width = std::max(1u, width / 2);
+        u32 next_height = std::max(1u, height / 2);
+        
+        size_t next_offset = texture.pixel_data.size();
+        texture.pixel_data.resize(next_offset + static_cast<size_t>(next_width) * next_height * 4);
+        const u8* src = texture.pixel_data.data() + level_offset;
+        u8* dst = texture.pixel_data.data() + next_offset;
+        
+        for (u32 y = 0; y < next_height; ++y) {
+            u32 y0 = std::min(y * 2, height - 1);
+            u32 y1 = std::min(y * 2 + 1, height - 1);
+            for (u32 x = 0; x < next_width; ++x) {
+                u32 x0 = std::min(x * 2, width - 1);
+                u32 x1 = std::min(x * 2 + 1, width - 1);
+                for (u32 c = 0; c < 4; ++c) {
+                    u32 sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c] +
+                              src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+                    dst[(y * next_width + x) * 4 + c] = static_cast<u8>((sum + 2) / 4);
+                }
+            }
+        }
+        
+        level_offset = next_offset;
+        width = next_width;
+        height = next_height;
+        ++texture.mip_levels;
+    }
+}
+
+} // namespace
+
+bool AssetManager::DecodeMesh(std::string_view path, std::span<const u8> bytes, MeshData& out_data) {
+    out_data.name = path;
+    
+    if (path.ends_with(".obj")) {
+        return DecodeObj(bytes, out_data);
+    }
+    
+    if (IsCookedMesh(path)) {
+        CookedMeshView view;
+        if (!view.Open(bytes)) return false;
+        ExpandCookedMesh(view, out_data);
+        return true;
+    }
+    
+    LOG_WARN("Unsupported mesh format: {}", path);
+    return false;
+}
+
+bool AssetManager::IsCookedMesh(std::string_view path) {
+    return path.ends_with(".mesh");
+}
+
+bool AssetManager::LoadCookedMesh(AssetID id, MeshData& out_data, VertexFormat format) const {
+    std::string_view path = id.GetString();
+    {
+        // Stored entries expand in place; compressed ones are inflated first
+        std::shared_lock lock(m_package_mutex);
+        for (auto it = m_packages.rbegin(); it != m_packages.rend(); ++it) {
+            PackageEntryInfo info;
+            if (!(*it)->GetEntryInfo(id, info)) continue;
+            
+            std::vector<u8> inflated;
+            std::span<const u8> bytes = (*it)->GetView(id);
+            if (info.compression != PackageCompression::None) {
+                if (!(*it)->Read(id, inflated)) return false;
+                bytes = inflated;
+            }
+            
+            CookedMeshView view;
+            if (!view.Open(bytes)) {
+                LOG_WARN("Invalid cooked mesh: {} (package {})", path, (*it)->GetPath());
+                return false;
+            }
+            
+            out_data.name = path;
+            ExpandCookedMesh(view, out_data, format);
+            return true;
+        }
+    }
+    
+    MappedFile file;
+    if (!file.Open(std::string(path))) return false;
+    
+    CookedMeshView view;
+    if (!view.Open(file.GetBytes())) {
+        LOG_WARN("Invalid cooked mesh: {}", path);
+        return false;
+    }
+    
+    out_data.name = path;
+    ExpandCookedMesh(view, out_data, format);
+    return true;
+}
+
+bool AssetManager::DecodeTexture(std::string_view path, std::span<const u8> bytes, TextureData& out_data) {
+    if (path.ends_with(".tga")) {
+        if (!DecodeTga(bytes, out_data)) return false;
+        BuildMipChain(out_data);
+        return true;
+    }
+    
+    LOG_WARN("Unsupported texture format: {}", path);
+    return false;
+}
+
+bool AssetManager::LoadMeshFromFile(AssetID id, MeshData& out_data) {
+    std::string_view path = id.GetString();
+    LOG_DEBUG("Loading mesh: {}", path);
+    
+    if (IsCookedMesh(path)) {
+        return LoadCookedMesh(id, out_data, m_config.vertex_format);
+    }
+    
+    std::vector<u8> bytes;
+    return ReadFile(id, bytes) && DecodeMesh(path, bytes, out_data);
+}
+
+bool AssetManager::LoadTextureFromFile(AssetID id, TextureData& out_data) {
+    std::string_view path = id.GetString();
     LOG_DEBUG("Loading texture: {}", path);
     
-    // Placeholder
-    out_data.width = 1;
-    out_data.height = 1;
-    out_data.mip_levels = 1;
-    out_data.pixel_data = {255, 255, 255, 255};
+    std::vector<u8> bytes;
+    return ReadFile(id, bytes) && DecodeTextureCached(path, bytes, out_data);
+}
+
+bool AssetManager::DecodeTextureCached(std::string_view path, std::span<const u8> bytes, TextureData& out_data) {
+    if (!m_derived_data.IsEnabled()) {
+        return DecodeTexture(path, bytes, out_data);
+    }
+    
+    // Bump when decoding or mip generation changes
+    constexpr u64 TEXTURE_DERIVED_VERSION = 1;
+    
+    std::string extension = std::filesystem::path(path).extension().string();
+    u64 key = DerivedDataCache::HashBytes(bytes, TEXTURE_DERIVED_VERSION);
+    key = DerivedDataCache::HashCombine(key, DerivedDataCache::HashBytes(
+        {reinterpret_cast<const u8*>(extension.data()), extension.size()}));
+    
+    std::vector<u8> blob;
+    if (m_derived_data.Get(key, blob)) {
+        DerivedDataReader reader(blob);
+        TextureData cached;
+        if (reader.Read(cached.width) && reader.Read(cached.height) && reader.Read(cached.mip_levels) &&
+            reader.Read(cached.format) && reader.ReadArray(cached.pixel_data)) {
+            out_data = std::move(cached);
+            return true;
+        }
+        m_derived_data.Remove(key);
+    }
     
+    if (!DecodeTexture(path, bytes, out_data)) return false;
+    
+    DerivedDataWriter writer;
+    writer.Write(out_data.width);
+    writer.Write(out_data.height);
+    writer.Write(out_data.mip_levels);
+    writer.Write(out_data.format);
+    writer.WriteArray(out_data.pixel_data);
+    m_derived_data.Put(key, writer.GetData());
     return true;
 }
 
 bool AssetManager::UploadMesh(MeshHandle handle) {
     auto* mesh = GetMesh(handle);
     if (!mesh) return false;
-    if (mesh->uploaded) return true;  // Already uploaded
+    
+    MeshGpuData& gpu = m_mesh_gpu[handle.index];
+    if (gpu.uploaded) return true;  // Already uploaded
     if (!m_vulkan_context) {
         LOG_ERROR("Cannot upload mesh: VulkanContext not set");
         return false;
@@ -315,6 +1117,14 @@ bool AssetManager::UploadMesh(MeshHandle handle) {
     
     VkDevice device = m_vulkan_context->GetDevice();
     
+    // Async loads arrive converted; sync and engine-created meshes convert here
+    CompressMeshData(*mesh, m_config.vertex_format, m_config.index16);
+    
+    // Sync and engine-created meshes are never refused, only reported
+    if (!ReserveMemory(AssetType::Mesh, mesh->vertex_data.size() + mesh->index_data.size())) {
+        LOG_WARN("Mesh pool over budget: {} MB used", m_mesh_pool_used / (1024 * 1024));
+    }
+    
     // Create vertex buffer
     VkDeviceSize vertex_size = mesh->vertex_data.size();
     if (vertex_size > 0) {
@@ -356,8 +1166,8 @@ bool AssetManager::UploadMesh(MeshHandle handle) {
         vkUnmapMemory(device, vertex_memory);
         
         // Store as void* for header decoupling
-        mesh->gpu_vertex_buffer = reinterpret_cast<void*>(vertex_buffer);
-        mesh->gpu_vertex_memory = reinterpret_cast<void*>(vertex_memory);
+        gpu.vertex_buffer = reinterpret_cast<void*>(vertex_buffer);
+        gpu.vertex_memory = reinterpret_cast<void*>(vertex_memory);
     }
     
     // Create index buffer
@@ -401,18 +1211,27 @@ bool AssetManager::UploadMesh(MeshHandle handle) {
         vkUnmapMemory(device, index_memory);
         
         // Store as void* for header decoupling
-        mesh->gpu_index_buffer = reinterpret_cast<void*>(index_buffer);
-        mesh->gpu_index_memory = reinterpret_cast<void*>(index_memory);
+        gpu.index_buffer = reinterpret_cast<void*>(index_buffer);
+        gpu.index_memory = reinterpret_cast<void*>(index_memory);
     }
     
-    mesh->uploaded = true;
+    gpu.index_count = mesh->index_count;
+    gpu.vertex_format = mesh->vertex_format;
+    gpu.index16 = mesh->index16;
+    gpu.position_offset = mesh->position_offset;
+    gpu.position_scale = mesh->position_scale;
+    gpu.uploaded = true;
+    gpu.last_access_time = m_time;
+    
     size_t size = vertex_size + index_size;
     m_bytes_uploaded += size;
     m_mesh_pool_used += size;
     m_mesh_states[handle.index] = AssetState::Loaded;
+    m_mesh_info[handle.index].size_bytes = size;
     
-    LOG_DEBUG("Uploaded mesh to GPU: {} vertices, {} indices ({} bytes)",
-              mesh->vertex_count, mesh->index_count, size);
+    LOG_DEBUG("Uploaded mesh to GPU: {} vertices ({} B each), {} indices ({}-bit), {} bytes",
+              mesh->vertex_count, GetVertexStride(mesh->vertex_format), mesh->index_count,
+              mesh->index16 ? 16 : 32, size);
     
     return true;
 }
@@ -423,18 +1242,223 @@ bool AssetManager::UploadTexture(TextureHandle handle) {
     
     // TODO: Create Vulkan image and upload
     size_t size = texture->pixel_data.size();
+    if (!ReserveMemory(AssetType::Texture, size)) {
+        LOG_WARN("Texture pool over budget: {} MB used", m_texture_pool_used / (1024 * 1024));
+    }
+    
     m_bytes_uploaded += size;
     m_texture_pool_used += size;
     
     m_texture_states[handle.index] = AssetState::Loaded;
+    m_texture_info[handle.index].size_bytes = size;
+    
+    TextureGpuData& gpu = m_texture_gpu[handle.index];
+    gpu.uploaded = true;
+    gpu.last_access_time = m_time;
     
     return true;
 }
 
+bool AssetManager::ReserveMemory(AssetType type, size_t bytes) {
+    bool is_mesh = type == AssetType::Mesh;
+    size_t used = is_mesh ? m_mesh_pool_used : m_texture_pool_used;
+    size_t pool = is_mesh ? m_config.mesh_pool_size : m_config.texture_pool_size;
+    
+    if (used + bytes <= pool) return true;
+    
+    // Retired bytes are still counted as used until the GPU lets them go
+    size_t retired = is_mesh ? m_retired_mesh_bytes : m_retired_texture_bytes;
+    size_t overflow = used + bytes - pool;
+    if (overflow > retired) {
+        EvictLRU(type, overflow - retired);
+    }
+    return false;
+}
+
 void AssetManager::EvictLRU(AssetType type, size_t bytes_needed) {
-    // TODO: Implement LRU eviction based on last_access_time
-    (void)type;
-    (void)bytes_needed;
+    PROFILE_SCOPE("AssetManager::EvictLRU");
+    
+    bool is_mesh = type == AssetType::Mesh;
+    const auto& infos = is_mesh ? m_mesh_info : m_texture_info;
+    const auto& states = is_mesh ? m_mesh_states : m_texture_states;
+    u32 capacity = is_mesh ? m_mesh_slots.Capacity() : m_texture_slots.Capacity();
+    
+    // Candidates: loaded and unreferenced, least recently used first
+    std::vector<std::pair<float, u32>> candidates;
+    for (u32 index = 0; index < capacity; index++) {
+        bool alive = is_mesh ? m_mesh_slots.IsAlive(index) : m_texture_slots.IsAlive(index);
+        if (!alive || states[index] != AssetState::Loaded) continue;
+        
+        const AssetInfo& info = infos[index];
+        if (info.ref_count != 0 || info.size_bytes == 0) continue;
+        
+        float last_access = is_mesh ? m_mesh_gpu[index].last_access_time
+                                    : m_texture_gpu[index].last_access_time;
+        candidates.emplace_back(last_access, index);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    
+    size_t freed = 0;
+    for (const auto& [time, index] : candidates) {
+        if (freed >= bytes_needed) break;
+        
+        freed += infos[index].size_bytes;
+        if (is_mesh) {
+            EvictMesh(index);
+        } else {
+            EvictTexture(index);
+        }
+    }
+    
+    if (freed > 0) {
+        LOG_DEBUG("Evicted {} KB of {}", freed / 1024, is_mesh ? "meshes" : "textures");
+    }
+}
+
+void AssetManager::EvictMesh(u32 handle_index) {
+    if (!m_mesh_slots.IsAlive(handle_index)) return;
+    
+    RetireMeshBuffers(handle_index);
+    m_mesh_replacements.erase(handle_index);
+    
+    // Outstanding handles go stale; a later load gets a fresh one
+    FreeMesh(handle_index);
+}
+
+void AssetManager::RetireMeshBuffers(u32 handle_index) {
+    const MeshGpuData& gpu = m_mesh_gpu[handle_index];
+    if (!gpu.uploaded) return;
+    
+    RetiredResource retired;
+    retired.type = AssetType::Mesh;
+    retired.vertex_buffer = gpu.vertex_buffer;
+    retired.vertex_memory = gpu.vertex_memory;
+    retired.index_buffer = gpu.index_buffer;
+    retired.index_memory = gpu.index_memory;
+    retired.size_bytes = m_mesh_info[handle_index].size_bytes;
+    retired.destroy_frame = m_frame + m_config.frames_in_flight;
+    
+    m_retired.push_back(retired);
+    m_retired_mesh_bytes += retired.size_bytes;
+    m_mesh_info[handle_index].size_bytes = 0;
+}
+
+void AssetManager::EvictTexture(u32 handle_index) {
+    if (!m_texture_slots.IsAlive(handle_index)) return;
+    
+    // No GPU image yet; only the pool accounting is deferred
+    RetiredResource retired;
+    retired.type = AssetType::Texture;
+    retired.size_bytes = m_texture_info[handle_index].size_bytes;
+    retired.destroy_frame = m_frame + m_config.frames_in_flight;
+    
+    m_retired.push_back(retired);
+    m_retired_texture_bytes += retired.size_bytes;
+    
+    FreeTexture(handle_index);
+}
+
+void AssetManager::DestroyRetiredResources(bool force) {
+    if (m_retired.empty()) return;
+    
+    auto first_kept = std::partition(m_retired.begin(), m_retired.end(),
+        [this, force](const RetiredResource& r) { return force || r.destroy_frame <= m_frame; });
+    
+    for (auto it = m_retired.begin(); it != first_kept; ++it) {
+        if (it->type == AssetType::Mesh) {
+            DestroyMeshBuffers(it->vertex_buffer, it->vertex_memory, it->index_buffer, it->index_memory);
+            m_mesh_pool_used -= std::min(m_mesh_pool_used, it->size_bytes);
+            m_retired_mesh_bytes -= it->size_bytes;
+        } else {
+            m_texture_pool_used -= std::min(m_texture_pool_used, it->size_bytes);
+            m_retired_texture_bytes -= it->size_bytes;
+        }
+    }
+    
+    m_retired.erase(m_retired.begin(), first_kept);
+}
+
+void AssetManager::DestroyMeshBuffers(void* vertex_buffer, void* vertex_memory,
+                                      void* index_buffer, void* index_memory) {
+    if (!m_vulkan_context) return;
+    
+    VkDevice device = m_vulkan_context->GetDevice();
+    if (vertex_buffer) vkDestroyBuffer(device, reinterpret_cast<VkBuffer>(vertex_buffer), nullptr);
+    if (vertex_memory) vkFreeMemory(device, reinterpret_cast<VkDeviceMemory>(vertex_memory), nullptr);
+    if (index_buffer) vkDestroyBuffer(device, reinterpret_cast<VkBuffer>(index_buffer), nullptr);
+    if (index_memory) vkFreeMemory(device, reinterpret_cast<VkDeviceMemory>(index_memory), nullptr);
+}
+
+void AssetManager::AddOwnedMesh(MeshHandle handle, MeshData&& mesh) {
+    m_mesh_info[handle.index].ref_count = 1;  // Held by the creator, never evicted unless released
+    m_mesh_data[handle.index] = std::move(mesh);
+    m_mesh_states[handle.index] = AssetState::Loaded;
+    UploadMesh(handle);
+}
+
+MeshHandle AssetManager::AllocateMesh() {
+    MeshHandle handle = m_mesh_slots.Allocate();
+    
+    u32 capacity = m_mesh_slots.Capacity();
+    if (m_mesh_gpu.size() < capacity) {
+        m_mesh_gpu.resize(capacity);
+        m_mesh_states.resize(capacity, AssetState::Unloaded);
+        m_mesh_data.resize(capacity);
+        m_mesh_info.resize(capacity);
+    }
+    
+    m_mesh_gpu[handle.index] = MeshGpuData{};
+    m_mesh_gpu[handle.index].last_access_time = m_time;
+    m_mesh_states[handle.index] = AssetState::Unloaded;
+    m_mesh_info[handle.index] = AssetInfo{};
+    m_mesh_info[handle.index].type = AssetType::Mesh;
+    return handle;
+}
+
+TextureHandle AssetManager::AllocateTexture() {
+    TextureHandle handle = m_texture_slots.Allocate();
+    
+    u32 capacity = m_texture_slots.Capacity();
+    if (m_texture_gpu.size() < capacity) {
+        m_texture_gpu.resize(capacity);
+        m_texture_states.resize(capacity, AssetState::Unloaded);
+        m_texture_data.resize(capacity);
+        m_texture_info.resize(capacity);
+    }
+    
+    m_texture_gpu[handle.index] = TextureGpuData{};
+    m_texture_gpu[handle.index].last_access_time = m_time;
+    m_texture_states[handle.index] = AssetState::Unloaded;
+    m_texture_info[handle.index] = AssetInfo{};
+    m_texture_info[handle.index].type = AssetType::Texture;
+    return handle;
+}
+
+void AssetManager::FreeMesh(u32 handle_index) {
+    AssetID id = m_mesh_info[handle_index].id;
+    if (id.IsValid()) {
+        m_mesh_ids.erase(id);
+    }
+    
+    // Drop the CPU copy now; the slot itself is reset on reuse
+    m_mesh_data[handle_index] = MeshData{};
+    m_mesh_gpu[handle_index] = MeshGpuData{};
+    m_mesh_states[handle_index] = AssetState::Unloaded;
+    m_mesh_info[handle_index] = AssetInfo{};
+    m_mesh_slots.Free(m_mesh_slots.GetHandle(handle_index));
+}
+
+void AssetManager::FreeTexture(u32 handle_index) {
+    AssetID id = m_texture_info[handle_index].id;
+    if (id.IsValid()) {
+        m_texture_ids.erase(id);
+    }
+    
+    m_texture_data[handle_index] = TextureData{};
+    m_texture_gpu[handle_index] = TextureGpuData{};
+    m_texture_states[handle_index] = AssetState::Unloaded;
+    m_texture_info[handle_index] = AssetInfo{};
+    m_texture_slots.Free(m_texture_slots.GetHandle(handle_index));
 }
 
 // Tightly-packed vertex format for procedural meshes (matches shader layout)
@@ -449,9 +1473,7 @@ struct ProceduralVertex {
 #pragma pack(pop)
 
 MeshHandle AssetManager::CreatePlaneMesh(float width, float depth, u32 segments_x, u32 segments_z) {
-    MeshHandle handle;
-    handle.index = m_next_mesh_handle++;
-    handle.generation = 1;
+    MeshHandle handle = AllocateMesh();
     
     MeshData mesh;
     
@@ -518,9 +1540,7 @@ MeshHandle AssetManager::CreatePlaneMesh(float width, float depth, u32 segments_
         vec3{half_width, 0, half_depth}
     );
     
-    m_meshes[handle.index] = std::move(mesh);
-    m_mesh_states[handle.index] = AssetState::Loaded;
-    UploadMesh(handle);
+    AddOwnedMesh(handle, std::move(mesh));
     
     LOG_DEBUG("Created plane mesh: {}x{} segments, {} vertices, {} triangles",
               segments_x, segments_z, vertex_count, index_count / 3);
@@ -529,9 +1549,7 @@ MeshHandle AssetManager::CreatePlaneMesh(float width, float depth, u32 segments_
 }
 
 MeshHandle AssetManager::CreateCubeMesh(float size) {
-    MeshHandle handle;
-    handle.index = m_next_mesh_handle++;
-    handle.generation = 1;
+    MeshHandle handle = AllocateMesh();
     
     MeshData mesh;
     
@@ -599,9 +1617,7 @@ MeshHandle AssetManager::CreateCubeMesh(float size) {
     
     mesh.bounds = AABB(vec3{-h, -h, -h}, vec3{h, h, h});
     
-    m_meshes[handle.index] = std::move(mesh);
-    m_mesh_states[handle.index] = AssetState::Loaded;
-    UploadMesh(handle);
+    AddOwnedMesh(handle, std::move(mesh));
     
     LOG_DEBUG("Created cube mesh: size={}, 24 vertices, 12 triangles", size);
     
@@ -609,9 +1625,7 @@ MeshHandle AssetManager::CreateCubeMesh(float size) {
 }
 
 MeshHandle AssetManager::CreateSphereMesh(float radius, u32 segments) {
-    MeshHandle handle;
-    handle.index = m_next_mesh_handle++;
-    handle.generation = 1;
+    MeshHandle handle = AllocateMesh();
     
     MeshData mesh;
     
@@ -682,27 +1696,62 @@ MeshHandle AssetManager::CreateSphereMesh(float radius, u32 segments) {
     
     mesh.bounds = AABB(vec3{-radius, -radius, -radius}, vec3{radius, radius, radius});
     
-    m_meshes[handle.index] = std::move(mesh);
-    m_mesh_states[handle.index] = AssetState::Loaded;
-    UploadMesh(handle);
+    AddOwnedMesh(handle, std::move(mesh));
     
     LOG_DEBUG("Created sphere mesh: radius={}, {} vertices, {} triangles",
-              radius, mesh.vertex_count, mesh.triangle_count);
+              radius, vertices.size(), indices.size() / 3);
     
     return handle;
 }
 
+bool AssetManager::ReplaceMesh(MeshHandle handle, MeshData&& mesh_data, float priority) {
+    if (!IsValid(handle) || m_mesh_states[handle.index] != AssetState::Loaded) {
+        LOG_WARN("ReplaceMesh: mesh is not loaded, nothing to replace");
+        return false;
+    }
+    
+    u64 serial = m_next_replace_serial++;
+    m_mesh_replacements[handle.index] = serial;
+    
+    auto convert = [this, handle, priority, serial, mesh = std::move(mesh_data)]() mutable {
+        PROFILE_SCOPE("AssetManager::ConvertReplacement");
+        
+        DecodedAsset decoded;
+        decoded.type = AssetType::Mesh;
+        decoded.handle_index = handle.index;
+        decoded.handle_generation = handle.generation;
+        decoded.priority = priority;
+        decoded.replace_serial = serial;
+        
+        mesh.PackVertexData();
+        CompressMeshData(mesh, m_config.vertex_format, m_config.index16);
+        decoded.success = mesh.vertex_count > 0;
+        decoded.mesh = std::move(mesh);
+        
+        {
+            std::lock_guard lock(m_ready_mutex);
+            m_ready.push_back(std::move(decoded));
+        }
+        m_loads_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+    };
+    
+    // Counted as a load so Shutdown waits for it
+    m_loads_in_flight.fetch_add(1, std::memory_order_acq_rel);
+    if (m_jobs) {
+        m_jobs->Submit(std::move(convert), JobPriority::Normal);
+    } else {
+        convert();
+    }
+    return true;
+}
+
 MeshHandle AssetManager::CreateMesh(MeshData& mesh_data) {
-    MeshHandle handle;
-    handle.index = m_next_mesh_handle++;
-    handle.generation = 1;
+    MeshHandle handle = AllocateMesh();
     
     // Pack high-level vertices/indices into raw data if provided
     mesh_data.PackVertexData();
     
-    m_meshes[handle.index] = std::move(mesh_data);
-    m_mesh_states[handle.index] = AssetState::Loaded;
-    UploadMesh(handle);
+    AddOwnedMesh(handle, std::move(mesh_data));
     
     MeshData* stored = GetMesh(handle);
     LOG_DEBUG("Created mesh '{}': {} vertices, {} triangles",
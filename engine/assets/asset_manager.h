@@ -2,9 +2,19 @@
 
 #include "core/types.h"
 #include "core/jobs/job_system.h"
+#include "core/containers/handle_pool.h"
+#include "core/string_id.h"
+#include "mesh_format.h"
+#include "derived_data_cache.h"
+#include "asset_package.h"
 #include <unordered_map>
-#include <queue>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <functional>
+#include <span>
+#include <chrono>
 
 namespace action {
 
@@ -20,6 +30,21 @@ class VulkanContext;
  * - Upload budget: 2MB/frame
  * - LRU cache eviction
  * - Predictive loading
+ * 
+ * Usage:
+ * - LoadMesh/LoadTexture queue an async load and return a handle at once;
+ *   completion callbacks run on the main thread, inside Update
+ * - Each returned handle holds one reference; Release it when done
+ * - Callers that load the same asset repeatedly can keep its AssetID and use
+ *   the AssetID overloads
+ * - Mounted asset packages are searched before loose files
+ * 
+ * Contracts:
+ * - Zero-ref assets stay cached until a pool overflows (LRU eviction); stale
+ *   handles resolve to nullptr
+ * - ReplaceMesh keeps the handle valid across a hot reload
+ * - GPU memory of evicted or replaced assets is destroyed frames_in_flight
+ *   frames later
  */
 
 struct AssetManagerConfig {
@@ -27,6 +52,11 @@ struct AssetManagerConfig {
     size_t mesh_pool_size = 300_MB;
     size_t upload_budget_per_frame = 2_MB;
     float prediction_time = 2.0f;
+    u32 max_loads_in_flight = 8;  // Requests being read/decoded on workers at once
+    u32 frames_in_flight = 3;     // GPU may still read evicted buffers this many frames
+    VertexFormat vertex_format = VertexFormat::Packed16;  // GPU vertex layout for all meshes
+    bool index16 = true;          // u16 indices for meshes with <= 65536 vertices
+    DerivedDataCacheConfig derived_data;  // Decoded textures and import output
 };
 
 // Asset types
@@ -48,16 +78,21 @@ enum class AssetState : u8 {
     Failed
 };
 
-// Asset metadata
+// Asset metadata (cold)
 struct AssetInfo {
-    std::string path;
-    AssetType type;
-    size_t size_bytes;
+    AssetID id;  // Path: id.GetString()
+    AssetType type = AssetType::Mesh;
+    size_t size_bytes = 0;
     u32 ref_count = 0;
-    float last_access_time = 0;
     float priority = 0;
 };
 
+// Index range of one LOD inside a mesh's shared index buffer
+struct MeshLODRange {
+    u32 first_index = 0;
+    u32 index_count = 0;
+};
+
 // Mesh asset
 struct MeshData {
     std::string name;  // Mesh name for debugging
@@ -67,15 +102,25 @@ struct MeshData {
     u32 index_count = 0;
     u32 triangle_count = 0;
     AABB bounds;
+    std::vector<MeshLODRange> lods;  // Cooked meshes: LOD0 first, index_count covers LOD0
+    
+    // Layout of vertex_data/index_data
+    VertexFormat vertex_format = VertexFormat::Float32;
+    bool index16 = false;
+    vec3 position_offset{0, 0, 0};  // Packed16: position = offset + unorm * scale
+    vec3 position_scale{1, 1, 1};
     
     // Higher-level vertex/index access (for imports)
     std::vector<Vertex> vertices;
     std::vector<u32> indices;
     
-    // Convert vertices to raw data
+    // Convert vertices to raw data (Float32 layout, u32 indices)
     void PackVertexData() {
         if (!vertices.empty()) {
             vertex_count = (u32)vertices.size();
+            vertex_format = VertexFormat::Float32;
+            position_offset = {0, 0, 0};
+            position_scale = {1, 1, 1};
             vertex_data.resize(vertex_count * sizeof(float) * 8);  // pos(3) + normal(3) + uv(2)
             float* dst = reinterpret_cast<float*>(vertex_data.data());
             for (const auto& v : vertices) {
@@ -92,18 +137,27 @@ struct MeshData {
         if (!indices.empty()) {
             index_count = (u32)indices.size();
             triangle_count = index_count / 3;
+            index16 = false;
             index_data.resize(index_count * sizeof(u32));
             memcpy(index_data.data(), indices.data(), index_data.size());
         }
     }
-    
-    // GPU resources (filled after upload) - stored as void* for header decoupling
-    // These are VkBuffer and VkDeviceMemory handles, cast in vulkan code
-    void* gpu_vertex_buffer = nullptr;
-    void* gpu_vertex_memory = nullptr;
-    void* gpu_index_buffer = nullptr;
-    void* gpu_index_memory = nullptr;
+};
+
+// Per-draw mesh data (hot) - stored as void* for header decoupling
+// These are VkBuffer and VkDeviceMemory handles, cast in vulkan code
+struct MeshGpuData {
+    void* vertex_buffer = nullptr;
+    void* index_buffer = nullptr;
+    u32 index_count = 0;
+    VertexFormat vertex_format = VertexFormat::Float32;  // Selects the pipeline variant
+    bool index16 = false;
     bool uploaded = false;
+    vec3 position_offset{0, 0, 0};  // Packed16 dequantization, folded into the model matrix
+    vec3 position_scale{1, 1, 1};
+    float last_access_time = 0;  // LRU, written on every lookup
+    void* vertex_memory = nullptr;
+    void* index_memory = nullptr;
 };
 
 // Texture asset
@@ -113,9 +167,13 @@ struct TextureData {
     u32 height = 0;
     u32 mip_levels = 1;
     u32 format = 0;  // VkFormat
-    
-    // GPU resource
-    void* gpu_image = nullptr;
+};
+
+// Texture data touched at bind time (hot)
+struct TextureGpuData {
+    void* image = nullptr;  // VkImage
+    bool uploaded = false;
+    float last_access_time = 0;
 };
 
 // Material asset
@@ -129,12 +187,19 @@ struct MaterialData {
     float roughness = 0.5f;
 };
 
-// Load request
+// Load completion callback (main thread)
+using AssetLoadCallback = std::function<void(bool success)>;
+
+// Mesh data was replaced in place (main thread, after the GPU swap)
+using MeshReplacedCallback = std::function<void(MeshHandle handle)>;
+
+// Load request (moved through the queue and the read/decode jobs, never copied)
 struct LoadRequest {
-    std::string path;
-    AssetType type;
-    float priority;
-    std::function<void(bool success)> callback;
+    AssetID id;
+    AssetType type = AssetType::Mesh;
+    u32 handle_index = 0;
+    u32 handle_generation = 0;
+    float priority = 0;
     
     bool operator<(const LoadRequest& o) const {
         return priority < o.priority;  // Higher priority first
@@ -152,17 +217,37 @@ public:
     // Set Vulkan context for GPU uploads
     void SetVulkanContext(VulkanContext* context) { m_vulkan_context = context; }
     
-    // Per-frame update (process load queue, upload to GPU)
+    // Set job system for background reads/decodes (without one, loads run inline in Update)
+    void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+    JobSystem* GetJobSystem() const { return m_jobs; }
+    
+    // Local derived data cache (shared with the importer)
+    DerivedDataCache* GetDerivedDataCache() { return &m_derived_data; }
+    
+    // Asset packages (thread-safe; do not unmount while loads from it are in flight)
+    bool MountPackage(const std::string& path);
+    void UnmountPackage(const std::string& path);
+    void UnmountAllPackages();
+    bool IsInPackage(const std::string& path) const;
+    
+    // Per-frame update (commit decoded assets to GPU, dispatch queued loads)
     void Update(size_t upload_budget);
     
-    // Asset loading (async)
-    MeshHandle LoadMesh(const std::string& path, float priority = 0);
-    TextureHandle LoadTexture(const std::string& path, float priority = 0);
+    // Asset loading (async). Callback runs on the main thread once the asset
+    // is Loaded or Failed (immediately if it already is).
+    MeshHandle LoadMesh(const std::string& path, float priority = 0, AssetLoadCallback callback = nullptr);
+    MeshHandle LoadMesh(AssetID id, float priority = 0, AssetLoadCallback callback = nullptr);
+    TextureHandle LoadTexture(const std::string& path, float priority = 0, AssetLoadCallback callback = nullptr);
+    TextureHandle LoadTexture(AssetID id, float priority = 0, AssetLoadCallback callback = nullptr);
     MaterialHandle LoadMaterial(const std::string& path, float priority = 0);
+    MaterialHandle LoadMaterial(AssetID id, float priority = 0);
     
-    // Synchronous loading (blocks)
+    // Synchronous loading (blocks). Returns with the asset Loaded or Failed,
+    // also when an async load of it is queued or in flight.
     MeshHandle LoadMeshSync(const std::string& path);
+    MeshHandle LoadMeshSync(AssetID id);
     TextureHandle LoadTextureSync(const std::string& path);
+    TextureHandle LoadTextureSync(AssetID id);
     
     // Procedural mesh creation (for test scenes)
     MeshHandle CreatePlaneMesh(float width, float depth, u32 segments_x = 1, u32 segments_z = 1);
@@ -172,20 +257,50 @@ public:
     // Create mesh from imported data
     MeshHandle CreateMesh(MeshData& mesh_data);
     
-    // Get loaded assets
+    // Replace a live mesh's data, keeping the handle (hot reload). Conversion runs on
+    // a worker, the swap in Update within the upload budget; until then the old data
+    // draws. A newer replacement of the same mesh supersedes a pending one.
+    // Returns false (mesh_data untouched) if the handle is stale or not loaded.
+    bool ReplaceMesh(MeshHandle handle, MeshData&& mesh_data, float priority = 0);
+    void SetMeshReplacedCallback(MeshReplacedCallback callback) { m_mesh_replaced_callback = std::move(callback); }
+    
+    // Get loaded assets (nullptr for stale or unknown handles)
     MeshData* GetMesh(MeshHandle handle);
     TextureData* GetTexture(TextureHandle handle);
     MaterialData* GetMaterial(MaterialHandle handle);
     
+    // Draw-time lookup: array index plus generation check, no hashing
+    const MeshGpuData* GetMeshGpu(MeshHandle handle) {
+        if (!m_mesh_slots.IsValid(handle)) return nullptr;
+        MeshGpuData& gpu = m_mesh_gpu[handle.index];
+        gpu.last_access_time = m_time;
+        return &gpu;
+    }
+    
+    bool IsValid(MeshHandle handle) const { return m_mesh_slots.IsValid(handle); }
+    bool IsValid(TextureHandle handle) const { return m_texture_slots.IsValid(handle); }
+    bool IsValid(MaterialHandle handle) const { return m_material_slots.IsValid(handle); }
+    
+    // Asset identity (invalid for procedural/imported meshes and stale handles)
+    AssetID GetMeshID(MeshHandle handle) const;
+    AssetID GetTextureID(TextureHandle handle) const;
+    AssetID GetMaterialID(MaterialHandle handle) const;
+    
+    // Loaded or loading asset by ID (invalid handle if unknown; no reference added)
+    MeshHandle FindMesh(AssetID id) const;
+    TextureHandle FindTexture(AssetID id) const;
+    
     // Asset state
     AssetState GetMeshState(MeshHandle handle) const;
     AssetState GetTextureState(TextureHandle handle) const;
     
-    // Reference counting
+    // Reference counting (zero-ref assets become eviction candidates)
     void AddRef(MeshHandle handle);
     void Release(MeshHandle handle);
     void AddRef(TextureHandle handle);
     void Release(TextureHandle handle);
+    u32 GetRefCount(MeshHandle handle) const;
+    u32 GetRefCount(TextureHandle handle) const;
     
     // Preloading (for known assets)
     void PreloadAssets(const std::vector<std::string>& paths);
@@ -194,56 +309,145 @@ public:
     size_t GetBytesUploadedThisFrame() const { return m_bytes_uploaded; }
     size_t GetTexturePoolUsage() const { return m_texture_pool_used; }
     size_t GetMeshPoolUsage() const { return m_mesh_pool_used; }
+    size_t GetPendingDestroyBytes() const { return m_retired_mesh_bytes + m_retired_texture_bytes; }
     u32 GetPendingLoadCount() const;
     
 private:
-    // Internal loading
-    bool LoadMeshFromFile(const std::string& path, MeshData& out_data);
-    bool LoadTextureFromFile(const std::string& path, TextureData& out_data);
+    // Decoded on a worker, waiting for the main-thread GPU commit
+    struct DecodedAsset {
+        AssetType type;
+        u32 handle_index = 0;
+        u32 handle_generation = 0;
+        float priority = 0;
+        bool success = false;
+        u64 replace_serial = 0;  // Non-zero: in-place replacement of a loaded mesh
+        MeshData mesh;
+        TextureData texture;
+    };
+    
+    // Pipeline stages
+    void DispatchLoads();                                        // Main: Queued -> Loading
+    void ReadStage(LoadRequest request);                         // Worker: file I/O
+    void DecodeStage(LoadRequest request, std::vector<u8> bytes); // Worker: parse/transcode
+    void CommitDecodedAssets(size_t upload_budget);              // Main: GPU upload
+    void FinishLoad(AssetType type, u32 handle_index, bool success);
+    void CommitReplacement(DecodedAsset& asset);
+    
+    // Handle lookup/allocation by asset ID (returns true in is_new if just created)
+    MeshHandle AcquireMeshHandle(AssetID id, bool& is_new);
+    TextureHandle AcquireTextureHandle(AssetID id, bool& is_new);
+    
+    // Internal loading (thread-safe; packages first, then loose files). Paths are
+    // the interned strings of the IDs, used for extensions and logs.
+    bool ReadFile(AssetID id, std::vector<u8>& out_bytes) const;
+    static bool DecodeMesh(std::string_view path, std::span<const u8> bytes, MeshData& out_data);
+    static bool DecodeTexture(std::string_view path, std::span<const u8> bytes, TextureData& out_data);
+    static bool IsCookedMesh(std::string_view path);
+    bool LoadCookedMesh(AssetID id, MeshData& out_data,
+                        VertexFormat format = VertexFormat::Float32) const;  // Memory-mapped
+    bool LoadMeshFromFile(AssetID id, MeshData& out_data);
+    bool LoadTextureFromFile(AssetID id, TextureData& out_data);
+    bool DecodeTextureCached(std::string_view path, std::span<const u8> bytes, TextureData& out_data);
     
     // GPU upload
     bool UploadMesh(MeshHandle handle);
     bool UploadTexture(TextureHandle handle);
     
     // Cache management (LRU eviction)
+    bool ReserveMemory(AssetType type, size_t bytes);  // Evicts as needed; true if it fits now
     void EvictLRU(AssetType type, size_t bytes_needed);
+    void EvictMesh(u32 handle_index);
+    void RetireMeshBuffers(u32 handle_index);  // GPU buffers -> m_retired, slot keeps its data
+    void EvictTexture(u32 handle_index);
+    void DestroyRetiredResources(bool force);
+    void DestroyMeshBuffers(void* vertex_buffer, void* vertex_memory, void* index_buffer, void* index_memory);
+    
+    // Engine-created meshes (procedural/imported): owned by the creator, one reference
+    void AddOwnedMesh(MeshHandle handle, MeshData&& mesh);
     
-    // Handle allocation
-    template<typename T>
-    Handle<T> AllocateHandle();
+    // Slot allocation: grows the parallel arrays and resets the new slot
+    MeshHandle AllocateMesh();
+    TextureHandle AllocateTexture();
+    void FreeMesh(u32 handle_index);
+    void FreeTexture(u32 handle_index);
     
     AssetManagerConfig m_config;
     
-    // Asset storage
-    std::unordered_map<u32, MeshData> m_meshes;
-    std::unordered_map<u32, TextureData> m_textures;
-    std::unordered_map<u32, MaterialData> m_materials;
+    // Mesh storage: one generational slot per mesh, arrays indexed by handle.index
+    HandlePool<Mesh> m_mesh_slots;
+    std::vector<MeshGpuData> m_mesh_gpu;  // Hot
+    std::vector<AssetState> m_mesh_states;
+    std::vector<MeshData> m_mesh_data;    // Cold: CPU copies, names
+    std::vector<AssetInfo> m_mesh_info;   // Cold: asset ID, refs, size
     
-    // Asset info (path -> handle mapping)
-    std::unordered_map<std::string, MeshHandle> m_mesh_paths;
-    std::unordered_map<std::string, TextureHandle> m_texture_paths;
+    // Texture storage (same layout)
+    HandlePool<Texture> m_texture_slots;
+    std::vector<TextureGpuData> m_texture_gpu;
+    std::vector<AssetState> m_texture_states;
+    std::vector<TextureData> m_texture_data;
+    std::vector<AssetInfo> m_texture_info;
     
-    // Asset state
-    std::unordered_map<u32, AssetState> m_mesh_states;
-    std::unordered_map<u32, AssetState> m_texture_states;
+    HandlePool<Material> m_material_slots;
+    std::vector<MaterialData> m_materials;
+    std::vector<AssetID> m_material_info;  // Asset ID per slot (invalid: anonymous)
+    
+    // Asset ID -> handle mapping
+    std::unordered_map<AssetID, MeshHandle> m_mesh_ids;
+    std::unordered_map<AssetID, TextureHandle> m_texture_ids;
+    std::unordered_map<AssetID, MaterialHandle> m_material_ids;
+    
+    // Evicted GPU resources waiting for in-flight frames to finish
+    struct RetiredResource {
+        AssetType type;
+        void* vertex_buffer = nullptr;
+        void* vertex_memory = nullptr;
+        void* index_buffer = nullptr;
+        void* index_memory = nullptr;
+        size_t size_bytes = 0;
+        u64 destroy_frame = 0;
+    };
+    std::vector<RetiredResource> m_retired;
+    size_t m_retired_mesh_bytes = 0;
+    size_t m_retired_texture_bytes = 0;
     
-    // Load queue
+    // Load queue: max-heap on priority (std::push_heap/pop_heap), so the top
+    // request can be moved out rather than copied
     std::mutex m_queue_mutex;
-    std::priority_queue<LoadRequest> m_load_queue;
+    std::vector<LoadRequest> m_load_queue;
     
-    // Handle counters
-    u32 m_next_mesh_handle = 1;
-    u32 m_next_texture_handle = 1;
-    u32 m_next_material_handle = 1;
+    // Worker -> main thread handoff
+    std::mutex m_ready_mutex;
+    std::vector<DecodedAsset> m_ready;
+    std::atomic<u32> m_loads_in_flight{0};
+    
+    // Latest replacement per mesh slot; older ones still in flight are dropped (main thread only)
+    std::unordered_map<u32, u64> m_mesh_replacements;
+    u64 m_next_replace_serial = 1;
+    MeshReplacedCallback m_mesh_replaced_callback;
+    
+    // Callbacks waiting for a load to finish (main thread only)
+    std::unordered_map<u32, std::vector<AssetLoadCallback>> m_mesh_callbacks;
+    std::unordered_map<u32, std::vector<AssetLoadCallback>> m_texture_callbacks;
     
     // Memory tracking
     size_t m_texture_pool_used = 0;
     size_t m_mesh_pool_used = 0;
     size_t m_bytes_uploaded = 0;
     
+    // Frame counter and clock for deferred destruction and LRU
+    u64 m_frame = 0;
+    float m_time = 0;
+    std::chrono::steady_clock::time_point m_start_time;
+    
     // Job system reference
     JobSystem* m_jobs = nullptr;
     
+    DerivedDataCache m_derived_data;
+    
+    // Mounted packages, searched back to front
+    mutable std::shared_mutex m_package_mutex;
+    std::vector<std::unique_ptr<AssetPackage>> m_packages;
+    
     // Vulkan context for GPU uploads
     VulkanContext* m_vulkan_context = nullptr;
 };
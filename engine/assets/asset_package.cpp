@@ -0,0 +1,570 @@
+#include "asset_package.h"
+#include "core/logging.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace action {
+
+struct PackageHeader {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 slot_count;           // Power of two
+    u32 alignment;
+    u32 reserved;
+    u64 entry_table_offset;
+    u64 slot_table_offset;
+    u64 string_table_offset;
+    u64 string_table_size;
+};
+static_assert(sizeof(PackageHeader) == 56);
+
+struct PackageEntry {
+    u64 path_hash;
+    u64 offset;
+    u64 stored_size;
+    u64 size;
+    u32 path_offset;          // Into the string table
+    u32 path_length;
+    u32 compression;          // PackageCompression
+    u32 reserved;
+};
+static_assert(sizeof(PackageEntry) == 48);
+
+struct PackageSlot {
+    u64 path_hash;
+    u32 entry_index;          // EMPTY_SLOT when unused
+    u32 reserved;
+};
+static_assert(sizeof(PackageSlot) == 16);
+
+namespace {
+
+constexpr u32 EMPTY_SLOT = UINT32_MAX;
+constexpr u64 TABLE_ALIGN = 8;
+
+// LZ4 block format limits
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;      // The block always ends in literals
+constexpr size_t MATCH_FIND_LIMIT = 12;  // No match starts this close to the end
+constexpr size_t MAX_OFFSET = 65535;
+constexpr u64 MAX_EXPANSION = 255;       // Most a block can decompress to, per input byte
+constexpr u32 HASH_BITS = 16;
+
+u64 AlignUp(u64 value, u64 alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+u32 Load32(const u8* bytes) {
+    u32 value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+void WriteLengthBytes(std::vector<u8>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<u8>(length));
+}
+
+// One sequence: literals followed by a match (match_length 0 = final literals only)
+void EmitSequence(std::vector<u8>& out, const u8* literals, size_t literal_count,
+                  size_t offset, size_t match_length) {
+    size_t match_code = match_length > 0 ? match_length - MIN_MATCH : 0;
+    u8 token = static_cast<u8>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15));
+    out.push_back(token);
+    if (literal_count >= 15) WriteLengthBytes(out, literal_count - 15);
+    out.insert(out.end(), literals, literals + literal_count);
+
+    if (match_length == 0) return;
+    out.push_back(static_cast<u8>(offset & 0xFF));
+    out.push_back(static_cast<u8>(offset >> 8));
+    if (match_code >= 15) WriteLengthBytes(out, match_code - 15);
+}
+
+bool ReadLengthBytes(std::span<const u8> in, size_t& cursor, size_t& length) {
+    while (true) {
+        if (cursor >= in.size()) return false;
+        u8 byte = in[cursor++];
+        length += byte;
+        if (byte != 255) return true;
+    }
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<u8>& out_bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    std::streamsize size = file.tellg();
+    if (size < 0) return false;
+
+    out_bytes.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(out_bytes.data()), size));
+}
+
+} // namespace
+
+// ===== AssetPackage =====
+
+bool AssetPackage::Open(const std::string& path) {
+    Close();
+
+    // Random access: prefetching a whole package would read assets nobody asked for
+    if (!m_file.Open(path, false)) {
+        LOG_ERROR("Cannot open asset package {}", path);
+        return false;
+    }
+
+    auto fail = [&](const char* reason) {
+        LOG_ERROR("Invalid asset package {}: {}", path, reason);
+        Close();
+        return false;
+    };
+
+    const u8* data = m_file.GetData();
+    u64 file_size = m_file.GetSize();
+    if (file_size < sizeof(PackageHeader)) return fail("truncated header");
+
+    PackageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC) return fail("bad magic");
+    if (header.version != VERSION) return fail("unsupported version");
+
+    if (header.slot_count == 0 || (header.slot_count & (header.slot_count - 1)) != 0 ||
+        header.slot_count <= header.entry_count) {
+        return fail("bad slot table");
+    }
+
+    // Tables must lie inside the file and be aligned for in-place access
+    u64 entry_bytes = static_cast<u64>(header.entry_count) * sizeof(PackageEntry);
+    u64 slot_bytes = static_cast<u64>(header.slot_count) * sizeof(PackageSlot);
+    if (header.entry_table_offset % TABLE_ALIGN != 0 || header.slot_table_offset % TABLE_ALIGN != 0 ||
+        header.entry_table_offset > file_size || entry_bytes > file_size - header.entry_table_offset ||
+        header.slot_table_offset > file_size || slot_bytes > file_size - header.slot_table_offset ||
+        header.string_table_offset > file_size || header.string_table_size > file_size - header.string_table_offset) {
+        return fail("table out of bounds");
+    }
+
+    m_entries = reinterpret_cast<const PackageEntry*>(data + header.entry_table_offset);
+    m_slots = reinterpret_cast<const PackageSlot*>(data + header.slot_table_offset);
+    m_strings = reinterpret_cast<const char*>(data + header.string_table_offset);
+    m_entry_count = header.entry_count;
+    m_slot_mask = header.slot_count - 1;
+
+    // Validate every entry once so reads need no checks (LZ4 sizes are capped
+    // at the format's expansion limit, so Read never allocates an arbitrary size)
+    for (u32 i = 0; i < m_entry_count; i++) {
+        const PackageEntry& entry = m_entries[i];
+        if (entry.offset > file_size || entry.stored_size > file_size - entry.offset ||
+            static_cast<u64>(entry.path_offset) + entry.path_length > header.string_table_size ||
+            entry.compression > static_cast<u32>(PackageCompression::LZ4) ||
+            (entry.compression == static_cast<u32>(PackageCompression::None) && entry.stored_size != entry.size) ||
+            (entry.compression == static_cast<u32>(PackageCompression::LZ4) && entry.size > entry.stored_size * MAX_EXPANSION)) {
+            return fail("entry out of bounds");
+        }
+    }
+
+    // Probing stops at an empty slot: a table without one would loop forever
+    u32 empty_slots = 0;
+    for (u32 i = 0; i <= m_slot_mask; i++) {
+        if (m_slots[i].entry_index == EMPTY_SLOT) {
+            empty_slots++;
+        } else if (m_slots[i].entry_index >= m_entry_count) {
+            return fail("slot out of bounds");
+        }
+    }
+    if (empty_slots == 0) return fail("slot table has no empty slot");
+
+    m_path = path;
+    LOG_INFO("Mounted asset package {} ({} entries, {} MB)", path, m_entry_count, file_size / (1024 * 1024));
+    return true;
+}
+
+void AssetPackage::Close() {
+    m_file.Close();
+    m_path.clear();
+    m_entries = nullptr;
+    m_slots = nullptr;
+    m_strings = nullptr;
+    m_entry_count = 0;
+    m_slot_mask = 0;
+}
+
+const PackageEntry* AssetPackage::Find(u64 hash, std::string_view path) const {
+    if (!m_slots || hash == 0) return nullptr;
+
+    for (u32 index = static_cast<u32>(hash) & m_slot_mask;; index = (index + 1) & m_slot_mask) {
+        const PackageSlot& slot = m_slots[index];
+        if (slot.entry_index == EMPTY_SLOT) return nullptr;
+        if (slot.path_hash != hash) continue;
+
+        const PackageEntry& entry = m_entries[slot.entry_index];
+        if (std::string_view(m_strings + entry.path_offset, entry.path_length) == path) {
+            return &entry;
+        }
+    }
+}
+
+void AssetPackage::FillInfo(const PackageEntry& entry, PackageEntryInfo& out_info) const {
+    out_info.path = std::string_view(m_strings + entry.path_offset, entry.path_length);
+    out_info.offset = entry.offset;
+    out_info.stored_size = entry.stored_size;
+    out_info.size = entry.size;
+    out_info.compression = static_cast<PackageCompression>(entry.compression);
+}
+
+const PackageEntry* AssetPackage::Find(std::string_view asset_path) const {
+    std::string path = NormalizePath(asset_path);
+    return Find(HashPath(path), path);
+}
+
+const PackageEntry* AssetPackage::Find(AssetID id) const {
+    // The stored path confirms the match, so an ID never interned can not be found
+    std::string_view path = id.GetString();
+    if (id.IsValid() && path.empty()) {
+        LOG_ERROR("Asset ID {} has no interned path (not created with MakeAssetID)", id.ToHex());
+        return nullptr;
+    }
+    return Find(id.GetHash(), path);
+}
+
+bool AssetPackage::Contains(std::string_view asset_path) const {
+    return Find(asset_path) != nullptr;
+}
+
+bool AssetPackage::Contains(AssetID id) const {
+    return Find(id) != nullptr;
+}
+
+bool AssetPackage::GetEntryInfo(std::string_view asset_path, PackageEntryInfo& out_info) const {
+    const PackageEntry* entry = Find(asset_path);
+    if (!entry) return false;
+
+    FillInfo(*entry, out_info);
+    return true;
+}
+
+bool AssetPackage::GetEntryInfo(AssetID id, PackageEntryInfo& out_info) const {
+    const PackageEntry* entry = Find(id);
+    if (!entry) return false;
+
+    FillInfo(*entry, out_info);
+    return true;
+}
+
+bool AssetPackage::GetEntryInfo(u32 index, PackageEntryInfo& out_info) const {
+    if (index >= m_entry_count) return false;
+
+    FillInfo(m_entries[index], out_info);
+    return true;
+}
+
+std::span<const u8> AssetPackage::GetView(std::string_view asset_path) const {
+    return GetView(Find(asset_path));
+}
+
+std::span<const u8> AssetPackage::GetView(AssetID id) const {
+    return GetView(Find(id));
+}
+
+std::span<const u8> AssetPackage::GetView(const PackageEntry* entry) const {
+    if (!entry || entry->compression != static_cast<u32>(PackageCompression::None)) return {};
+
+    return {m_file.GetData() + entry->offset, static_cast<size_t>(entry->stored_size)};
+}
+
+bool AssetPackage::Read(std::string_view asset_path, std::vector<u8>& out_bytes) const {
+    return Read(Find(asset_path), out_bytes);
+}
+
+bool AssetPackage::Read(AssetID id, std::vector<u8>& out_bytes) const {
+    return Read(Find(id), out_bytes);
+}
+
+bool AssetPackage::Read(const PackageEntry* entry, std::vector<u8>& out_bytes) const {
+    if (!entry) return false;
+
+    std::span<const u8> stored(m_file.GetData() + entry->offset, static_cast<size_t>(entry->stored_size));
+    if (entry->compression == static_cast<u32>(PackageCompression::None)) {
+        out_bytes.assign(stored.begin(), stored.end());
+        return true;
+    }
+
+    PROFILE_SCOPE("AssetPackage::Decompress");
+    out_bytes.resize(static_cast<size_t>(entry->size));
+    if (!Decompress(stored, out_bytes)) {
+        LOG_ERROR("Corrupt entry {} in asset package {}",
+                  std::string_view(m_strings + entry->path_offset, entry->path_length), m_path);
+        out_bytes.clear();
+        return false;
+    }
+    return true;
+}
+
+std::string AssetPackage::NormalizePath(std::string_view path) {
+    return NormalizeAssetPath(path);
+}
+
+u64 AssetPackage::HashPath(std::string_view normalized_path) {
+    return StringID::Hash(normalized_path);
+}
+
+std::vector<u8> AssetPackage::Compress(std::span<const u8> bytes) {
+    PROFILE_SCOPE("AssetPackage::Compress");
+
+    const u8* data = bytes.data();
+    size_t size = bytes.size();
+
+    std::vector<u8> out;
+    out.reserve(size + size / 255 + 16);
+
+    if (size <= MATCH_FIND_LIMIT) {
+        EmitSequence(out, data, size, 0, 0);
+        return out;
+    }
+
+    // Position + 1 of the last occurrence of each 4-byte hash (0 = none)
+    std::vector<u32> table(size_t{1} << HASH_BITS, 0);
+
+    size_t match_start_limit = size - MATCH_FIND_LIMIT;
+    size_t match_end_limit = size - LAST_LITERALS;
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    while (pos < match_start_limit) {
+        u32 sequence = Load32(data + pos);
+        u32 hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = static_cast<u32>(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || Load32(data + candidate - 1) != sequence) {
+            pos++;
+            continue;
+        }
+        candidate--;
+
+        size_t length = MIN_MATCH;
+        while (pos + length < match_end_limit && data[candidate + length] == data[pos + length]) {
+            length++;
+        }
+
+        EmitSequence(out, data + anchor, pos - anchor, pos - candidate, length);
+        pos += length;
+        anchor = pos;
+    }
+
+    EmitSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool AssetPackage::Decompress(std::span<const u8> compressed, std::span<u8> out_bytes) {
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < compressed.size()) {
+        u8 token = compressed[in++];
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !ReadLengthBytes(compressed, in, literal_count)) return false;
+        if (literal_count > compressed.size() - in || literal_count > out_bytes.size() - out) return false;
+
+        std::memcpy(out_bytes.data() + out, compressed.data() + in, literal_count);
+        in += literal_count;
+        out += literal_count;
+
+        // The final sequence has no match
+        if (in == compressed.size()) break;
+
+        if (compressed.size() - in < 2) return false;
+        size_t offset = compressed[in] | (static_cast<size_t>(compressed[in + 1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > out) return false;
+
+        size_t length = token & 0xF;
+        if (length == 15 && !ReadLengthBytes(compressed, in, length)) return false;
+        length += MIN_MATCH;
+        if (length > out_bytes.size() - out) return false;
+
+        // Overlapping copies repeat the last `offset` bytes
+        u8* dst = out_bytes.data() + out;
+        const u8* src = dst - offset;
+        if (offset >= length) {
+            std::memcpy(dst, src, length);
+        } else {
+            for (size_t i = 0; i < length; i++) dst[i] = src[i];
+        }
+        out += length;
+    }
+
+    return out == out_bytes.size();
+}
+
+// ===== AssetPackageWriter =====
+
+void AssetPackageWriter::AddFile(const std::string& asset_path, const std::string& source_path, bool compress) {
+    AddSource({AssetPackage::NormalizePath(asset_path), source_path, {}, compress});
+}
+
+void AssetPackageWriter::AddData(const std::string& asset_path, std::vector<u8> bytes, bool compress) {
+    AddSource({AssetPackage::NormalizePath(asset_path), {}, std::move(bytes), compress});
+}
+
+void AssetPackageWriter::AddSource(Source source) {
+    auto [it, inserted] = m_source_index.try_emplace(source.path, m_sources.size());
+    if (inserted) {
+        m_sources.push_back(std::move(source));
+    } else {
+        m_sources[it->second] = std::move(source);
+    }
+}
+
+bool AssetPackageWriter::Write(const std::string& output_path, AssetPackageStats* out_stats) {
+    PROFILE_SCOPE("AssetPackageWriter::Write");
+
+    if (m_alignment < 16 || (m_alignment & (m_alignment - 1)) != 0) {
+        LOG_ERROR("Asset package alignment must be a power of two >= 16 (got {})", m_alignment);
+        return false;
+    }
+
+    // Sorted by path: a directory's assets sit together in the file
+    std::sort(m_sources.begin(), m_sources.end(), [](const Source& a, const Source& b) {
+        return a.path < b.path;
+    });
+    m_source_index.clear();
+    for (size_t i = 0; i < m_sources.size(); i++) {
+        m_source_index[m_sources[i].path] = i;
+    }
+
+    std::string temp_path = output_path + ".tmp";
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("Cannot create asset package {}", temp_path);
+        return false;
+    }
+
+    u64 position = 0;
+    auto write = [&](const void* data, u64 size) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        position += size;
+    };
+    auto pad_to = [&](u64 alignment) {
+        static constexpr char zeros[256] = {};
+        u64 padding = AlignUp(position, alignment) - position;
+        while (padding > 0) {
+            u64 chunk = std::min<u64>(padding, sizeof(zeros));
+            write(zeros, chunk);
+            padding -= chunk;
+        }
+    };
+    auto abort_write = [&](const std::string& reason) {
+        LOG_ERROR("Failed to write asset package {}: {}", output_path, reason);
+        file.close();
+        std::error_code ec;
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    };
+
+    PackageHeader header{};
+    write(&header, sizeof(header));  // Rewritten once the offsets are known
+
+    std::vector<PackageEntry> entries;
+    entries.reserve(m_sources.size());
+    std::string strings;
+    AssetPackageStats stats;
+
+    std::vector<u8> bytes;
+    for (Source& source : m_sources) {
+        if (source.source_path.empty()) {
+            bytes = std::move(source.bytes);
+        } else if (!ReadWholeFile(source.source_path, bytes)) {
+            return abort_write("cannot read " + source.source_path);
+        }
+
+        PackageEntry entry{};
+        entry.path_hash = AssetPackage::HashPath(source.path);
+        entry.size = bytes.size();
+        entry.path_offset = static_cast<u32>(strings.size());
+        entry.path_length = static_cast<u32>(source.path.size());
+        strings += source.path;
+
+        std::vector<u8> compressed;
+        if (source.compress && !bytes.empty()) {
+            compressed = AssetPackage::Compress(bytes);
+        }
+        bool use_compressed = !compressed.empty() &&
+            compressed.size() <= bytes.size() * (1.0f - AssetPackageWriter::MIN_COMPRESSION_SAVING);
+        const std::vector<u8>& stored = use_compressed ? compressed : bytes;
+
+        pad_to(m_alignment);
+        entry.offset = position;
+        entry.stored_size = stored.size();
+        entry.compression = static_cast<u32>(use_compressed ? PackageCompression::LZ4 : PackageCompression::None);
+        write(stored.data(), stored.size());
+        entries.push_back(entry);
+
+        stats.raw_size += entry.size;
+        stats.stored_size += entry.stored_size;
+        stats.compressed_count += use_compressed ? 1 : 0;
+    }
+
+    // Path table at most half full keeps probe sequences short
+    u32 slot_count = 1;
+    while (slot_count < entries.size() * 2) slot_count <<= 1;
+
+    std::vector<PackageSlot> slots(slot_count, PackageSlot{0, EMPTY_SLOT, 0});
+    for (u32 i = 0; i < entries.size(); i++) {
+        u32 index = static_cast<u32>(entries[i].path_hash) & (slot_count - 1);
+        while (slots[index].entry_index != EMPTY_SLOT) {
+            index = (index + 1) & (slot_count - 1);
+        }
+        slots[index] = {entries[i].path_hash, i, 0};
+    }
+
+    pad_to(TABLE_ALIGN);
+    header.entry_table_offset = position;
+    write(entries.data(), entries.size() * sizeof(PackageEntry));
+
+    pad_to(TABLE_ALIGN);
+    header.slot_table_offset = position;
+    write(slots.data(), slots.size() * sizeof(PackageSlot));
+
+    header.string_table_offset = position;
+    header.string_table_size = strings.size();
+    write(strings.data(), strings.size());
+
+    header.magic = AssetPackage::MAGIC;
+    header.version = AssetPackage::VERSION;
+    header.entry_count = static_cast<u32>(entries.size());
+    header.slot_count = slot_count;
+    header.alignment = m_alignment;
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!file) return abort_write("write error");
+    file.close();
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, output_path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        LOG_ERROR("Failed to publish asset package {}: {}", output_path, ec.message());
+        return false;
+    }
+
+    stats.entry_count = header.entry_count;
+    stats.file_size = position;
+    if (out_stats) *out_stats = stats;
+
+    LOG_INFO("Wrote asset package {} ({} entries, {} compressed, {} KB -> {} KB)", output_path,
+             stats.entry_count, stats.compressed_count, stats.raw_size / 1024, stats.stored_size / 1024);
+    return true;
+}
+
+} // namespace action
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/string_id.h"
+#include "platform/mapped_file.h"
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace action {
+
+/*
+ * Asset Package - Single-file archive of loose asset files
+ *
+ * Layout (native endianness, every section offset in the header):
+ *   Header | entry data... | entry table | path slot table | path strings
+ *
+ * - One open + one mapping per package instead of one open per asset
+ * - Paths are looked up through an open-addressing table of 64-bit path
+ *   hashes (power-of-two slots, linear probing); the stored path string
+ *   confirms the match. The hash is the path's AssetID, so callers holding
+ *   an AssetID look entries up without normalizing or hashing again.
+ * - Entry data starts on `alignment` boundaries, so stored (uncompressed)
+ *   entries can be used in place from the mapping (cooked meshes)
+ * - Entries are optionally LZ-compressed (LZ4 block format); the writer
+ *   keeps an entry stored when compression saves too little
+ * - Paths are normalized: '/' separators, no "./" or empty segments
+ * - Read-only once open; lookups and reads are thread-safe
+ */
+
+enum class PackageCompression : u32 {
+    None = 0,
+    LZ4 = 1
+};
+
+// On-disk records (defined in asset_package.cpp)
+struct PackageHeader;
+struct PackageEntry;
+struct PackageSlot;
+
+struct PackageEntryInfo {
+    std::string_view path;
+    u64 offset = 0;        // From the start of the package
+    u64 stored_size = 0;   // Bytes in the package
+    u64 size = 0;          // Bytes after decompression
+    PackageCompression compression = PackageCompression::None;
+};
+
+class AssetPackage {
+public:
+    static constexpr u32 MAGIC = 0x4B415041;  // "APAK"
+    static constexpr u32 VERSION = 2;  // 2: path hashes are AssetIDs
+
+    AssetPackage() = default;
+    ~AssetPackage() = default;
+
+    AssetPackage(const AssetPackage&) = delete;
+    AssetPackage& operator=(const AssetPackage&) = delete;
+
+    // Maps the file and validates the header and tables
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_file.IsOpen(); }
+    const std::string& GetPath() const { return m_path; }
+    u32 GetEntryCount() const { return m_entry_count; }
+
+    bool Contains(std::string_view asset_path) const;
+    bool Contains(AssetID id) const;
+    bool GetEntryInfo(std::string_view asset_path, PackageEntryInfo& out_info) const;
+    bool GetEntryInfo(AssetID id, PackageEntryInfo& out_info) const;
+    bool GetEntryInfo(u32 index, PackageEntryInfo& out_info) const;
+
+    // Bytes of a stored entry, straight from the mapping (valid while the package
+    // is open). Empty for missing or compressed entries.
+    std::span<const u8> GetView(std::string_view asset_path) const;
+    std::span<const u8> GetView(AssetID id) const;
+
+    // Copies (and decompresses) an entry
+    bool Read(std::string_view asset_path, std::vector<u8>& out_bytes) const;
+    bool Read(AssetID id, std::vector<u8>& out_bytes) const;
+
+    static std::string NormalizePath(std::string_view path);
+    static u64 HashPath(std::string_view normalized_path);
+
+    // LZ4 block format; Decompress fails unless it produces exactly out_bytes.size() bytes
+    static std::vector<u8> Compress(std::span<const u8> bytes);
+    static bool Decompress(std::span<const u8> compressed, std::span<u8> out_bytes);
+
+private:
+    const PackageEntry* Find(std::string_view asset_path) const;
+    const PackageEntry* Find(AssetID id) const;
+    const PackageEntry* Find(u64 hash, std::string_view normalized_path) const;  // Hash of normalized_path
+    std::span<const u8> GetView(const PackageEntry* entry) const;
+    bool Read(const PackageEntry* entry, std::vector<u8>& out_bytes) const;
+    void FillInfo(const PackageEntry& entry, PackageEntryInfo& out_info) const;
+
+    MappedFile m_file;
+    std::string m_path;
+
+    const PackageEntry* m_entries = nullptr;
+    const PackageSlot* m_slots = nullptr;
+    const char* m_strings = nullptr;
+    u32 m_entry_count = 0;
+    u32 m_slot_mask = 0;
+};
+
+struct AssetPackageStats {
+    u32 entry_count = 0;
+    u32 compressed_count = 0;
+    u64 raw_size = 0;      // Sum of entry sizes
+    u64 stored_size = 0;   // Sum of entry bytes in the package
+    u64 file_size = 0;
+};
+
+/*
+ * Builds a package. Sources are read during Write, one at a time.
+ */
+class AssetPackageWriter {
+public:
+    // Compressed entries must save at least this fraction or they are stored
+    static constexpr float MIN_COMPRESSION_SAVING = 0.1f;
+
+    // Data alignment of every entry (power of two, >= 16)
+    void SetAlignment(u32 alignment) { m_alignment = alignment; }
+
+    // Later additions of the same path replace earlier ones
+    void AddFile(const std::string& asset_path, const std::string& source_path, bool compress);
+    void AddData(const std::string& asset_path, std::vector<u8> bytes, bool compress);
+
+    size_t GetEntryCount() const { return m_sources.size(); }
+
+    // Writes through a temp file + rename
+    bool Write(const std::string& output_path, AssetPackageStats* out_stats = nullptr);
+
+private:
+    struct Source {
+        std::string path;          // Normalized package path
+        std::string source_path;   // Empty: bytes holds the data
+        std::vector<u8> bytes;
+        bool compress = false;
+    };
+
+    void AddSource(Source source);
+
+    std::vector<Source> m_sources;
+    std::unordered_map<std::string, size_t> m_source_index;  // Path -> m_sources index
+    u32 m_alignment = 64;
+};
+
+} // namespace action
@@ -0,0 +1,352 @@
+#include "derived_data_cache.h"
+#include "core/logging.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace action {
+
+namespace {
+
+constexpr u32 DDC_MAGIC = 0x43444441;  // "ADDC"
+constexpr u32 DDC_VERSION = 1;
+constexpr const char* DDC_EXTENSION = ".ddc";
+
+struct EntryHeader {
+    u32 magic;
+    u32 version;
+    u64 key;
+    u64 payload_size;
+    u64 payload_hash;
+};
+static_assert(sizeof(EntryHeader) == 32);
+
+// Evict down to this fraction of max_size so a full cache does not evict on every put
+constexpr double EVICT_TARGET = 0.9;
+
+bool ParseKey(const std::filesystem::path& path, u64& out_key) {
+    if (path.extension() != DDC_EXTENSION) return false;
+
+    std::string stem = path.stem().string();
+    if (stem.size() != 16) return false;
+
+    u64 key = 0;
+    for (char c : stem) {
+        u32 digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else return false;
+        key = (key << 4) | digit;
+    }
+    out_key = key;
+    return true;
+}
+
+} // namespace
+
+bool DerivedDataCache::Initialize(const DerivedDataCacheConfig& config) {
+    m_config = config;
+    m_enabled = false;
+    if (config.directory.empty()) {
+        LOG_INFO("Derived data cache disabled");
+        return true;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(config.directory, ec);
+    if (ec) {
+        LOG_ERROR("Cannot create derived data cache {}: {}", config.directory, ec.message());
+        return false;
+    }
+
+    // Index existing entries, oldest first so LRU order carries over from the last session
+    struct Found {
+        u64 key;
+        u64 size;
+        std::filesystem::file_time_type time;
+    };
+    std::vector<Found> found;
+
+    for (const auto& entry : std::filesystem::directory_iterator(config.directory, ec)) {
+        if (!entry.is_regular_file(ec)) continue;
+
+        u64 key;
+        if (ParseKey(entry.path(), key)) {
+            found.push_back({key, entry.file_size(ec), entry.last_write_time(ec)});
+        } else if (entry.path().extension() == ".tmp") {
+            std::filesystem::remove(entry.path(), ec);  // Interrupted write
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.time < b.time; });
+
+    std::vector<u64> evicted;
+    {
+        std::lock_guard lock(m_mutex);
+        m_entries.clear();
+        m_stats = {};
+        for (const auto& f : found) {
+            m_entries[f.key] = {f.size, ++m_access_tick};
+            m_stats.size += f.size;
+        }
+        m_stats.entry_count = static_cast<u32>(m_entries.size());
+        evicted = CollectEvictions(m_config.max_size);
+    }
+    DeleteEntryFiles(evicted);
+
+    m_enabled = true;
+    LOG_INFO("Derived data cache: {} ({} entries, {} MB / {} MB)", config.directory,
+             m_stats.entry_count, m_stats.size / (1024 * 1024), config.max_size / (1024 * 1024));
+    return true;
+}
+
+bool DerivedDataCache::Get(u64 key, std::vector<u8>& out_data) {
+    if (!m_enabled) return false;
+    PROFILE_SCOPE("DerivedDataCache::Get");
+
+    u64 entry_size = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            m_stats.misses++;
+            return false;
+        }
+        entry_size = it->second.size;
+    }
+
+    std::string path = GetEntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+
+    // The payload size must match the indexed file size before anything is
+    // allocated: a truncated or corrupt header can claim any size
+    EntryHeader header{};
+    bool valid = file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+                 header.magic == DDC_MAGIC && header.version == DDC_VERSION && header.key == key &&
+                 entry_size >= sizeof(EntryHeader) && header.payload_size == entry_size - sizeof(EntryHeader);
+
+    std::vector<u8> payload;
+    if (valid) {
+        payload.resize(header.payload_size);
+        valid = file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size())) &&
+                HashBytes(payload) == header.payload_hash;
+    }
+    file.close();
+
+    if (!valid) {
+        LOG_WARN("Dropping corrupt derived data entry {}", path);
+        Remove(key);
+        std::lock_guard lock(m_mutex);
+        m_stats.misses++;
+        return false;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            it->second.last_access = ++m_access_tick;
+        }
+        m_stats.hits++;
+        m_stats.bytes_read += payload.size();
+    }
+
+    // Persist recency for the next session's LRU order
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+    out_data = std::move(payload);
+    return true;
+}
+
+bool DerivedDataCache::Put(u64 key, std::span<const u8> data) {
+    if (!m_enabled) return false;
+    PROFILE_SCOPE("DerivedDataCache::Put");
+
+    u64 size = sizeof(EntryHeader) + data.size();
+    if (size > m_config.max_size) return false;
+
+    EntryHeader header{DDC_MAGIC, DDC_VERSION, key, data.size(), HashBytes(data)};
+
+    // Unique temp name: concurrent puts of the same key must not share a file
+    std::string path = GetEntryPath(key);
+    std::string temp_path;
+    {
+        std::lock_guard lock(m_mutex);
+        temp_path = path + "." + std::to_string(++m_temp_counter) + ".tmp";
+    }
+
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            LOG_WARN("Failed to write derived data entry {}", temp_path);
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+
+    // Readers only ever see complete entries
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_WARN("Failed to publish derived data entry {}: {}", path, ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+
+    std::vector<u64> evicted;
+    {
+        std::lock_guard lock(m_mutex);
+        Entry& entry = m_entries[key];
+        m_stats.size -= entry.size;  // Replaced entries are re-counted
+        entry.size = size;
+        entry.last_access = ++m_access_tick;
+        m_stats.size += size;
+        m_stats.writes++;
+        m_stats.bytes_written += data.size();
+        m_stats.entry_count = static_cast<u32>(m_entries.size());
+
+        if (m_stats.size > m_config.max_size) {
+            evicted = CollectEvictions(static_cast<u64>(m_config.max_size * EVICT_TARGET));
+        }
+    }
+    DeleteEntryFiles(evicted);
+
+    return true;
+}
+
+bool DerivedDataCache::Contains(u64 key) const {
+    std::lock_guard lock(m_mutex);
+    return m_entries.find(key) != m_entries.end();
+}
+
+void DerivedDataCache::Remove(u64 key) {
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) return;
+
+        m_stats.size -= it->second.size;
+        m_entries.erase(it);
+        m_stats.entry_count = static_cast<u32>(m_entries.size());
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(GetEntryPath(key), ec);
+}
+
+void DerivedDataCache::Clear() {
+    std::vector<u64> keys;
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto& [key, entry] : m_entries) {
+            keys.push_back(key);
+        }
+        m_entries.clear();
+        m_stats.size = 0;
+        m_stats.entry_count = 0;
+    }
+    DeleteEntryFiles(keys);
+}
+
+DerivedDataCacheStats DerivedDataCache::GetStats() const {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+float DerivedDataCache::GetHitRate() const {
+    std::lock_guard lock(m_mutex);
+    u64 lookups = m_stats.hits + m_stats.misses;
+    return lookups > 0 ? static_cast<float>(m_stats.hits) / lookups : 0.0f;
+}
+
+u64 DerivedDataCache::HashBytes(std::span<const u8> bytes, u64 seed) {
+    constexpr u64 m = 0xc6a4a7935bd1e995ull;
+    constexpr int r = 47;
+
+    u64 h = seed ^ (bytes.size() * m);
+
+    const u8* data = bytes.data();
+    size_t blocks = bytes.size() / 8;
+    for (size_t i = 0; i < blocks; i++) {
+        u64 k;
+        std::memcpy(&k, data + i * 8, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    const u8* tail = data + blocks * 8;
+    size_t remaining = bytes.size() & 7;
+    if (remaining > 0) {
+        u64 k = 0;
+        for (size_t i = 0; i < remaining; i++) {
+            k |= static_cast<u64>(tail[i]) << (i * 8);
+        }
+        h ^= k;
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+u64 DerivedDataCache::HashCombine(u64 seed, u64 value) {
+    u64 pair[2] = {seed, value};
+    return HashBytes({reinterpret_cast<const u8*>(pair), sizeof(pair)});
+}
+
+std::string DerivedDataCache::GetEntryPath(u64 key) const {
+    static constexpr char digits[] = "0123456789abcdef";
+    char name[17];
+    for (int i = 15; i >= 0; i--) {
+        name[i] = digits[key & 0xF];
+        key >>= 4;
+    }
+    name[16] = '\0';
+    return (std::filesystem::path(m_config.directory) / (std::string(name) + DDC_EXTENSION)).string();
+}
+
+std::vector<u64> DerivedDataCache::CollectEvictions(u64 max_size) {
+    std::vector<u64> evicted;
+    if (m_stats.size <= max_size) return evicted;
+
+    std::vector<std::pair<u64, u64>> by_age;  // last_access, key
+    by_age.reserve(m_entries.size());
+    for (const auto& [key, entry] : m_entries) {
+        by_age.push_back({entry.last_access, key});
+    }
+    std::sort(by_age.begin(), by_age.end());
+
+    for (const auto& [access, key] : by_age) {
+        if (m_stats.size <= max_size) break;
+
+        auto it = m_entries.find(key);
+        m_stats.size -= it->second.size;
+        m_entries.erase(it);
+        evicted.push_back(key);
+    }
+
+    m_stats.evictions += evicted.size();
+    m_stats.entry_count = static_cast<u32>(m_entries.size());
+    return evicted;
+}
+
+void DerivedDataCache::DeleteEntryFiles(const std::vector<u64>& keys) {
+    std::error_code ec;
+    for (u64 key : keys) {
+        std::filesystem::remove(GetEntryPath(key), ec);
+    }
+}
+
+} // namespace action
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "core/types.h"
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace action {
+
+/*
+ * Derived Data Cache - Content-addressed store for import and cook output
+ *
+ * - Entries are opaque blobs on local disk named by a 64-bit key
+ *   (<directory>/<key as hex>.ddc)
+ * - Callers build the key from everything the output depends on: source
+ *   bytes, settings and an output format version (HashBytes/HashCombine),
+ *   so a changed input simply misses and stale entries age out
+ * - Every blob carries its key and a payload hash; truncated or corrupt
+ *   entries are deleted and count as misses
+ * - Size-bounded: least-recently-used entries are deleted once the cache
+ *   grows past max_size. Access order survives restarts through the file
+ *   modification time, which a hit refreshes.
+ * - Thread-safe (imports run on workers); file I/O runs outside the lock
+ */
+
+struct DerivedDataCacheConfig {
+    std::string directory = "cache/ddc";  // Empty = disabled
+    u64 max_size = 2_GB;
+};
+
+struct DerivedDataCacheStats {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 writes = 0;
+    u64 evictions = 0;
+    u64 bytes_read = 0;
+    u64 bytes_written = 0;
+    u64 size = 0;  // Bytes on disk
+    u32 entry_count = 0;
+};
+
+class DerivedDataCache {
+public:
+    DerivedDataCache() = default;
+    ~DerivedDataCache() = default;
+
+    // Creates the directory and indexes existing entries
+    bool Initialize(const DerivedDataCacheConfig& config);
+    bool IsEnabled() const { return m_enabled; }
+
+    // Returns false on miss (out_data untouched)
+    bool Get(u64 key, std::vector<u8>& out_data);
+
+    // Writes through a temp file + rename, then evicts down to max_size
+    bool Put(u64 key, std::span<const u8> data);
+
+    bool Contains(u64 key) const;
+    void Remove(u64 key);
+    void Clear();
+
+    DerivedDataCacheStats GetStats() const;
+    float GetHitRate() const;
+
+    // 64-bit content hash (MurmurHash64A)
+    static u64 HashBytes(std::span<const u8> bytes, u64 seed = 0);
+    static u64 HashCombine(u64 seed, u64 value);
+
+private:
+    struct Entry {
+        u64 size = 0;
+        u64 last_access = 0;  // Monotonic tick, higher = more recent
+    };
+
+    std::string GetEntryPath(u64 key) const;
+    std::vector<u64> CollectEvictions(u64 max_size);  // Lock held; removes from the index
+    void DeleteEntryFiles(const std::vector<u64>& keys);
+
+    DerivedDataCacheConfig m_config;
+    bool m_enabled = false;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<u64, Entry> m_entries;
+    u64 m_access_tick = 0;
+    u64 m_temp_counter = 0;
+    DerivedDataCacheStats m_stats;
+};
+
+/*
+ * Blob serialization helpers for cache payloads (native endianness, local cache only)
+ */
+class DerivedDataWriter {
+public:
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void WriteArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write<u64>(values.size());
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void WriteString(const std::string& value) {
+        Write<u64>(value.size());
+        WriteBytes(value.data(), value.size());
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        size_t offset = m_data.size();
+        m_data.resize(offset + size);
+        if (size > 0) std::memcpy(m_data.data() + offset, data, size);
+    }
+
+    std::vector<u8>& GetData() { return m_data; }
+
+private:
+    std::vector<u8> m_data;
+};
+
+class DerivedDataReader {
+public:
+    explicit DerivedDataReader(std::span<const u8> data) : m_data(data) {}
+
+    // Every read fails (and keeps failing) once the blob is exhausted
+    template<typename T>
+    bool Read(T& out_value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return ReadBytes(&out_value, sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadArray(std::vector<T>& out_values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        u64 count = 0;
+        if (!Read(count) || count > Remaining() / sizeof(T)) return Fail();
+        out_values.resize(count);
+        return ReadBytes(out_values.data(), count * sizeof(T));
+    }
+
+    bool ReadString(std::string& out_value) {
+        u64 size = 0;
+        if (!Read(size) || size > Remaining()) return Fail();
+        out_value.assign(reinterpret_cast<const char*>(m_data.data() + m_offset), size);
+        m_offset += size;
+        return true;
+    }
+
+    bool ReadBytes(void* out_data, size_t size) {
+        if (!m_ok || size > Remaining()) return Fail();
+        if (size > 0) std::memcpy(out_data, m_data.data() + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    size_t Remaining() const { return m_data.size() - m_offset; }
+    bool IsOk() const { return m_ok; }
+
+private:
+    bool Fail() {
+        m_ok = false;
+        return false;
+    }
+
+    std::span<const u8> m_data;
+    size_t m_offset = 0;
+    bool m_ok = true;
+};
+
+} // namespace action
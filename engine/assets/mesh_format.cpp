@@ -0,0 +1,501 @@
+#include "mesh_format.h"
+#include "asset_manager.h"
+#include "core/logging.h"
+#include "core/profiler.h"
+#include "core/math/math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace action {
+
+namespace {
+
+constexpr u32 SECTION_ALIGN = 16;
+
+u32 AlignUp(u32 value) {
+    return (value + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1);
+}
+
+// Source mesh in a uniform shape, whichever representation MeshData holds
+struct SourceMesh {
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<vec2> uvs;
+    std::vector<u32> indices;
+};
+
+bool GatherSource(const MeshData& mesh, SourceMesh& out) {
+    u32 stride = GetVertexStride(mesh.vertex_format);
+    if (!mesh.vertices.empty()) {
+        out.positions.reserve(mesh.vertices.size());
+        for (const auto& v : mesh.vertices) {
+            out.positions.push_back(v.position);
+            out.normals.push_back(v.normal);
+            out.uvs.push_back(v.uv);
+        }
+    } else if (mesh.vertex_count > 0 && mesh.vertex_data.size() >= size_t(mesh.vertex_count) * stride) {
+        if (mesh.vertex_format == VertexFormat::Packed16) {
+            const auto* src = reinterpret_cast<const PackedVertex*>(mesh.vertex_data.data());
+            vec3 scale = mesh.position_scale * (1.0f / 65535.0f);
+            for (u32 i = 0; i < mesh.vertex_count; i++) {
+                const PackedVertex& v = src[i];
+                out.positions.push_back({mesh.position_offset.x + v.position[0] * scale.x,
+                                         mesh.position_offset.y + v.position[1] * scale.y,
+                                         mesh.position_offset.z + v.position[2] * scale.z});
+                out.normals.push_back(DecodeOctahedral(v.normal));
+                out.uvs.push_back({HalfToFloat(v.uv[0]), HalfToFloat(v.uv[1])});
+            }
+        } else {
+            // Runtime layout: pos(3) + normal(3) + uv(2)
+            const float* src = reinterpret_cast<const float*>(mesh.vertex_data.data());
+            for (u32 i = 0; i < mesh.vertex_count; i++, src += 8) {
+                out.positions.push_back({src[0], src[1], src[2]});
+                out.normals.push_back({src[3], src[4], src[5]});
+                out.uvs.push_back({src[6], src[7]});
+            }
+        }
+    } else {
+        return false;
+    }
+
+    if (!mesh.indices.empty()) {
+        out.indices = mesh.indices;
+    } else if (mesh.index16 && mesh.index_data.size() >= mesh.index_count * sizeof(u16)) {
+        const u16* src = reinterpret_cast<const u16*>(mesh.index_data.data());
+        out.indices.assign(src, src + mesh.index_count);
+    } else if (!mesh.index16 && mesh.index_data.size() >= mesh.index_count * sizeof(u32)) {
+        out.indices.resize(mesh.index_count);
+        std::memcpy(out.indices.data(), mesh.index_data.data(), mesh.index_count * sizeof(u32));
+    }
+
+    if (out.indices.empty() || out.indices.size() % 3 != 0) return false;
+
+    u32 vertex_count = static_cast<u32>(out.positions.size());
+    return std::all_of(out.indices.begin(), out.indices.end(), [vertex_count](u32 i) { return i < vertex_count; });
+}
+
+// Vertex clustering: snap vertices to a grid, keep triangles spanning three cells.
+// Survivors reference an existing vertex of their cell so all LODs share one vertex buffer.
+std::vector<u32> SimplifyClustered(const SourceMesh& mesh, const AABB& bounds, u32 grid) {
+    vec3 extent = bounds.max - bounds.min;
+    float cell_scale[3] = {
+        extent.x > 0 ? grid / extent.x : 0.0f,
+        extent.y > 0 ? grid / extent.y : 0.0f,
+        extent.z > 0 ? grid / extent.z : 0.0f,
+    };
+
+    std::unordered_map<u64, u32> representative;
+    std::vector<u32> remap(mesh.positions.size());
+    for (u32 i = 0; i < mesh.positions.size(); i++) {
+        vec3 p = mesh.positions[i] - bounds.min;
+        u64 cx = std::min<u64>(static_cast<u64>(p.x * cell_scale[0]), grid - 1);
+        u64 cy = std::min<u64>(static_cast<u64>(p.y * cell_scale[1]), grid - 1);
+        u64 cz = std::min<u64>(static_cast<u64>(p.z * cell_scale[2]), grid - 1);
+        u64 key = (cx << 42) | (cy << 21) | cz;
+
+        remap[i] = representative.try_emplace(key, i).first->second;
+    }
+
+    std::vector<u32> result;
+    result.reserve(mesh.indices.size() / 2);
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        u32 a = remap[mesh.indices[t]];
+        u32 b = remap[mesh.indices[t + 1]];
+        u32 c = remap[mesh.indices[t + 2]];
+        if (a == b || b == c || a == c) continue;
+
+        result.push_back(a);
+        result.push_back(b);
+        result.push_back(c);
+    }
+    return result;
+}
+
+// Quantize one vertex; inv_extent is 1 / (bounds.max - bounds.min), 0 on flat axes
+PackedVertex PackVertex(const vec3& position, const vec3& normal, const vec2& uv,
+                        const vec3& bounds_min, const vec3& inv_extent) {
+    PackedVertex packed;
+    vec3 p = position - bounds_min;
+    float n[3] = {p.x * inv_extent.x, p.y * inv_extent.y, p.z * inv_extent.z};
+    for (int c = 0; c < 3; c++) {
+        packed.position[c] = static_cast<u16>(std::lround(std::clamp(n[c], 0.0f, 1.0f) * 65535.0f));
+    }
+    packed.pad = 0;
+    EncodeOctahedral(normal, packed.normal);
+    packed.uv[0] = FloatToHalf(uv.x);
+    packed.uv[1] = FloatToHalf(uv.y);
+    return packed;
+}
+
+vec3 InverseExtent(const vec3& extent) {
+    return {
+        extent.x > 0 ? 1.0f / extent.x : 0.0f,
+        extent.y > 0 ? 1.0f / extent.y : 0.0f,
+        extent.z > 0 ? 1.0f / extent.z : 0.0f,
+    };
+}
+
+template<typename T>
+void Append(std::vector<u8>& out, u32 offset, const T* data, size_t count) {
+    std::memcpy(out.data() + offset, data, count * sizeof(T));
+}
+
+} // namespace
+
+u16 FloatToHalf(float value) {
+    u32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    u32 sign = (bits >> 16) & 0x8000;
+    u32 exponent = (bits >> 23) & 0xFF;
+    u32 mantissa = bits & 0x7FFFFF;
+
+    if (exponent == 0xFF) {
+        return static_cast<u16>(sign | 0x7C00 | (mantissa ? 0x200 : 0));  // Inf/NaN
+    }
+
+    i32 half_exponent = static_cast<i32>(exponent) - 127 + 15;
+    if (half_exponent >= 31) {
+        return static_cast<u16>(sign | 0x7C00);  // Overflow to infinity
+    }
+
+    if (half_exponent <= 0) {
+        // Subnormal half (or zero)
+        if (half_exponent < -10) return static_cast<u16>(sign);
+        mantissa |= 0x800000;
+        u32 shift = static_cast<u32>(14 - half_exponent);
+        u32 half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1) half++;  // Round to nearest
+        return static_cast<u16>(sign | half);
+    }
+
+    // Rounding may carry into the exponent, which is the correct result
+    u32 half = sign | (static_cast<u32>(half_exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) half++;
+    return static_cast<u16>(half);
+}
+
+float HalfToFloat(u16 value) {
+    u32 sign = static_cast<u32>(value & 0x8000) << 16;
+    u32 exponent = (value >> 10) & 0x1F;
+    u32 mantissa = value & 0x3FF;
+
+    if (exponent == 0) {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    u32 bits = exponent == 31
+        ? sign | 0x7F800000 | (mantissa << 13)
+        : sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void EncodeOctahedral(const vec3& normal, i16 out[2]) {
+    float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1 <= 0.0f) {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+
+    float x = normal.x / l1;
+    float y = normal.y / l1;
+
+    // Fold the lower hemisphere over the diagonals
+    if (normal.z < 0.0f) {
+        float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+
+    out[0] = static_cast<i16>(std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+    out[1] = static_cast<i16>(std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+}
+
+vec3 DecodeOctahedral(const i16 encoded[2]) {
+    float x = std::max(encoded[0] / 32767.0f, -1.0f);
+    float y = std::max(encoded[1] / 32767.0f, -1.0f);
+    float z = 1.0f - std::abs(x) - std::abs(y);
+
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    float length = std::sqrt(x * x + y * y + z * z);
+    float inv = length > 0.0f ? 1.0f / length : 0.0f;
+    return {x * inv, y * inv, z * inv};
+}
+
+bool CookedMeshView::Open(std::span<const u8> bytes) {
+    m_header = nullptr;
+    if (bytes.size() < sizeof(CookedMeshHeader)) return false;
+
+    const auto* header = reinterpret_cast<const CookedMeshHeader*>(bytes.data());
+    if (header->magic != COOKED_MESH_MAGIC || header->version != COOKED_MESH_VERSION) return false;
+    if (header->file_size != bytes.size()) return false;
+
+    size_t index_size = (header->flags & COOKED_MESH_INDEX16) ? sizeof(u16) : sizeof(u32);
+    size_t lods_end = header->lods_offset + size_t(header->lod_count) * sizeof(CookedMeshLOD);
+    size_t vertices_end = header->vertices_offset + size_t(header->vertex_count) * sizeof(PackedVertex);
+    size_t indices_end = header->indices_offset + size_t(header->index_count) * index_size;
+    if (lods_end > bytes.size() || vertices_end > bytes.size() || indices_end > bytes.size()) return false;
+    if (header->lod_count == 0) return false;
+
+    const auto* lods = reinterpret_cast<const CookedMeshLOD*>(bytes.data() + header->lods_offset);
+    for (u32 i = 0; i < header->lod_count; i++) {
+        if (size_t(lods[i].first_index) + lods[i].index_count > header->index_count) return false;
+    }
+
+    m_header = header;
+    m_lods = {lods, header->lod_count};
+    m_vertices = {reinterpret_cast<const PackedVertex*>(bytes.data() + header->vertices_offset), header->vertex_count};
+    m_indices = bytes.data() + header->indices_offset;
+    return true;
+}
+
+size_t CookedMeshView::GetIndexDataSize() const {
+    return size_t(m_header->index_count) * (HasIndex16() ? sizeof(u16) : sizeof(u32));
+}
+
+AABB CookedMeshView::GetBounds() const {
+    return AABB(
+        vec3{m_header->bounds_min[0], m_header->bounds_min[1], m_header->bounds_min[2]},
+        vec3{m_header->bounds_max[0], m_header->bounds_max[1], m_header->bounds_max[2]});
+}
+
+bool CookMesh(const MeshData& mesh, const MeshCookSettings& settings, std::vector<u8>& out_bytes) {
+    PROFILE_SCOPE("CookMesh");
+
+    SourceMesh source;
+    if (!GatherSource(mesh, source)) {
+        LOG_ERROR("CookMesh: {} has no usable vertex/index data", mesh.name);
+        return false;
+    }
+
+    AABB bounds;
+    for (const auto& p : source.positions) {
+        bounds.expand(p);
+    }
+
+    // LOD chain: LOD0 is the source triangle list, coarser LODs reuse its vertices
+    std::vector<std::vector<u32>> lod_indices;
+    std::vector<float> lod_ratios;
+    lod_indices.push_back(source.indices);
+    lod_ratios.push_back(1.0f);
+
+    size_t base_triangles = source.indices.size() / 3;
+    for (float ratio : settings.lod_ratios) {
+        size_t target = static_cast<size_t>(base_triangles * ratio);
+        if (target < settings.min_lod_triangles) break;
+
+        // Coarsen the grid until the target is met
+        std::vector<u32> simplified;
+        for (u32 grid = 256; grid >= 2; grid /= 2) {
+            simplified = SimplifyClustered(source, bounds, grid);
+            if (simplified.size() / 3 <= target) break;
+        }
+
+        size_t triangles = simplified.size() / 3;
+        if (triangles < settings.min_lod_triangles) break;
+        if (triangles >= lod_indices.back().size() / 3) continue;  // No reduction
+
+        lod_ratios.push_back(static_cast<float>(triangles) / base_triangles);
+        lod_indices.push_back(std::move(simplified));
+    }
+
+    // Encode vertices
+    vec3 inv_extent = InverseExtent(bounds.max - bounds.min);
+    std::vector<PackedVertex> vertices(source.positions.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        vertices[i] = PackVertex(source.positions[i], source.normals[i], source.uvs[i], bounds.min, inv_extent);
+    }
+
+    // Layout
+    u32 vertex_count = static_cast<u32>(vertices.size());
+    u32 lod_count = static_cast<u32>(lod_indices.size());
+    u32 index_count = 0;
+    std::vector<CookedMeshLOD> lods(lod_count);
+    for (u32 i = 0; i < lod_count; i++) {
+        lods[i] = {index_count, static_cast<u32>(lod_indices[i].size()), lod_ratios[i], 0.0f};
+        index_count += lods[i].index_count;
+    }
+
+    bool index16 = vertex_count <= 65536;
+    size_t index_size = index16 ? sizeof(u16) : sizeof(u32);
+
+    CookedMeshHeader header{};
+    header.magic = COOKED_MESH_MAGIC;
+    header.version = COOKED_MESH_VERSION;
+    header.flags = index16 ? COOKED_MESH_INDEX16 : 0;
+    header.vertex_count = vertex_count;
+    header.index_count = index_count;
+    header.lod_count = lod_count;
+    header.lods_offset = AlignUp(sizeof(CookedMeshHeader));
+    header.vertices_offset = AlignUp(header.lods_offset + lod_count * sizeof(CookedMeshLOD));
+    header.indices_offset = AlignUp(header.vertices_offset + vertex_count * sizeof(PackedVertex));
+    header.file_size = AlignUp(static_cast<u32>(header.indices_offset + index_count * index_size));
+    header.bounds_min[0] = bounds.min.x;
+    header.bounds_min[1] = bounds.min.y;
+    header.bounds_min[2] = bounds.min.z;
+    header.bounds_max[0] = bounds.max.x;
+    header.bounds_max[1] = bounds.max.y;
+    header.bounds_max[2] = bounds.max.z;
+
+    out_bytes.assign(header.file_size, 0);
+    Append(out_bytes, 0, &header, 1);
+    Append(out_bytes, header.lods_offset, lods.data(), lods.size());
+    Append(out_bytes, header.vertices_offset, vertices.data(), vertices.size());
+
+    u32 offset = header.indices_offset;
+    for (const auto& indices : lod_indices) {
+        if (index16) {
+            std::vector<u16> narrow(indices.begin(), indices.end());
+            Append(out_bytes, offset, narrow.data(), narrow.size());
+        } else {
+            Append(out_bytes, offset, indices.data(), indices.size());
+        }
+        offset += static_cast<u32>(indices.size() * index_size);
+    }
+
+    return true;
+}
+
+bool WriteCookedMesh(const std::string& path, const MeshData& mesh, const MeshCookSettings& settings) {
+    std::vector<u8> bytes;
+    if (!CookMesh(mesh, settings, bytes)) return false;
+
+    return WriteCookedMeshBytes(path, bytes);
+}
+
+bool WriteCookedMeshBytes(const std::string& path, std::span<const u8> bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("Failed to open {} for writing", path);
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        LOG_ERROR("Failed to write cooked mesh {}", path);
+        return false;
+    }
+
+    return true;
+}
+
+void ExpandCookedMesh(const CookedMeshView& view, MeshData& out_data, VertexFormat format) {
+    PROFILE_SCOPE("ExpandCookedMesh");
+
+    const CookedMeshHeader& header = view.GetHeader();
+    AABB bounds = view.GetBounds();
+    auto vertices = view.GetVertices();
+    out_data.vertex_count = header.vertex_count;
+
+    if (format == VertexFormat::Packed16) {
+        // Already in the GPU layout: straight copies out of the mapping
+        out_data.vertex_data.resize(vertices.size_bytes());
+        std::memcpy(out_data.vertex_data.data(), vertices.data(), vertices.size_bytes());
+        out_data.vertex_format = VertexFormat::Packed16;
+        out_data.position_offset = bounds.min;
+        out_data.position_scale = bounds.max - bounds.min;
+
+        out_data.index_data.resize(view.GetIndexDataSize());
+        std::memcpy(out_data.index_data.data(), view.GetIndexData(), out_data.index_data.size());
+        out_data.index16 = view.HasIndex16();
+    } else {
+        // Single linear pass over the mapping
+        vec3 scale = (bounds.max - bounds.min) * (1.0f / 65535.0f);
+        out_data.vertex_data.resize(size_t(header.vertex_count) * sizeof(float) * 8);
+        float* dst = reinterpret_cast<float*>(out_data.vertex_data.data());
+        for (const PackedVertex& v : vertices) {
+            vec3 n = DecodeOctahedral(v.normal);
+            *dst++ = bounds.min.x + v.position[0] * scale.x;
+            *dst++ = bounds.min.y + v.position[1] * scale.y;
+            *dst++ = bounds.min.z + v.position[2] * scale.z;
+            *dst++ = n.x;
+            *dst++ = n.y;
+            *dst++ = n.z;
+            *dst++ = HalfToFloat(v.uv[0]);
+            *dst++ = HalfToFloat(v.uv[1]);
+        }
+        out_data.vertex_format = VertexFormat::Float32;
+        out_data.position_offset = {0, 0, 0};
+        out_data.position_scale = {1, 1, 1};
+
+        out_data.index_data.resize(size_t(header.index_count) * sizeof(u32));
+        if (view.HasIndex16()) {
+            const u16* src = static_cast<const u16*>(view.GetIndexData());
+            u32* indices = reinterpret_cast<u32*>(out_data.index_data.data());
+            std::copy(src, src + header.index_count, indices);
+        } else {
+            std::memcpy(out_data.index_data.data(), view.GetIndexData(), out_data.index_data.size());
+        }
+        out_data.index16 = false;
+    }
+
+    // LOD0 comes first so index_count draws it
+    auto lods = view.GetLODs();
+    out_data.lods.clear();
+    for (const auto& lod : lods) {
+        out_data.lods.push_back({lod.first_index, lod.index_count});
+    }
+
+    out_data.index_count = lods[0].index_count;
+    out_data.triangle_count = out_data.index_count / 3;
+    out_data.bounds = bounds;
+}
+
+void CompressMeshData(MeshData& mesh, VertexFormat format, bool index16) {
+    PROFILE_SCOPE("CompressMeshData");
+
+    size_t float_size = size_t(mesh.vertex_count) * sizeof(float) * 8;
+    if (format == VertexFormat::Packed16 && mesh.vertex_format == VertexFormat::Float32 &&
+        mesh.vertex_count > 0 && mesh.vertex_data.size() >= float_size) {
+        const float* src = reinterpret_cast<const float*>(mesh.vertex_data.data());
+
+        // Quantize against the exact position bounds (mesh.bounds may be padded or unset)
+        AABB box;
+        for (u32 i = 0; i < mesh.vertex_count; i++) {
+            box.expand(vec3{src[i * 8 + 0], src[i * 8 + 1], src[i * 8 + 2]});
+        }
+        vec3 extent = box.max - box.min;
+        vec3 inv_extent = InverseExtent(extent);
+
+        std::vector<u8> packed(size_t(mesh.vertex_count) * sizeof(PackedVertex));
+        auto* dst = reinterpret_cast<PackedVertex*>(packed.data());
+        for (u32 i = 0; i < mesh.vertex_count; i++, src += 8) {
+            dst[i] = PackVertex({src[0], src[1], src[2]}, {src[3], src[4], src[5]}, {src[6], src[7]},
+                                box.min, inv_extent);
+        }
+
+        mesh.vertex_data.swap(packed);
+        mesh.vertex_format = VertexFormat::Packed16;
+        mesh.position_offset = box.min;
+        mesh.position_scale = extent;
+    }
+
+    // index_data may hold more than index_count (LOD chains): convert all of it
+    if (index16 && !mesh.index16 && mesh.vertex_count <= 65536 && mesh.index_data.size() % sizeof(u32) == 0) {
+        size_t count = mesh.index_data.size() / sizeof(u32);
+        const u32* src = reinterpret_cast<const u32*>(mesh.index_data.data());
+
+        std::vector<u8> narrow(count * sizeof(u16));
+        u16* dst = reinterpret_cast<u16*>(narrow.data());
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = static_cast<u16>(src[i]);
+        }
+
+        mesh.index_data.swap(narrow);
+        mesh.index16 = true;
+    }
+}
+
+} // namespace action
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "core/types.h"
+#include <span>
+#include <string>
+#include <vector>
+
+namespace action {
+
+struct MeshData;
+
+/*
+ * Cooked Mesh Format (.mesh)
+ *
+ * Engine-native mesh written at import time, loaded without parsing:
+ * the header is validated and every section is used in place.
+ *
+ * Layout (little-endian, sections 16-byte aligned):
+ * - CookedMeshHeader
+ * - CookedMeshLOD[lod_count]     index ranges, LOD0 first
+ * - PackedVertex[vertex_count]   16 bytes per vertex
+ * - u16 or u32 indices           all LODs back to back, shared vertices
+ *
+ * Vertex encoding:
+ * - Position: unorm16 x3 relative to the mesh bounds
+ * - Normal: octahedral snorm16 x2
+ * - UV: half-float x2
+ */
+
+constexpr u32 COOKED_MESH_MAGIC = 0x48534D41;  // "AMSH"
+constexpr u16 COOKED_MESH_VERSION = 1;
+
+enum CookedMeshFlags : u16 {
+    COOKED_MESH_INDEX16 = 1 << 0,  // Indices are u16 (vertex_count <= 65536)
+};
+
+struct CookedMeshHeader {
+    u32 magic;
+    u16 version;
+    u16 flags;
+    u32 vertex_count;
+    u32 index_count;       // All LODs
+    u32 lod_count;
+    u32 lods_offset;
+    u32 vertices_offset;
+    u32 indices_offset;
+    float bounds_min[3];
+    float bounds_max[3];
+    u32 file_size;
+    u32 reserved[5];
+};
+static_assert(sizeof(CookedMeshHeader) == 80);
+
+struct CookedMeshLOD {
+    u32 first_index;
+    u32 index_count;
+    float triangle_ratio;  // Triangles relative to LOD0
+    float reserved;
+};
+static_assert(sizeof(CookedMeshLOD) == 16);
+
+struct PackedVertex {
+    u16 position[3];  // unorm16 within the mesh bounds
+    u16 pad;
+    i16 normal[2];    // Octahedral
+    u16 uv[2];        // Half-float
+};
+static_assert(sizeof(PackedVertex) == 16);
+
+// Runtime vertex layouts (MeshData::vertex_data, GPU vertex buffers)
+enum class VertexFormat : u8 {
+    Float32,   // pos(3) + normal(3) + uv(2) floats, 32 bytes
+    Packed16,  // PackedVertex, 16 bytes; positions dequantized by the model matrix
+};
+
+inline u32 GetVertexStride(VertexFormat format) {
+    return format == VertexFormat::Packed16 ? sizeof(PackedVertex) : sizeof(float) * 8;
+}
+
+struct MeshCookSettings {
+    // Target triangle ratios for LOD1..n (matches LODConfig: 50/25/10/5%)
+    std::vector<float> lod_ratios = {0.5f, 0.25f, 0.1f, 0.05f};
+    u32 min_lod_triangles = 32;  // Stop the chain below this
+};
+
+// Zero-copy view over a cooked mesh (file mapping or memory buffer)
+class CookedMeshView {
+public:
+    // Validates header and section bounds; no data is copied
+    bool Open(std::span<const u8> bytes);
+
+    const CookedMeshHeader& GetHeader() const { return *m_header; }
+    std::span<const CookedMeshLOD> GetLODs() const { return m_lods; }
+    std::span<const PackedVertex> GetVertices() const { return m_vertices; }
+    bool HasIndex16() const { return (m_header->flags & COOKED_MESH_INDEX16) != 0; }
+    const void* GetIndexData() const { return m_indices; }
+    size_t GetIndexDataSize() const;
+    AABB GetBounds() const;
+
+private:
+    const CookedMeshHeader* m_header = nullptr;
+    std::span<const CookedMeshLOD> m_lods;
+    std::span<const PackedVertex> m_vertices;
+    const void* m_indices = nullptr;
+};
+
+// Encode a mesh (vertices/indices or vertex_data in either layout) into the cooked format
+bool CookMesh(const MeshData& mesh, const MeshCookSettings& settings, std::vector<u8>& out_bytes);
+bool WriteCookedMesh(const std::string& path, const MeshData& mesh, const MeshCookSettings& settings = {});
+bool WriteCookedMeshBytes(const std::string& path, std::span<const u8> bytes);  // Already cooked
+
+// Expand into a runtime vertex layout. Packed16 copies the vertices and
+// indices as stored; Float32 decodes them (u32 indices).
+void ExpandCookedMesh(const CookedMeshView& view, MeshData& out_data,
+                      VertexFormat format = VertexFormat::Float32);
+
+// Re-encode Float32 vertex_data into format and narrow indices to u16 when
+// index16 is set and every vertex is addressable. No-op if already converted.
+void CompressMeshData(MeshData& mesh, VertexFormat format, bool index16);
+
+// Vertex encoding helpers
+u16 FloatToHalf(float value);
+float HalfToFloat(u16 value);
+void EncodeOctahedral(const vec3& normal, i16 out[2]);
+vec3 DecodeOctahedral(const i16 encoded[2]);
+
+} // namespace action
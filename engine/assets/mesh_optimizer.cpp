@@ -0,0 +1,352 @@
+#include "mesh_optimizer.h"
+#include "core/profiler.h"
+#include "core/math/math.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace action {
+
+namespace {
+
+// Attribute values of a vertex (vec3 padding excluded so equal vertices compare equal)
+struct VertexKey {
+    float values[14];
+
+    bool operator==(const VertexKey& o) const {
+        return std::memcmp(values, o.values, sizeof(values)) == 0;
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        // FNV-1a over the raw float bits
+        u64 hash = 14695981039346656037ull;
+        const u8* bytes = reinterpret_cast<const u8*>(key.values);
+        for (size_t i = 0; i < sizeof(key.values); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+VertexKey MakeKey(const Vertex& v) {
+    return {{v.position.x, v.position.y, v.position.z,
+             v.normal.x, v.normal.y, v.normal.z,
+             v.uv.x, v.uv.y,
+             v.color.x, v.color.y, v.color.z,
+             v.tangent.x, v.tangent.y, v.tangent.z}};
+}
+
+} // namespace
+
+float ComputeACMR(std::span<const u32> indices, u32 vertex_count, u32 cache_size) {
+    if (indices.size() < 3) return 0.0f;
+
+    // FIFO: a vertex is cached while fewer than cache_size misses happened since it was loaded
+    std::vector<u32> load_time(vertex_count, 0);
+    u32 time = cache_size + 1;
+    u32 misses = 0;
+
+    for (u32 v : indices) {
+        if (time - load_time[v] > cache_size) {
+            load_time[v] = time++;
+            misses++;
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+void OptimizeVertexCache(std::vector<u32>& indices, u32 vertex_count, u32 cache_size,
+                         std::vector<u32>* out_clusters) {
+    PROFILE_SCOPE("OptimizeVertexCache");
+
+    u32 triangle_count = static_cast<u32>(indices.size() / 3);
+    if (triangle_count == 0) return;
+
+    // Vertex -> triangle adjacency (CSR)
+    std::vector<u32> live(vertex_count, 0);
+    for (u32 v : indices) {
+        live[v]++;
+    }
+
+    std::vector<u32> offsets(vertex_count + 1, 0);
+    for (u32 v = 0; v < vertex_count; v++) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+
+    std::vector<u32> adjacency(indices.size());
+    std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+    for (u32 t = 0; t < triangle_count; t++) {
+        for (u32 k = 0; k < 3; k++) {
+            adjacency[fill[indices[t * 3 + k]]++] = t;
+        }
+    }
+
+    // Tipsify: fan around the current vertex, then move to the candidate that
+    // will still be in the cache after its own fan is emitted
+    std::vector<u32> cache_time(vertex_count, 0);
+    std::vector<u8> emitted(triangle_count, 0);
+    std::vector<u32> dead_end;
+    std::vector<u32> candidates;
+    std::vector<u32> result;
+    dead_end.reserve(indices.size());
+    result.reserve(indices.size());
+
+    u32 time = cache_size + 1;
+    u32 cursor = 0;
+    i64 fan = 0;
+    bool boundary = true;
+
+    while (fan >= 0) {
+        candidates.clear();
+
+        for (u32 a = offsets[fan]; a < offsets[fan + 1]; a++) {
+            u32 t = adjacency[a];
+            if (emitted[t]) continue;
+
+            if (boundary && out_clusters) {
+                out_clusters->push_back(static_cast<u32>(result.size() / 3));
+            }
+            boundary = false;
+
+            for (u32 k = 0; k < 3; k++) {
+                u32 v = indices[t * 3 + k];
+                result.push_back(v);
+                dead_end.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+
+                if (time - cache_time[v] > cache_size) {
+                    cache_time[v] = time++;
+                }
+            }
+            emitted[t] = 1;
+        }
+
+        // Oldest candidate that survives its own fan; otherwise a dead end
+        fan = -1;
+        i64 best_priority = -1;
+        for (u32 v : candidates) {
+            if (live[v] == 0) continue;
+
+            i64 priority = 0;
+            if (time - cache_time[v] + 2 * live[v] <= cache_size) {
+                priority = time - cache_time[v];
+            }
+            if (priority > best_priority) {
+                best_priority = priority;
+                fan = v;
+            }
+        }
+
+        if (fan >= 0) continue;
+
+        // Dead end: most recently used vertex that still has triangles, else scan forward
+        boundary = true;
+        while (!dead_end.empty()) {
+            u32 v = dead_end.back();
+            dead_end.pop_back();
+            if (live[v] > 0) {
+                fan = v;
+                break;
+            }
+        }
+
+        while (fan < 0 && cursor < vertex_count) {
+            if (live[cursor] > 0) {
+                fan = cursor;
+            }
+            cursor++;
+        }
+    }
+
+    indices.swap(result);
+}
+
+void OptimizeOverdraw(std::vector<u32>& indices, std::span<const Vertex> vertices,
+                      std::span<const u32> hard_clusters, u32 cache_size, float threshold) {
+    PROFILE_SCOPE("OptimizeOverdraw");
+
+    u32 triangle_count = static_cast<u32>(indices.size() / 3);
+    if (triangle_count == 0 || hard_clusters.empty()) return;
+
+    u32 vertex_count = static_cast<u32>(vertices.size());
+    float split_acmr = ComputeACMR(indices, vertex_count, cache_size) * threshold;
+
+    // Soft boundaries: simulate the cache from cold at every cluster start and
+    // allow a split once the cluster has paid off its warm-up misses
+    std::vector<u32> clusters;
+    std::vector<u32> load_time(vertex_count, 0);
+    u32 time = cache_size + 1;
+    u32 cluster_misses = 0;
+    u32 cluster_start = 0;
+    size_t next_hard = 0;
+
+    for (u32 t = 0; t < triangle_count; t++) {
+        bool hard = next_hard < hard_clusters.size() && hard_clusters[next_hard] == t;
+        if (hard) next_hard++;
+
+        if (t == 0 || hard) {
+            clusters.push_back(t);
+            cluster_start = t;
+            cluster_misses = 0;
+            time += cache_size + 1;  // Flush
+        }
+
+        for (u32 k = 0; k < 3; k++) {
+            u32 v = indices[t * 3 + k];
+            if (time - load_time[v] > cache_size) {
+                load_time[v] = time++;
+                cluster_misses++;
+            }
+        }
+
+        u32 cluster_triangles = t - cluster_start + 1;
+        if (t + 1 < triangle_count && cluster_misses <= split_acmr * cluster_triangles) {
+            clusters.push_back(t + 1);
+            cluster_start = t + 1;
+            cluster_misses = 0;
+            time += cache_size + 1;
+        }
+    }
+
+    // Dedupe: a soft split may land on a hard boundary
+    clusters.erase(std::unique(clusters.begin(), clusters.end()), clusters.end());
+    if (clusters.size() < 2) return;
+
+    // Mesh centroid
+    vec3 mesh_center{0, 0, 0};
+    for (const auto& v : vertices) {
+        mesh_center = mesh_center + v.position;
+    }
+    mesh_center = mesh_center * (1.0f / vertex_count);
+
+    // Sort key: how far the cluster faces away from the center (occluders first)
+    struct ClusterSort {
+        float key;
+        u32 begin;
+        u32 end;
+    };
+    std::vector<ClusterSort> order(clusters.size());
+
+    for (size_t c = 0; c < clusters.size(); c++) {
+        u32 begin = clusters[c];
+        u32 end = c + 1 < clusters.size() ? clusters[c + 1] : triangle_count;
+
+        vec3 center{0, 0, 0};
+        vec3 normal{0, 0, 0};
+        float area = 0.0f;
+        for (u32 t = begin; t < end; t++) {
+            const vec3& a = vertices[indices[t * 3 + 0]].position;
+            const vec3& b = vertices[indices[t * 3 + 1]].position;
+            const vec3& d = vertices[indices[t * 3 + 2]].position;
+
+            vec3 n = cross(b - a, d - a);  // Length = 2 * area
+            float weight = length(n);
+            center = center + (a + b + d) * (weight / 3.0f);
+            normal = normal + n;
+            area += weight;
+        }
+
+        float key = 0.0f;
+        if (area > 0.0f) {
+            center = center * (1.0f / area);
+            float normal_length = length(normal);
+            if (normal_length > 0.0f) {
+                key = dot(center - mesh_center, normal * (1.0f / normal_length));
+            }
+        }
+        order[c] = {key, begin, end};
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](const ClusterSort& a, const ClusterSort& b) {
+        return a.key > b.key;
+    });
+
+    std::vector<u32> result;
+    result.reserve(indices.size());
+    for (const auto& cluster : order) {
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+    indices.swap(result);
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<u32>& indices) {
+    PROFILE_SCOPE("OptimizeVertexFetch");
+
+    std::vector<u32> remap(vertices.size(), UINT32_MAX);
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+
+    for (u32& index : indices) {
+        if (remap[index] == UINT32_MAX) {
+            remap[index] = static_cast<u32>(result.size());
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(result);
+}
+
+void WeldVertices(std::vector<Vertex>& vertices, std::vector<u32>& indices) {
+    PROFILE_SCOPE("WeldVertices");
+
+    std::unordered_map<VertexKey, u32, VertexKeyHash> unique;
+    unique.reserve(vertices.size());
+
+    std::vector<u32> remap(vertices.size());
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        auto [it, inserted] = unique.try_emplace(MakeKey(vertices[i]), static_cast<u32>(result.size()));
+        if (inserted) {
+            result.push_back(vertices[i]);
+        }
+        remap[i] = it->second;
+    }
+
+    for (u32& index : indices) {
+        index = remap[index];
+    }
+    vertices.swap(result);
+}
+
+MeshOptimizeStats OptimizeMesh(std::vector<Vertex>& vertices, std::vector<u32>& indices,
+                               const MeshOptimizeSettings& settings) {
+    PROFILE_SCOPE("OptimizeMesh");
+
+    MeshOptimizeStats stats;
+    stats.vertices_before = static_cast<u32>(vertices.size());
+
+    // Left untouched (and unmeasured: ComputeACMR indexes per vertex) if malformed
+    bool valid = indices.size() % 3 == 0 && std::all_of(indices.begin(), indices.end(),
+        [&](u32 i) { return i < vertices.size(); });
+    if (!valid || indices.empty()) {
+        stats.vertices_after = stats.vertices_before;
+        return stats;
+    }
+    stats.acmr_before = ComputeACMR(indices, stats.vertices_before);
+
+    WeldVertices(vertices, indices);
+
+    u32 vertex_count = static_cast<u32>(vertices.size());
+    std::vector<u32> clusters;
+    OptimizeVertexCache(indices, vertex_count, settings.cache_size,
+                        settings.optimize_overdraw ? &clusters : nullptr);
+
+    if (settings.optimize_overdraw) {
+        OptimizeOverdraw(indices, vertices, clusters, settings.cache_size, settings.overdraw_threshold);
+    }
+
+    OptimizeVertexFetch(vertices, indices);
+
+    stats.vertices_after = static_cast<u32>(vertices.size());
+    stats.acmr_after = ComputeACMR(indices, stats.vertices_after);
+    return stats;
+}
+
+} // namespace action
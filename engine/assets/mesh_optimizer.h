@@ -0,0 +1,57 @@
+#pragma once
+
+#include "core/types.h"
+#include <span>
+#include <vector>
+
+namespace action {
+
+/*
+ * Mesh Optimizer - Import-time index/vertex reordering
+ *
+ * Pipeline (OptimizeMesh):
+ * 1. Weld identical vertices (importers emit one vertex per corner)
+ * 2. Vertex cache order: Tipsify (Sander et al. 2007), linear time
+ * 3. Overdraw order: Tipsify clusters sorted outside-in by facing
+ * 4. Vertex fetch order: vertices renumbered in first-use order
+ *
+ * All functions are pure and thread-safe; callers parallelize across meshes.
+ */
+
+struct MeshOptimizeSettings {
+    u32 cache_size = 16;            // Tipsify target cache (post-transform cache entries)
+    bool optimize_overdraw = true;
+    float overdraw_threshold = 1.05f;  // Clusters may end once their ACMR <= this * mesh ACMR
+};
+
+struct MeshOptimizeStats {
+    float acmr_before = 0;  // Average cache miss ratio (misses per triangle, 32-entry FIFO)
+    float acmr_after = 0;
+    u32 vertices_before = 0;
+    u32 vertices_after = 0;
+};
+
+// Simulated FIFO post-transform cache; 0.5 is ideal for regular grids, 3.0 is worst
+float ComputeACMR(std::span<const u32> indices, u32 vertex_count, u32 cache_size = 32);
+
+// Reorders triangles for the post-transform cache. Fills out_clusters with the
+// first triangle after each Tipsify dead end (hard cluster boundaries).
+void OptimizeVertexCache(std::vector<u32>& indices, u32 vertex_count, u32 cache_size,
+                         std::vector<u32>* out_clusters = nullptr);
+
+// Splits clusters where the cache has warmed up (ACMR <= threshold * mesh ACMR),
+// then reorders them so outward-facing clusters draw first
+void OptimizeOverdraw(std::vector<u32>& indices, std::span<const Vertex> vertices,
+                      std::span<const u32> hard_clusters, u32 cache_size, float threshold);
+
+// Renumbers vertices in first-use order and drops unreferenced ones
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+// Merges vertices whose attributes are exactly equal
+void WeldVertices(std::vector<Vertex>& vertices, std::vector<u32>& indices);
+
+// Full pipeline
+MeshOptimizeStats OptimizeMesh(std::vector<Vertex>& vertices, std::vector<u32>& indices,
+                               const MeshOptimizeSettings& settings = {});
+
+} // namespace action
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../types.h"
+#include <vector>
+
+namespace action {
+
+/*
+ * Handle Pool - Generational slot allocator for Handle<T>
+ *
+ * Properties:
+ * - O(1) allocate, free and validate
+ * - Freed slots are reused; the generation bump makes old handles stale
+ * - Index 0 is never handed out (zero index means "no asset" to older code)
+ *
+ * The pool only tracks slot liveness. Owners keep their data in plain
+ * arrays indexed by handle.index and sized to Capacity(), which lets hot
+ * and cold fields of the same asset live in separate arrays.
+ */
+
+template<typename T>
+class HandlePool {
+public:
+    HandlePool() { Clear(); }
+
+    Handle<T> Allocate() {
+        u32 index;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            index = static_cast<u32>(m_generations.size());
+            m_generations.push_back(1);
+            m_alive.push_back(0);
+        }
+
+        m_alive[index] = 1;
+        ++m_size;
+        return {index, m_generations[index]};
+    }
+
+    void Free(Handle<T> handle) {
+        if (!IsValid(handle)) return;
+
+        // Generation 0 is reserved for default-constructed handles
+        u32& generation = m_generations[handle.index];
+        generation = generation + 1 == 0 ? 1 : generation + 1;
+
+        m_alive[handle.index] = 0;
+        m_free.push_back(handle.index);
+        --m_size;
+    }
+
+    bool IsValid(Handle<T> handle) const {
+        return handle.index < m_generations.size() &&
+               m_alive[handle.index] &&
+               m_generations[handle.index] == handle.generation;
+    }
+
+    bool IsAlive(u32 index) const { return index < m_alive.size() && m_alive[index]; }
+
+    // Current handle for a live slot
+    Handle<T> GetHandle(u32 index) const { return {index, m_generations[index]}; }
+
+    // Highest slot index + 1 (parallel arrays are sized to this)
+    u32 Capacity() const { return static_cast<u32>(m_generations.size()); }
+    u32 Size() const { return m_size; }
+
+    void Clear() {
+        m_generations.assign(1, 0);  // Slot 0 reserved
+        m_alive.assign(1, 0);
+        m_free.clear();
+        m_size = 0;
+    }
+
+private:
+    std::vector<u32> m_generations;
+    std::vector<u8> m_alive;
+    std::vector<u32> m_free;
+    u32 m_size = 0;
+};
+
+} // namespace action
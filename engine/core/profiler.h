@@ -1,6 +1,7 @@
 #pragma once
 
 #include "types.h"
+#include <atomic>
 #include <chrono>
 #include <cfloat>
 #include <string>
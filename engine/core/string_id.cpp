@@ -0,0 +1,133 @@
+#include "string_id.h"
+#include "logging.h"
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace action {
+
+namespace {
+
+// Striped by hash so concurrent interning (loader threads) rarely shares a lock
+constexpr u32 STRING_TABLE_SHARDS = 16;  // Power of two
+
+struct StringTableShard {
+    std::shared_mutex mutex;
+    std::unordered_map<u64, std::string_view> strings;
+    std::deque<std::string> storage;  // Never moves its elements: the views stay valid
+};
+
+struct StringTable {
+    std::array<StringTableShard, STRING_TABLE_SHARDS> shards;
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> bytes{0};
+    
+    StringTableShard& GetShard(u64 hash) {
+        return shards[(hash >> 32) & (STRING_TABLE_SHARDS - 1)];
+    }
+};
+
+// Never destroyed: IDs may be looked up from static destructors
+StringTable& GetStringTable() {
+    static StringTable* table = new StringTable();
+    return *table;
+}
+
+} // namespace
+
+StringID StringID::Intern(std::string_view str) {
+    StringID id(str);
+    if (!id.IsValid()) return id;
+    
+    StringTable& table = GetStringTable();
+    StringTableShard& shard = table.GetShard(id.m_hash);
+    {
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.strings.find(id.m_hash);
+        if (it != shard.strings.end()) {
+            if (it->second != str) {
+                LOG_WARN("StringID collision: \"{}\" and \"{}\" (0x{:016x})", it->second, str, id.m_hash);
+            }
+            return id;
+        }
+    }
+    
+    std::unique_lock lock(shard.mutex);
+    auto [it, inserted] = shard.strings.try_emplace(id.m_hash);
+    if (inserted) {
+        it->second = shard.storage.emplace_back(str);
+        table.count.fetch_add(1, std::memory_order_relaxed);
+        table.bytes.fetch_add(str.size(), std::memory_order_relaxed);
+    }
+    return id;
+}
+
+std::string_view StringID::GetString() const {
+    if (!IsValid()) return {};
+    
+    StringTableShard& shard = GetStringTable().GetShard(m_hash);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.strings.find(m_hash);
+    return it != shard.strings.end() ? it->second : std::string_view{};
+}
+
+std::string StringID::ToHex() const {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(m_hash));
+    return buffer;
+}
+
+StringID StringID::FromHex(std::string_view hex) {
+    if (hex.empty() || hex.size() > 16) return {};
+    
+    u64 hash = 0;
+    for (char c : hex) {
+        u64 digit;
+        if (c >= '0' && c <= '9') digit = static_cast<u64>(c - '0');
+        else if (c >= 'a' && c <= 'f') digit = static_cast<u64>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') digit = static_cast<u64>(c - 'A' + 10);
+        else return {};
+        hash = (hash << 4) | digit;
+    }
+    return FromHash(hash);
+}
+
+std::string NormalizeAssetPath(std::string_view path) {
+    std::string normalized;
+    normalized.reserve(path.size());
+    if (!path.empty() && (path[0] == '/' || path[0] == '\\')) {
+        normalized.push_back('/');
+    }
+    
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find_first_of("/\\", start);
+        if (end == std::string_view::npos) end = path.size();
+        
+        std::string_view segment = path.substr(start, end - start);
+        if (!segment.empty() && segment != ".") {
+            if (!normalized.empty() && normalized.back() != '/') normalized.push_back('/');
+            normalized.append(segment);
+        }
+        start = end + 1;
+    }
+    return normalized;
+}
+
+AssetID MakeAssetID(std::string_view path) {
+    return StringID::Intern(NormalizeAssetPath(path));
+}
+
+size_t GetInternedStringCount() {
+    return GetStringTable().count.load(std::memory_order_relaxed);
+}
+
+size_t GetInternedStringBytes() {
+    return GetStringTable().bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace action
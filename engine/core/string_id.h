@@ -0,0 +1,90 @@
+#pragma once
+
+#include "types.h"
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace action {
+
+/*
+ * String IDs - 64-bit hashes standing in for strings
+ *
+ * - A StringID is the FNV-1a hash of its string: map keys, lookups and
+ *   comparisons touch 8 bytes instead of hashing and copying the string.
+ *   The hash is constexpr, so IDs of literals cost nothing at runtime.
+ * - Intern() also records the string once in a global table (append-only,
+ *   thread-safe), so an ID can be turned back into text for logs, the editor
+ *   and debugging. Constructing a StringID from a string only hashes it.
+ * - Interning a string whose hash already belongs to a different string
+ *   logs a warning on every such call (the first string keeps the ID)
+ * - The empty string is the invalid ID (0)
+ *
+ * AssetID is the StringID of a normalized asset path: '/' separators, no "./"
+ * or empty segments, so "assets\\rock.mesh" and "./assets/rock.mesh" name the
+ * same asset. Create them with MakeAssetID: AssetID("rock.mesh") is neither
+ * normalized nor interned, and loads by such an ID fail (with an error log).
+ */
+
+class StringID {
+public:
+    constexpr StringID() = default;
+    constexpr explicit StringID(std::string_view str) : m_hash(Hash(str)) {}
+    
+    static constexpr StringID FromHash(u64 hash) {
+        StringID id;
+        id.m_hash = hash;
+        return id;
+    }
+    
+    // Hashes str and keeps a copy of it for GetString
+    static StringID Intern(std::string_view str);
+    
+    constexpr u64 GetHash() const { return m_hash; }
+    constexpr bool IsValid() const { return m_hash != 0; }
+    
+    // Interned text, valid for the program's lifetime ("" if never interned)
+    std::string_view GetString() const;
+    
+    // 16 hex digits: exact in text formats whose numbers are doubles (JSON)
+    std::string ToHex() const;
+    static StringID FromHex(std::string_view hex);  // Invalid ID on malformed input
+    
+    constexpr bool operator==(const StringID& o) const { return m_hash == o.m_hash; }
+    constexpr bool operator!=(const StringID& o) const { return m_hash != o.m_hash; }
+    constexpr bool operator<(const StringID& o) const { return m_hash < o.m_hash; }
+    
+    static constexpr u64 Hash(std::string_view str) {
+        if (str.empty()) return 0;
+        u64 hash = 0xcbf29ce484222325ull;
+        for (char c : str) {
+            hash ^= static_cast<u8>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash != 0 ? hash : 1;  // 0 is reserved for the empty string
+    }
+
+private:
+    u64 m_hash = 0;
+};
+
+// Asset identity: the StringID of the normalized path
+using AssetID = StringID;
+
+std::string NormalizeAssetPath(std::string_view path);
+
+// Normalizes and interns path
+AssetID MakeAssetID(std::string_view path);
+
+// Number of interned strings and their bytes (debug stats)
+size_t GetInternedStringCount();
+size_t GetInternedStringBytes();
+
+} // namespace action
+
+template<>
+struct std::hash<action::StringID> {
+    size_t operator()(const action::StringID& id) const noexcept {
+        return static_cast<size_t>(id.GetHash());
+    }
+};
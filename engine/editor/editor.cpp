@@ -64,8 +64,8 @@ bool Editor::Initialize(Renderer& renderer, Platform& platform, ECS& ecs,
     // Initialize prefab manager
     m_prefab_manager.Initialize(this, m_assets);
     
-    // Initialize hot reloader for Blender assets
-    m_hot_reloader.Initialize(m_assets, this);
+    // Initialize hot reloader for Blender assets (imports run on the asset job system)
+    m_hot_reloader.Initialize(m_assets, this, m_assets->GetJobSystem());
     m_hot_reloader.AddWatchDirectory("assets/models", true);
     m_hot_reloader.SetReloadCallback([this](const std::string& path, bool success) {
         if (success) {
@@ -76,6 +76,22 @@ bool Editor::Initialize(Renderer& renderer, Platform& platform, ECS& ecs,
     });
     m_hot_reloader.Start();
     
+    // Reloaded meshes keep their handles; only the cached bounds need refreshing
+    m_assets->SetMeshReplacedCallback([this](MeshHandle handle) {
+        const MeshData* mesh_data = m_assets->GetMesh(handle);
+        if (!mesh_data) return;
+        
+        m_ecs->ForEach<RenderComponent, TransformComponent, BoundsComponent>(
+            [&](Entity, RenderComponent& render, TransformComponent& transform, BoundsComponent& bounds) {
+                if (render.mesh != handle) return;
+                
+                bounds.local_bounds = mesh_data->bounds;
+                vec3 half = mesh_data->bounds.extents();
+                vec3 scaled_half{half.x * transform.scale.x, half.y * transform.scale.y, half.z * transform.scale.z};
+                bounds.world_bounds = AABB(transform.position - scaled_half, transform.position + scaled_half);
+            });
+    });
+    
     // Setup initial scene tree with just a root node (empty scene)
     m_scene_root.id = m_next_node_id++;
     m_scene_root.name = "Scene";
@@ -102,6 +118,7 @@ void Editor::Shutdown() {
     
     // Shutdown hot reloader first
     m_hot_reloader.Shutdown();
+    m_assets->SetMeshReplacedCallback(nullptr);
     
     m_viewport_panel.reset();
     m_multi_viewport_panel.reset();
@@ -885,6 +902,14 @@ void Editor::DrawSavePrefabPopup() {
     }
 }
 
+u32 Editor::NewPersistentID() {
+    u32 id = 0;
+    while (id == 0) {
+        id = static_cast<u32>(m_persistent_id_rng());
+    }
+    return id;
+}
+
 EditorNode* Editor::AddNode(const std::string& type, EditorNode* parent) {
     if (!parent) {
         parent = &m_scene_root;
@@ -960,6 +985,8 @@ EditorNode* Editor::AddNode(const std::string& type, EditorNode* parent) {
         obj.color = vec4{node.color.x, node.color.y, node.color.z, 1.0f};
         obj.visible = true;
         obj.lod_level = 0;
+        node.persistent_id = NewPersistentID();
+        obj.persistent_id = node.persistent_id;
         m_world->AddObject(obj);
         
         LOG_INFO("Created {} entity: {}", type, node.name);
@@ -1106,6 +1133,21 @@ void Editor::SyncTransforms() {
     sync_node(m_scene_root);
 }
 
+void Editor::ShiftOrigin(const vec3& shift) {
+    // Nodes mirror ECS transforms (SyncTransforms pushes them every frame),
+    // so they have to move with the origin or the shift would be undone
+    std::function<void(EditorNode&)> shift_node = [&](EditorNode& node) {
+        node.position = node.position - shift;
+        for (auto& child : node.children) {
+            shift_node(child);
+        }
+    };
+    
+    for (auto& child : m_scene_root.children) {
+        shift_node(child);
+    }
+}
+
 // ============================================================================
 // Node Finding (for commands)
 // ============================================================================
@@ -17,6 +17,7 @@
 #include "project/scene_serializer.h"
 #include <memory>
 #include <functional>
+#include <random>
 
 namespace action {
 
@@ -45,7 +46,8 @@ struct EditorConfig {
 
 // Editor node linked to actual ECS entity
 struct EditorNode {
-    u32 id = 0;
+    u32 id = 0;                      // This session only
+    u32 persistent_id = 0;           // Saved with the scene; keys chunk deltas (0 = none)
     Entity entity = INVALID_ENTITY;  // Link to ECS entity
     std::string name;
     std::string type;
@@ -154,6 +156,9 @@ public:
     // Viewport picking from raw screen coordinates (called by Engine)
     void TryPickAtScreenPosition(float screen_x, float screen_y);
     
+    // Floating origin: shift node positions to match ECS (called by Engine)
+    void ShiftOrigin(const vec3& shift);
+    
 private:
     void SetupDockspace();
     void SetupStyle();
@@ -179,6 +184,9 @@ private:
     // Sync EditorNode transforms to ECS/WorldManager
     void SyncTransforms();
     
+    // Random non-zero ID for a node's world object (node IDs restart every session)
+    u32 NewPersistentID();
+    
     EditorConfig m_config;
     
     // ImGui Vulkan rendering
@@ -223,6 +231,7 @@ private:
     u32 m_selected_node_id = 0;               // Primary selection (for inspector)
     std::vector<u32> m_selected_node_ids;     // Multi-selection (for prefabs)
     u32 m_next_node_id = 1;
+    std::mt19937 m_persistent_id_rng{std::random_device{}()};
     
     // Cached primitive meshes
     MeshHandle m_cube_mesh{0};
@@ -1,5 +1,6 @@
 #include "prefab.h"
 #include "editor/editor.h"
+#include "assets/asset_manager.h"
 #include "core/logging.h"
 #include <fstream>
 #include <sstream>
@@ -15,14 +16,14 @@ Prefab::Prefab(const std::string& name)
 {
 }
 
-void Prefab::CaptureFromNode(const EditorNode& node) {
-    CaptureNodeRecursive(node, m_root_data);
+void Prefab::CaptureFromNode(const EditorNode& node, const AssetManager* assets) {
+    CaptureNodeRecursive(node, m_root_data, assets);
     if (m_name.empty()) {
         m_name = node.name;
     }
 }
 
-void Prefab::CaptureNodeRecursive(const EditorNode& node, PrefabNodeData& data) {
+void Prefab::CaptureNodeRecursive(const EditorNode& node, PrefabNodeData& data, const AssetManager* assets) {
     data.name = node.name;
     data.type = node.type;
     data.position = node.position;
@@ -30,12 +31,13 @@ void Prefab::CaptureNodeRecursive(const EditorNode& node, PrefabNodeData& data)
     data.scale = node.scale;
     data.color = node.color;
     data.visible = node.visible;
+    data.mesh = assets ? assets->GetMeshID(node.mesh) : AssetID{};
     
     // Capture children
     data.children.clear();
     for (const auto& child : node.children) {
         PrefabNodeData child_data;
-        CaptureNodeRecursive(child, child_data);
+        CaptureNodeRecursive(child, child_data, assets);
         data.children.push_back(child_data);
     }
 }
@@ -55,6 +57,10 @@ std::string Prefab::ToJson() const {
         oss << ind << "  \"scale\": [" << node.scale.x << ", " << node.scale.y << ", " << node.scale.z << "],\n";
         oss << ind << "  \"color\": [" << node.color.x << ", " << node.color.y << ", " << node.color.z << "],\n";
         oss << ind << "  \"visible\": " << (node.visible ? "true" : "false") << ",\n";
+        if (node.mesh.IsValid()) {
+            oss << ind << "  \"mesh_id\": \"" << node.mesh.ToHex() << "\",\n";
+            oss << ind << "  \"mesh\": \"" << node.mesh.GetString() << "\",\n";
+        }
         oss << ind << "  \"children\": [";
         if (node.children.empty()) {
             oss << "]\n";
@@ -133,6 +139,23 @@ bool Prefab::FromJson(const std::string& json) {
     m_root_data.color = find_array3("color", root_pos);
     m_root_data.visible = find_bool("visible", root_pos);
     
+    // Mesh reference: only the root's own keys (before its children). The path is
+    // interned so the ID can be loaded; it wins over a hand-edited ID.
+    m_root_data.mesh = {};
+    size_t children_pos = json.find("\"children\":", root_pos);
+    size_t mesh_pos = json.find("\"mesh_id\":", root_pos);
+    if (mesh_pos != std::string::npos && mesh_pos < children_pos) {
+        m_root_data.mesh = AssetID::FromHex(find_string("mesh_id", root_pos));
+        std::string mesh_path = find_string("mesh", root_pos);
+        if (!mesh_path.empty()) {
+            AssetID path_id = MakeAssetID(mesh_path);
+            if (m_root_data.mesh != path_id) {
+                LOG_WARN("Prefab mesh id {} does not match {}, using the path", m_root_data.mesh.ToHex(), mesh_path);
+            }
+            m_root_data.mesh = path_id;
+        }
+    }
+    
     return true;
 }
 
@@ -185,7 +208,7 @@ void PrefabManager::Initialize(Editor* editor, AssetManager* assets) {
 
 std::shared_ptr<Prefab> PrefabManager::CreatePrefab(const std::string& name, const EditorNode& node) {
     auto prefab = std::make_shared<Prefab>(name);
-    prefab->CaptureFromNode(node);
+    prefab->CaptureFromNode(node, m_assets);
     m_prefabs[name] = prefab;
     LOG_INFO("Created prefab: {}", name);
     return prefab;
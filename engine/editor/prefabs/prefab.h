@@ -2,6 +2,7 @@
 
 #include "core/types.h"
 #include "core/math/math.h"
+#include "core/string_id.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -17,7 +18,8 @@ class AssetManager;
 /*
  * PrefabNodeData - Serializable node data for prefabs
  * 
- * Contains all the data needed to recreate a node
+ * Contains all the data needed to recreate a node. Assets are referenced by
+ * AssetID; files store the ID and the path (for reading and re-interning).
  */
 struct PrefabNodeData {
     std::string name;
@@ -27,6 +29,7 @@ struct PrefabNodeData {
     vec3 scale{1, 1, 1};
     vec3 color{0.8f, 0.8f, 0.8f};
     bool visible = true;
+    AssetID mesh;  // Mesh asset (invalid for primitive and procedural meshes)
     
     // Children nodes (recursive structure)
     std::vector<PrefabNodeData> children;
@@ -57,8 +60,8 @@ public:
     const PrefabNodeData& GetRootData() const { return m_root_data; }
     PrefabNodeData& GetRootData() { return m_root_data; }
     
-    // Create prefab from editor node
-    void CaptureFromNode(const EditorNode& node);
+    // Create prefab from editor node (assets resolves mesh handles to asset IDs)
+    void CaptureFromNode(const EditorNode& node, const AssetManager* assets = nullptr);
     
     // Serialize/deserialize
     bool SaveToFile(const std::string& path);
@@ -74,7 +77,7 @@ private:
     PrefabNodeData m_root_data;
     
     // Recursively capture node data
-    void CaptureNodeRecursive(const EditorNode& node, PrefabNodeData& data);
+    void CaptureNodeRecursive(const EditorNode& node, PrefabNodeData& data, const AssetManager* assets);
 };
 
 /*
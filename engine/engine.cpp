@@ -49,6 +49,21 @@ bool Engine::Initialize(const EngineConfig& config) {
         LOG_ERROR("Failed to initialize asset manager");
         return false;
     }
+    m_assets->SetJobSystem(m_jobs.get());  // Background reads/decodes
+    
+    // 3b. Resource loader (materials and their textures, cached by path)
+    m_resource_cache = std::make_unique<ResourceCache>();
+    if (!m_resource_cache->Initialize()) {
+        LOG_ERROR("Failed to initialize resource cache");
+        return false;
+    }
+    m_resources = std::make_unique<ResourceLoader>();
+    if (!m_resources->Initialize(*m_resource_cache)) {
+        LOG_ERROR("Failed to initialize resource loader");
+        return false;
+    }
+    m_resources->SetJobSystem(m_jobs.get());  // Async loads and their dependencies
+    m_resources->RegisterDefaultLoaders();
     
     // 4. Renderer (Forward+ Vulkan)
     m_renderer = std::make_unique<Renderer>();
@@ -82,6 +97,11 @@ bool Engine::Initialize(const EngineConfig& config) {
         .cold_zone_radius = static_cast<float>(config.streaming.cold_zone_radius),
         .lod_bias = config.quality.lod_bias,
         .draw_distance = config.quality.draw_distance,
+        .prediction_time = config.streaming.prediction_time,
+        .warm_tick_interval = config.streaming.warm_tick_interval,
+        .cold_tick_interval = config.streaming.cold_tick_interval,
+        .origin_rebase_distance = config.streaming.origin_rebase_distance,
+        .delta_directory = config.streaming.chunk_delta_directory,
     };
     if (!m_world->Initialize(world_config)) {
         LOG_ERROR("Failed to initialize world manager");
@@ -95,8 +115,9 @@ bool Engine::Initialize(const EngineConfig& config) {
         return false;
     }
     
-    // Connect WorldManager to ECS for transform queries
+    // Connect WorldManager to ECS (transform queries) and assets (chunk deltas)
     m_world->SetECS(m_ecs.get());
+    m_world->SetAssetManager(m_assets.get());
     
     // 7. Physics World (legacy - spatial queries)
     m_physics = std::make_unique<PhysicsWorld>();
@@ -104,6 +125,7 @@ bool Engine::Initialize(const EngineConfig& config) {
         LOG_ERROR("Failed to initialize PhysicsWorld");
         return false;
     }
+    m_physics->SetJobSystem(m_jobs.get());  // Parallel collision pair finding
     
     // 7b. Jolt Physics (rigidbody simulation)
     m_jolt_physics = std::make_unique<JoltPhysics>();
@@ -160,6 +182,8 @@ void Engine::Shutdown() {
     if (m_ecs) m_ecs->Shutdown();
     if (m_world) m_world->Shutdown();
     if (m_assets) m_assets->Shutdown();  // Clean up GPU resources first
+    if (m_resources) m_resources->Shutdown();  // Waits for async loads (needs the jobs)
+    if (m_resource_cache) m_resource_cache->Shutdown();
     if (m_renderer) m_renderer->Shutdown();  // Then destroy Vulkan context
     if (m_jobs) m_jobs->Shutdown();
     if (m_platform) m_platform->Shutdown();
@@ -236,6 +260,22 @@ void Engine::Update(float dt) {
     // Check if we're in play mode
     bool play_mode = m_editor->IsPlayMode();
     
+    // Floating origin: recentre on the player while playing, and return to
+    // absolute coordinates for editing. Runs before the cameras below, which
+    // read their targets after ShiftOrigin has moved them.
+    vec3 origin_shift{0, 0, 0};
+    if (play_mode) {
+        vec3 player_pos = m_ecs->GetPlayerPosition();
+        if (m_world->ShouldRebaseOrigin(player_pos)) {
+            origin_shift = m_world->RebaseOrigin(player_pos);
+        }
+    } else if (m_world->GetOriginChunk() != ChunkCoord{0, 0}) {
+        origin_shift = m_world->ResetOrigin();
+    }
+    if (origin_shift.length_sq() > 0.0f) {
+        ShiftOrigin(origin_shift);
+    }
+    
     // ========================================
     // PLAY MODE: Third-person camera follows player
     // ========================================
@@ -246,7 +286,7 @@ void Engine::Update(float dt) {
         static float cam_yaw = 0.0f;              // Horizontal angle (controlled by mouse)
         static float cam_pitch = 0.3f;            // Vertical angle (controlled by mouse)
         static float cam_sensitivity = 0.003f;
-        static vec3 smooth_target{0, 0, 0};       // Smoothed camera target
+        vec3& smooth_target = m_play_camera_target;
         
         // Mouse look (when right-click held, or always during play)
         if (input.IsKeyDown(Key::MouseRight)) {
@@ -314,7 +354,7 @@ void Engine::Update(float dt) {
     // ========================================
     else {
         // Camera orbit parameters (persistent state)
-        static vec3 pivot_point{0, 0, 0};
+        vec3& pivot_point = m_editor_pivot;
         static float orbit_distance = 10.0f;
         static float orbit_yaw = 0.0f;
         static float orbit_pitch = 0.3f;
@@ -444,10 +484,11 @@ void Engine::Update(float dt) {
         m_ecs->Update(dt);
     }
     
-    // Update physics (spatial hash, character controllers, Jolt simulation)
+    // Update physics (spatial hash, collision events, character controllers, Jolt simulation)
     {
         PROFILE_SCOPE("Physics::Update");
         m_physics->UpdateSpatialHash();
+        m_physics->DetectCollisions();      // Enter/stay/exit events for scripts
         m_character_controller->Update(dt);
         
         // Jolt Physics simulation
@@ -473,6 +514,21 @@ void Engine::Update(float dt) {
     m_platform->GetInput().Update();
 }
 
+void Engine::ShiftOrigin(const vec3& shift) {
+    PROFILE_SCOPE("Engine::ShiftOrigin");
+    
+    // WorldManager has already moved its chunks; bring everything else along
+    m_ecs->ShiftOrigin(shift);
+    m_physics->ShiftOrigin(shift);  // After the ECS: re-cells from the shifted transforms
+    m_jolt_physics->ShiftOrigin(shift);
+    m_editor->ShiftOrigin(shift);
+    
+    Camera& camera = m_renderer->GetCamera();
+    camera.position = camera.position - shift;
+    m_play_camera_target = m_play_camera_target - shift;
+    m_editor_pivot = m_editor_pivot - shift;
+}
+
 void Engine::Render() {
     PROFILE_SCOPE("Render");
     
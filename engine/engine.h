@@ -22,6 +22,8 @@
 #include "render/renderer.h"
 #include "world/world_manager.h"
 #include "assets/asset_manager.h"
+#include "resources/resource_cache.h"
+#include "resources/resource_loader.h"
 #include "gameplay/ecs/ecs.h"
 #include "scripting/script_system.h"
 #include "physics/physics_world.h"
@@ -69,6 +71,10 @@ struct EngineConfig {
         uint32_t hot_zone_radius = 100;         // Meters
         uint32_t warm_zone_radius = 500;
         uint32_t cold_zone_radius = 2000;
+        uint32_t warm_tick_interval = 4;        // Simulation LOD: frames between ticks
+        uint32_t cold_tick_interval = 16;
+        float origin_rebase_distance = 1024.0f; // Floating origin threshold (0 = off)
+        std::string chunk_delta_directory;      // Saved chunk changes (empty = memory only)
     } streaming;
     
     // Threading (4-core target)
@@ -96,6 +102,7 @@ public:
     Renderer& GetRenderer() { return *m_renderer; }
     WorldManager& GetWorld() { return *m_world; }
     AssetManager& GetAssets() { return *m_assets; }
+    ResourceLoader& GetResources() { return *m_resources; }
     JobSystem& GetJobs() { return *m_jobs; }
     ECS& GetECS() { return *m_ecs; }
     ScriptSystem& GetScripts() { return *m_scripts; }
@@ -127,6 +134,7 @@ private:
     
     void MainLoop();
     void Update(float dt);
+    void ShiftOrigin(const vec3& shift);
     void Render();
     void UpdateStats();
     
@@ -142,6 +150,8 @@ private:
     std::unique_ptr<Platform> m_platform;
     std::unique_ptr<JobSystem> m_jobs;
     std::unique_ptr<AssetManager> m_assets;
+    std::unique_ptr<ResourceCache> m_resource_cache;
+    std::unique_ptr<ResourceLoader> m_resources;
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<WorldManager> m_world;
     std::unique_ptr<ECS> m_ecs;
@@ -151,6 +161,10 @@ private:
     std::unique_ptr<ScriptSystem> m_scripts;
     std::unique_ptr<Editor> m_editor;
     
+    // Camera points that live in world space; ShiftOrigin moves them in both modes
+    vec3 m_play_camera_target{0, 0, 0};   // Smoothed third-person target
+    vec3 m_editor_pivot{0, 0, 0};         // Editor orbit pivot
+    
     // Game callback
     GameUpdateCallback m_game_update_callback;
     
@@ -101,4 +101,20 @@ vec3 ECS::GetPlayerVelocity() const {
     return {0, 0, 0};
 }
 
+void ECS::ShiftOrigin(const vec3& shift) {
+    PROFILE_SCOPE("ECS::ShiftOrigin");
+    
+    if (auto* transforms = GetPool<TransformComponent>()) {
+        for (auto& transform : transforms->GetComponents()) {
+            transform.position = transform.position - shift;
+        }
+    }
+    
+    if (auto* bounds = GetPool<BoundsComponent>()) {
+        for (auto& b : bounds->GetComponents()) {
+            b.world_bounds = AABB(b.world_bounds.min - shift, b.world_bounds.max - shift);
+        }
+    }
+}
+
 } // namespace action
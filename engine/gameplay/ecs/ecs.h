@@ -216,6 +216,9 @@ public:
     void SetPlayerEntity(Entity entity) { m_player_entity = entity; }
     Entity GetPlayerEntity() const { return m_player_entity; }
     
+    // Floating origin: subtract shift from every transform and world bounds
+    void ShiftOrigin(const vec3& shift);
+    
 private:
     template<typename T>
     ComponentPool<T>* GetPool() {
@@ -310,4 +313,43 @@ namespace Tags {
     constexpr u32 Trigger = 1 << 5;
 }
 
+// Simulation zone (distance ring around the player, see WorldManager)
+enum class SimZone : u8 {
+    Hot = 0,        // Full rate
+    Warm = 1,       // Reduced rate
+    Cold = 2,       // Minimal rate, dynamic physics asleep
+    Outside = 3     // Beyond streaming range, treated as Cold
+};
+
+// Simulation LOD - distant entities tick every Nth frame instead of every frame.
+// Zone and schedule are written by WorldManager each frame; scripts, character
+// controllers and physics read them via GetSimulationStep().
+struct SimulationLODComponent {
+    SimZone zone = SimZone::Hot;
+    SimZone previous_zone = SimZone::Hot;  // Zone last frame (detect transitions)
+    u16 tick_interval = 1;                 // Tick every Nth frame
+    bool should_tick = true;               // Due this frame
+    float tick_dt = 0.0f;                  // Time to simulate when due (skipped frames included)
+    float accumulated_dt = 0.0f;
+    
+    bool ZoneChanged() const { return zone != previous_zone; }
+};
+
+// Time step an entity should simulate this frame. Returns false when the
+// entity's tick is skipped. Entities are opted in on first use, so their
+// first frame always runs at full rate.
+inline bool GetSimulationStep(ECS& ecs, Entity entity, float dt, float& out_dt) {
+    auto* lod = ecs.GetComponent<SimulationLODComponent>(entity);
+    if (!lod) {
+        ecs.AddComponent<SimulationLODComponent>(entity);
+        out_dt = dt;
+        return true;
+    }
+    
+    if (!lod->should_tick) return false;
+    
+    out_dt = lod->tick_dt > 0.0f ? lod->tick_dt : dt;
+    return true;
+}
+
 } // namespace action
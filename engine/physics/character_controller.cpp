@@ -16,13 +16,17 @@ void CharacterController::Update(float dt) {
     // Process all character controllers
     m_ecs->ForEach<CharacterControllerComponent, TransformComponent>(
         [this, dt](Entity entity, CharacterControllerComponent& controller, TransformComponent& transform) {
+            // Distant characters tick every Nth frame with the accumulated dt
+            float step = dt;
+            if (!GetSimulationStep(*m_ecs, entity, dt, step)) return;
+            
             // Store previous grounded state
             controller.was_grounded = controller.ground.grounded;
             
             // Apply gravity if not grounded
             if (!controller.ground.grounded) {
-                controller.velocity = controller.velocity + m_world->GetGravity() * dt;
-                controller.time_since_grounded += dt;
+                controller.velocity = controller.velocity + m_world->GetGravity() * step;
+                controller.time_since_grounded += step;
             } else {
                 controller.time_since_grounded = 0.0f;
                 // Dampen vertical velocity when grounded
@@ -33,7 +37,7 @@ void CharacterController::Update(float dt) {
             
             // Check for buffered jump
             if (controller.jump_buffer_time > 0.0f) {
-                controller.jump_buffer_time -= dt;
+                controller.jump_buffer_time -= step;
                 if (controller.ground.grounded) {
                     // Execute buffered jump
                     controller.velocity.y = 8.0f;  // Default jump force
@@ -42,10 +46,10 @@ void CharacterController::Update(float dt) {
             }
             
             // Calculate total movement
-            vec3 movement = controller.move_input + controller.velocity * dt;
+            vec3 movement = controller.move_input + controller.velocity * step;
             
             // Move character with collision
-            vec3 actual_movement = MoveCharacter(entity, controller, transform, movement, dt);
+            vec3 actual_movement = MoveCharacter(entity, controller, transform, movement, step);
             
             // Clear move input for next frame
             controller.move_input = {0, 0, 0};
@@ -202,7 +206,7 @@ bool CharacterController::TryStepUp(const Capsule& capsule, const vec3& movement
     raised.center = raised.center + vec3{0, step_height, 0};
     
     // Check if raised position is clear
-    if (m_world->OverlapCapsule(raised, mask).size() > 0) {
+    if (m_world->OverlapCapsuleAny(raised, mask)) {
         return false;  // Blocked above
     }
     
@@ -247,17 +251,17 @@ bool CharacterController::CapsuleCast(const Capsule& capsule, const vec3& direct
 }
 
 bool CharacterController::CheckCapsuleOverlap(const Capsule& capsule, CollisionLayer mask) {
-    return m_world->OverlapCapsule(capsule, mask).size() > 0;
+    return m_world->OverlapCapsuleAny(capsule, mask);
 }
 
 void CharacterController::ResolvePenetration(Capsule& capsule, CollisionLayer mask) {
     const int max_iterations = 4;
     
     for (int i = 0; i < max_iterations; ++i) {
-        auto overlapping = m_world->OverlapCapsule(capsule, mask);
-        if (overlapping.empty()) break;
+        m_world->OverlapCapsule(capsule, m_overlapping, mask);
+        if (m_overlapping.empty()) break;
         
-        for (Entity entity : overlapping) {
+        for (Entity entity : m_overlapping) {
             auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
             auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
             if (!transform || !collider) continue;
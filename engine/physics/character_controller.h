@@ -147,6 +147,9 @@ private:
     
     PhysicsWorld* m_world = nullptr;
     ECS* m_ecs = nullptr;
+    
+    // ResolvePenetration's overlap results (capacity kept between calls)
+    std::vector<Entity> m_overlapping;
 };
 
 } // namespace action
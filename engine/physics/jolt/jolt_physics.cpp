@@ -253,8 +253,31 @@ void JoltPhysics::SyncToPhysics() {
         auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
         if (!transform) continue;
         
-        // Only sync kinematic bodies from ECS (dynamic bodies are controlled by physics)
-        if (body_interface.GetMotionType(body_id) == JPH::EMotionType::Kinematic) {
+        JPH::EMotionType motion_type = body_interface.GetMotionType(body_id);
+        if (motion_type == JPH::EMotionType::Static) continue;
+        
+        // Simulation LOD (opts the entity in on first use)
+        float step = FIXED_TIMESTEP;
+        bool due = GetSimulationStep(*m_ecs, entity, FIXED_TIMESTEP, step);
+        const auto* lod = m_ecs->GetComponent<SimulationLODComponent>(entity);
+        bool zone_changed = lod && lod->ZoneChanged();
+        
+        if (motion_type == JPH::EMotionType::Dynamic) {
+            // Dynamic bodies are controlled by physics; in the Cold zone they sleep
+            if (zone_changed) {
+                bool was_cold = lod->previous_zone >= SimZone::Cold;
+                bool is_cold = lod->zone >= SimZone::Cold;
+                if (is_cold && !was_cold) {
+                    body_interface.DeactivateBody(body_id);
+                } else if (was_cold && !is_cold) {
+                    body_interface.ActivateBody(body_id);
+                }
+            }
+            continue;
+        }
+        
+        // Kinematic bodies follow the ECS
+        if (!lod || lod->zone == SimZone::Hot) {
             // Activate the body so it can interact with dynamic objects
             body_interface.ActivateBody(body_id);
             
@@ -264,6 +287,16 @@ void JoltPhysics::SyncToPhysics() {
             JPH::Quat target_rot = JPH::Quat::sIdentity();  // TODO: Support rotation
             
             body_interface.MoveKinematic(body_id, target_pos, target_rot, FIXED_TIMESTEP);
+        } else {
+            // Leaving the hot zone: stop the velocity MoveKinematic left behind
+            if (zone_changed && lod->previous_zone == SimZone::Hot) {
+                body_interface.SetLinearAndAngularVelocity(body_id, JPH::Vec3::sZero(), JPH::Vec3::sZero());
+            }
+            
+            // Distant: teleport on tick frames only, nothing nearby needs pushing
+            if (due) {
+                body_interface.SetPosition(body_id, ToJoltR(transform->position), JPH::EActivation::DontActivate);
+            }
         }
     }
 }
@@ -280,6 +313,11 @@ void JoltPhysics::SyncFromPhysics() {
         auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
         if (!transform) continue;
         
+        // Distant bodies write back on their tick frames only
+        if (const auto* lod = m_ecs->GetComponent<SimulationLODComponent>(entity)) {
+            if (!lod->should_tick) continue;
+        }
+        
         // Only sync dynamic bodies to ECS
         if (body_interface.GetMotionType(body_id) == JPH::EMotionType::Dynamic) {
             JPH::RVec3 pos = body_interface.GetCenterOfMassPosition(body_id);
@@ -291,6 +329,21 @@ void JoltPhysics::SyncFromPhysics() {
     }
 }
 
+void JoltPhysics::ShiftOrigin(const vec3& shift) {
+    if (!m_physics_system) return;
+    
+    JPH::BodyInterface& body_interface = m_physics_system->GetBodyInterface();
+    JPH::Vec3 offset = ToJolt(shift);
+    
+    // DontActivate: a rebase must not wake up sleeping bodies
+    for (auto& [entity, body_id] : m_entity_to_body) {
+        if (body_id.IsInvalid()) continue;
+        
+        JPH::RVec3 pos = body_interface.GetPosition(body_id);
+        body_interface.SetPosition(body_id, pos - offset, JPH::EActivation::DontActivate);
+    }
+}
+
 JPH::RefConst<JPH::Shape> JoltPhysics::CreateShapeFromCollider(const ColliderComponent& collider) {
     switch (collider.type) {
         case ColliderType::Sphere: {
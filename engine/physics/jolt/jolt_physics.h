@@ -149,6 +149,9 @@ public:
     // Sync transforms from Jolt to ECS (after simulation)
     void SyncFromPhysics();
     
+    // Floating origin: teleport every body by -shift (velocities are kept)
+    void ShiftOrigin(const vec3& shift);
+    
     // ===== Body Management =====
     
     // Create a body for an entity (uses ColliderComponent if present)
@@ -1,6 +1,7 @@
 #include "physics_world.h"
 #include "core/logging.h"
 #include "core/math/math.h"
+#include "core/jobs/job_system.h"
 #include <algorithm>
 #include <cmath>
 #include <cfloat>
@@ -17,166 +18,425 @@ bool PhysicsWorld::Initialize(ECS* ecs, float cell_size) {
 }
 
 void PhysicsWorld::Shutdown() {
-    m_cells.clear();
-    m_colliders.clear();
+    m_cell_table.Clear();
+    m_static_entries = {};
+    m_dynamic_entries = {};
+    m_static_dirty = false;
+    m_dynamic_dirty = false;
+    m_proxies.clear();
+    m_free_slots.clear();
+    m_collider_slots.clear();
+    m_dynamic_slots.clear();
+    m_pending_slots.clear();
+    m_query = {};
     m_collision_events.clear();
+    m_contact_chunks.clear();
+    m_contacts.clear();
+    m_pairs.clear();
+    m_new_pairs.clear();
     LOG_INFO("[PhysicsWorld] Shutdown");
 }
 
-void PhysicsWorld::UpdateSpatialHash() {
-    // Clear all cells
-    for (auto& [hash, cell] : m_cells) {
-        cell.entities.clear();
+template<typename Func>
+void PhysicsWorld::ForEachCellInRange(const ivec3& min_cell, const ivec3& max_cell, Func&& func) const {
+    for (i32 x = min_cell.x; x <= max_cell.x; ++x) {
+        for (i32 y = min_cell.y; y <= max_cell.y; ++y) {
+            for (i32 z = min_cell.z; z <= max_cell.z; ++z) {
+                func(ivec3{x, y, z});
+            }
+        }
     }
+}
+
+template<typename Func>
+void PhysicsWorld::ForEachOverlappingCell(const AABB& bounds, Func&& func) const {
+    ForEachCellInRange(PositionToCell(bounds.min), PositionToCell(bounds.max), func);
+}
+
+void PhysicsWorld::UpdateSpatialHash() {
+    m_moved_count = 0;
     
-    // Re-insert all colliders
-    for (Entity entity : m_colliders) {
-        if (!m_ecs->IsAlive(entity)) continue;
+    // Colliders added or refreshed since the last update. Static ones go into the
+    // grid for good; ones without components yet wait for a later update.
+    size_t still_pending = 0;
+    for (u32 slot : m_pending_slots) {
+        ColliderProxy& proxy = m_proxies[slot];
         
-        auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
-        auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
-        if (!transform || !collider) continue;
+        auto* transform = m_ecs->GetComponent<TransformComponent>(proxy.entity);
+        auto* collider = m_ecs->GetComponent<ColliderComponent>(proxy.entity);
+        if (!m_ecs->IsAlive(proxy.entity)) {
+            // Destroyed before it was ever inserted; nothing will remove it
+            proxy.pending = false;
+            ReleaseProxy(slot);
+            continue;
+        }
+        if (!transform || !collider) {
+            m_pending_slots[still_pending++] = slot;
+            continue;
+        }
+        
+        proxy.pending = false;
+        proxy.is_static = collider->is_static;
+        proxy.mask = collider->mask;
+        proxy.is_trigger = collider->is_trigger;
+        if (proxy.is_static) {
+            AABB bounds = collider->GetWorldBounds(transform->position);
+            InsertIntoGrid(slot, PositionToCell(bounds.min), PositionToCell(bounds.max), collider->layer);
+        } else {
+            proxy.dynamic_index = static_cast<u32>(m_dynamic_slots.size());
+            m_dynamic_slots.push_back(slot);
+        }
+    }
+    m_pending_slots.resize(still_pending);
+    
+    // Dynamic colliders only move when their cell range (or layer) changed
+    for (size_t i = 0; i < m_dynamic_slots.size();) {
+        u32 slot = m_dynamic_slots[i];
+        ColliderProxy& proxy = m_proxies[slot];
+        if (!m_ecs->IsAlive(proxy.entity)) {
+            ReleaseProxy(slot);  // Swaps the last dynamic slot into i
+            continue;
+        }
+        ++i;
+        
+        auto* transform = m_ecs->GetComponent<TransformComponent>(proxy.entity);
+        auto* collider = m_ecs->GetComponent<ColliderComponent>(proxy.entity);
+        if (!transform || !collider) {
+            RemoveFromGrid(slot);
+            continue;
+        }
+        
+        proxy.mask = collider->mask;
+        proxy.is_trigger = collider->is_trigger;
         
         AABB bounds = collider->GetWorldBounds(transform->position);
-        auto cells = GetOverlappingCells(bounds);
+        ivec3 min_cell = PositionToCell(bounds.min);
+        ivec3 max_cell = PositionToCell(bounds.max);
+        if (proxy.in_grid && proxy.min_cell == min_cell && proxy.max_cell == max_cell &&
+            proxy.layer == collider->layer) {
+            continue;
+        }
         
-        for (const ivec3& cell_coord : cells) {
-            size_t hash = CellHash(cell_coord);
-            m_cells[hash].entities.push_back(entity);
+        InsertIntoGrid(slot, min_cell, max_cell, collider->layer);
+        ++m_moved_count;
+    }
+    
+    SweepDeadStatics();
+    
+    RebuildCellEntries();
+}
+
+void PhysicsWorld::SweepDeadStatics() {
+    // Static colliders are never revisited by the update, so a destroyed entity
+    // would keep its slot and grid entries; check a window of slots per update
+    u32 slot_count = static_cast<u32>(m_proxies.size());
+    if (slot_count == 0) return;
+    
+    u32 count = std::min(STATIC_SWEEP_PER_UPDATE, slot_count);
+    for (u32 i = 0; i < count; ++i) {
+        if (m_static_sweep_cursor >= slot_count) {
+            m_static_sweep_cursor = 0;
+        }
+        u32 slot = m_static_sweep_cursor++;
+        
+        const ColliderProxy& proxy = m_proxies[slot];
+        if (proxy.entity == INVALID_ENTITY || proxy.pending || !proxy.is_static) continue;
+        if (!m_ecs->IsAlive(proxy.entity)) {
+            ReleaseProxy(slot);
         }
     }
 }
 
+void PhysicsWorld::ShiftOrigin(const vec3& shift) {
+    if (shift.x == 0.0f && shift.y == 0.0f && shift.z == 0.0f) return;
+    
+    // Static colliders never re-cell on their own; dynamic ones would at the next
+    // update, but queries before it would miss them
+    for (u32 slot = 0; slot < static_cast<u32>(m_proxies.size()); ++slot) {
+        ColliderProxy& proxy = m_proxies[slot];
+        if (!proxy.in_grid) continue;
+        
+        auto* transform = m_ecs->GetComponent<TransformComponent>(proxy.entity);
+        auto* collider = m_ecs->GetComponent<ColliderComponent>(proxy.entity);
+        if (!transform || !collider) {
+            RemoveFromGrid(slot);
+            continue;
+        }
+        
+        AABB bounds = collider->GetWorldBounds(transform->position);
+        InsertIntoGrid(slot, PositionToCell(bounds.min), PositionToCell(bounds.max), proxy.layer);
+    }
+}
+
 void PhysicsWorld::AddCollider(Entity entity) {
-    // Check if already added
-    auto it = std::find(m_colliders.begin(), m_colliders.end(), entity);
-    if (it == m_colliders.end()) {
-        m_colliders.push_back(entity);
+    auto [it, inserted] = m_collider_slots.try_emplace(entity, 0);
+    if (!inserted) return;
+    
+    u32 slot;
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+    } else {
+        slot = static_cast<u32>(m_proxies.size());
+        m_proxies.emplace_back();
+        m_query.stamps.push_back(0);
     }
+    it->second = slot;
+    
+    ColliderProxy& proxy = m_proxies[slot];
+    proxy = ColliderProxy{};
+    proxy.entity = entity;
+    proxy.pending = true;
+    m_pending_slots.push_back(slot);
 }
 
 void PhysicsWorld::RemoveCollider(Entity entity) {
-    m_colliders.erase(
-        std::remove(m_colliders.begin(), m_colliders.end(), entity),
-        m_colliders.end());
+    auto it = m_collider_slots.find(entity);
+    if (it == m_collider_slots.end()) return;
+    
+    ReleaseProxy(it->second);
 }
 
-// ===== Raycast =====
+void PhysicsWorld::RefreshCollider(Entity entity) {
+    auto it = m_collider_slots.find(entity);
+    if (it == m_collider_slots.end()) return;
+    
+    u32 slot = it->second;
+    DetachProxy(slot);
+    m_proxies[slot].pending = true;
+    m_pending_slots.push_back(slot);
+}
 
-RaycastHit PhysicsWorld::Raycast(const vec3& origin, const vec3& direction,
-                                  float max_distance, CollisionLayer mask,
-                                  Entity ignore) {
-    RaycastHit closest;
-    closest.distance = max_distance;
-    
-    vec3 dir = direction.normalized();
+void PhysicsWorld::InsertIntoGrid(u32 slot, const ivec3& min_cell, const ivec3& max_cell,
+                                  CollisionLayer layer) {
+    ColliderProxy& proxy = m_proxies[slot];
+    proxy.min_cell = min_cell;
+    proxy.max_cell = max_cell;
+    proxy.layer = layer;
+    proxy.in_grid = true;
+    (proxy.is_static ? m_static_dirty : m_dynamic_dirty) = true;
+}
+
+void PhysicsWorld::RemoveFromGrid(u32 slot) {
+    ColliderProxy& proxy = m_proxies[slot];
+    if (!proxy.in_grid) return;
+    proxy.in_grid = false;
+    (proxy.is_static ? m_static_dirty : m_dynamic_dirty) = true;
+}
+
+void PhysicsWorld::RebuildCellEntries() {
+    if (!m_static_dirty && !m_dynamic_dirty) return;
+    
+    // Counts cells occupied in both lists twice, so it only compacts later than exact
+    u32 cell_count = m_cell_table.GetCellCount();
+    u32 occupied = static_cast<u32>(m_static_entries.occupied.size() + m_dynamic_entries.occupied.size());
+    if (cell_count > CELL_TABLE_MIN_COMPACT && cell_count - occupied > occupied * CELL_TABLE_EMPTY_RATIO) {
+        m_cell_table.Clear();
+        m_static_dirty = true;
+        m_dynamic_dirty = true;
+    }
     
-    // Get bounds for the ray
-    AABB ray_bounds;
-    ray_bounds.min.x = std::min(origin.x, origin.x + dir.x * max_distance);
-    ray_bounds.min.y = std::min(origin.y, origin.y + dir.y * max_distance);
-    ray_bounds.min.z = std::min(origin.z, origin.z + dir.z * max_distance);
-    ray_bounds.max.x = std::max(origin.x, origin.x + dir.x * max_distance);
-    ray_bounds.max.y = std::max(origin.y, origin.y + dir.y * max_distance);
-    ray_bounds.max.z = std::max(origin.z, origin.z + dir.z * max_distance);
+    if (m_static_dirty) {
+        BuildCellEntries(true);
+        m_static_dirty = false;
+    }
+    if (m_dynamic_dirty) {
+        BuildCellEntries(false);
+        m_dynamic_dirty = false;
+    }
+}
+
+void PhysicsWorld::BuildCellEntries(bool is_static) {
+    CellEntryList& list = is_static ? m_static_entries : m_dynamic_entries;
+    
+    // Every (cell, entry) pair, in slot order; new cells are added to the table here
+    m_build_items.clear();
+    auto gather = [&](u32 slot) {
+        const ColliderProxy& proxy = m_proxies[slot];
+        if (!proxy.in_grid || proxy.is_static != is_static) return;
+        
+        CellEntry entry{proxy.entity, slot, proxy.layer};
+        ForEachCellInRange(proxy.min_cell, proxy.max_cell, [&](const ivec3& cell_coord) {
+            m_build_items.push_back({m_cell_table.FindOrAdd(PackCell(cell_coord)), entry});
+        });
+    };
+    if (is_static) {
+        for (u32 slot = 0; slot < static_cast<u32>(m_proxies.size()); ++slot) {
+            gather(slot);
+        }
+    } else {
+        for (u32 slot : m_dynamic_slots) {
+            gather(slot);
+        }
+    }
     
-    auto candidates = GetNearbyEntities(ray_bounds, mask, ignore);
+    // Counting sort by cell: counts, prefix sums, then a stable scatter
+    u32 cell_count = m_cell_table.GetCellCount();
+    list.offsets.assign(cell_count + 1, 0);
+    for (const CellBuildItem& item : m_build_items) {
+        ++list.offsets[item.cell + 1];
+    }
+    list.occupied.clear();
+    for (u32 cell = 0; cell < cell_count; ++cell) {
+        if (list.offsets[cell + 1] != 0) list.occupied.push_back(cell);
+        list.offsets[cell + 1] += list.offsets[cell];
+    }
     
-    for (Entity entity : candidates) {
-        auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
-        auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
-        if (!transform || !collider) continue;
-        
-        float t;
-        vec3 normal;
-        bool hit = false;
+    m_build_cursor.assign(list.offsets.begin(), list.offsets.end() - 1);
+    list.entries.resize(m_build_items.size());
+    for (const CellBuildItem& item : m_build_items) {
+        list.entries[m_build_cursor[item.cell]++] = item.entry;
+    }
+}
+
+u32 PhysicsWorld::CellTable::FindOrAdd(u64 key) {
+    // Grow at half load; re-inserting the cell keys keeps every cell index
+    if (keys.empty() || (cell_keys.size() + 1) * 2 > keys.size()) {
+        size_t capacity = keys.empty() ? 1024 : keys.size() * 2;
+        keys.assign(capacity, EMPTY_KEY);
+        cells.assign(capacity, INVALID_INDEX);
         
-        switch (collider->type) {
-            case ColliderType::Sphere: {
-                Sphere sphere = collider->GetWorldSphere(transform->position);
-                hit = RayVsSphere(origin, dir, sphere, closest.distance, t, normal);
-                break;
-            }
-            case ColliderType::Box: {
-                AABB box = collider->GetWorldBounds(transform->position);
-                hit = RayVsAABB(origin, dir, box, closest.distance, t, normal);
-                break;
-            }
-            case ColliderType::Capsule: {
-                Capsule capsule = collider->GetWorldCapsule(transform->position);
-                hit = RayVsCapsule(origin, dir, capsule, closest.distance, t, normal);
-                break;
-            }
-            default:
-                break;
+        u32 mask = static_cast<u32>(capacity) - 1;
+        for (u32 cell = 0; cell < static_cast<u32>(cell_keys.size()); ++cell) {
+            u32 i = HashKey(cell_keys[cell]) & mask;
+            while (keys[i] != EMPTY_KEY) i = (i + 1) & mask;
+            keys[i] = cell_keys[cell];
+            cells[i] = cell;
         }
+    }
+    
+    u32 mask = static_cast<u32>(keys.size()) - 1;
+    u32 i = HashKey(key) & mask;
+    for (; keys[i] != EMPTY_KEY; i = (i + 1) & mask) {
+        if (keys[i] == key) return cells[i];
+    }
+    
+    keys[i] = key;
+    cells[i] = static_cast<u32>(cell_keys.size());
+    cell_keys.push_back(key);
+    return cells[i];
+}
+
+void PhysicsWorld::CellTable::Clear() {
+    keys.clear();
+    cells.clear();
+    cell_keys.clear();
+}
+
+void PhysicsWorld::ReleaseProxy(u32 slot) {
+    ColliderProxy& proxy = m_proxies[slot];
+    m_collider_slots.erase(proxy.entity);
+    
+    DetachProxy(slot);
+    proxy.entity = INVALID_ENTITY;
+    m_free_slots.push_back(slot);
+}
+
+void PhysicsWorld::DetachProxy(u32 slot) {
+    RemoveFromGrid(slot);
+    
+    ColliderProxy& proxy = m_proxies[slot];
+    if (proxy.dynamic_index != INVALID_INDEX) {
+        u32 moved = m_dynamic_slots.back();
+        m_dynamic_slots[proxy.dynamic_index] = moved;
+        m_proxies[moved].dynamic_index = proxy.dynamic_index;
+        m_dynamic_slots.pop_back();
+        proxy.dynamic_index = INVALID_INDEX;
+    }
+    if (proxy.pending) {
+        m_pending_slots.erase(std::find(m_pending_slots.begin(), m_pending_slots.end(), slot));
+        proxy.pending = false;
+    }
+}
+
+// ===== Raycast =====
+
+template<typename Visitor>
+void PhysicsWorld::TraverseRayCells(const vec3& origin, const vec3& dir, float max_distance,
+                                    Visitor&& visit) const {
+    if (m_cell_table.GetCellCount() == 0 || !(max_distance > 0.0f) || !std::isfinite(max_distance)) return;
+    
+    // Amanatides-Woo: per axis, the ray distance to the next cell boundary (t_next)
+    // and between boundaries (t_delta); always step across the nearest boundary
+    ivec3 cell = PositionToCell(origin);
+    i32 step[3];
+    float t_next[3];
+    float t_delta[3];
+    i32 cells_left = 1;
+    for (int i = 0; i < 3; ++i) {
+        float d = (&dir.x)[i];
+        float o = (&origin.x)[i];
+        i32 c = (&cell.x)[i];
         
-        if (hit && t < closest.distance) {
-            closest.hit = true;
-            closest.distance = t;
-            closest.point = origin + dir * t;
-            closest.normal = normal;
-            closest.entity = entity;
+        if (std::abs(d) < EPSILON) {
+            step[i] = 0;
+            t_next[i] = FLT_MAX;
+            t_delta[i] = FLT_MAX;
+            continue;
         }
+        
+        step[i] = d > 0 ? 1 : -1;
+        float boundary = static_cast<float>(d > 0 ? c + 1 : c) * m_cell_size;
+        t_next[i] = std::max((boundary - o) / d, 0.0f);
+        t_delta[i] = m_cell_size / std::abs(d);
+        
+        // Bounds the walk against float drift: never more cells than the segment spans
+        float end = o + d * max_distance;
+        cells_left += std::abs(static_cast<i32>(std::floor(end * m_inv_cell_size)) - c);
     }
     
-    return closest;
+    float t_enter = 0.0f;
+    while (cells_left-- > 0) {
+        int axis = t_next[0] < t_next[1] ? (t_next[0] < t_next[2] ? 0 : 2) : (t_next[1] < t_next[2] ? 1 : 2);
+        float t_exit = std::min(t_next[axis], max_distance);
+        
+        u32 cell_index = m_cell_table.Find(PackCell(cell));
+        if (cell_index != INVALID_INDEX) {
+            if (!visit(cell_index, t_enter, t_exit)) return;
+        }
+        
+        if (t_exit >= max_distance) return;
+        
+        (&cell.x)[axis] += step[axis];
+        t_enter = t_next[axis];
+        t_next[axis] += t_delta[axis];
+    }
+}
+
+RaycastHit PhysicsWorld::Raycast(const vec3& origin, const vec3& direction,
+                                  float max_distance, CollisionLayer mask,
+                                  Entity ignore, bool hit_triggers) {
+    return CastRay(origin, direction.normalized(), max_distance, mask, ignore, false, hit_triggers);
 }
 
 std::vector<RaycastHit> PhysicsWorld::RaycastAll(const vec3& origin, const vec3& direction,
-                                                   float max_distance, CollisionLayer mask) {
+                                                   float max_distance, CollisionLayer mask,
+                                                   bool hit_triggers) {
     std::vector<RaycastHit> hits;
     vec3 dir = direction.normalized();
     
-    AABB ray_bounds;
-    ray_bounds.min.x = std::min(origin.x, origin.x + dir.x * max_distance);
-    ray_bounds.min.y = std::min(origin.y, origin.y + dir.y * max_distance);
-    ray_bounds.min.z = std::min(origin.z, origin.z + dir.z * max_distance);
-    ray_bounds.max.x = std::max(origin.x, origin.x + dir.x * max_distance);
-    ray_bounds.max.y = std::max(origin.y, origin.y + dir.y * max_distance);
-    ray_bounds.max.z = std::max(origin.z, origin.z + dir.z * max_distance);
-    
-    auto candidates = GetNearbyEntities(ray_bounds, mask);
-    
-    for (Entity entity : candidates) {
-        auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
-        auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
-        if (!transform || !collider) continue;
-        
-        float t;
-        vec3 normal;
-        bool hit = false;
-        
-        switch (collider->type) {
-            case ColliderType::Sphere: {
-                Sphere sphere = collider->GetWorldSphere(transform->position);
-                hit = RayVsSphere(origin, dir, sphere, max_distance, t, normal);
-                break;
-            }
-            case ColliderType::Box: {
-                AABB box = collider->GetWorldBounds(transform->position);
-                hit = RayVsAABB(origin, dir, box, max_distance, t, normal);
-                break;
-            }
-            case ColliderType::Capsule: {
-                Capsule capsule = collider->GetWorldCapsule(transform->position);
-                hit = RayVsCapsule(origin, dir, capsule, max_distance, t, normal);
-                break;
+    BeginQuery();
+    TraverseRayCells(origin, dir, max_distance, [&](u32 cell, float, float) {
+        for (std::span<const CellEntry> entries : GetCellEntries(cell)) {
+            for (const CellEntry& entry : entries) {
+                if (!HasLayer(mask, entry.layer) || SkipsTrigger(entry, hit_triggers) || !MarkSeen(entry)) continue;
+                Entity entity = entry.entity;
+                
+                float t;
+                vec3 normal;
+                if (RayVsCollider(entity, origin, dir, max_distance, t, normal)) {
+                    RaycastHit result;
+                    result.hit = true;
+                    result.distance = t;
+                    result.point = origin + dir * t;
+                    result.normal = normal;
+                    result.entity = entity;
+                    hits.push_back(result);
+                }
             }
-            default:
-                break;
         }
-        
-        if (hit) {
-            RaycastHit result;
-            result.hit = true;
-            result.distance = t;
-            result.point = origin + dir * t;
-            result.normal = normal;
-            result.entity = entity;
-            hits.push_back(result);
-        }
-    }
+        return true;
+    });
     
     // Sort by distance
     std::sort(hits.begin(), hits.end(), [](const RaycastHit& a, const RaycastHit& b) {
@@ -186,6 +446,79 @@ std::vector<RaycastHit> PhysicsWorld::RaycastAll(const vec3& origin, const vec3&
     return hits;
 }
 
+void PhysicsWorld::RaycastBatch(std::span<const RayQuery> rays, std::span<RaycastHit> out_hits) {
+    size_t count = std::min(rays.size(), out_hits.size());
+    for (size_t i = 0; i < count; ++i) {
+        const RayQuery& ray = rays[i];
+        out_hits[i] = CastRay(ray.origin, ray.direction.normalized(), ray.max_distance,
+                              ray.mask, ray.ignore, ray.any_hit, ray.hit_triggers);
+    }
+}
+
+bool PhysicsWorld::HasLineOfSight(const vec3& from, const vec3& to, CollisionLayer mask, Entity ignore) {
+    vec3 delta = to - from;
+    float distance = delta.length();
+    if (distance < EPSILON) return true;
+    
+    return !CastRay(from, delta * (1.0f / distance), distance, mask, ignore, true, false).hit;
+}
+
+RaycastHit PhysicsWorld::CastRay(const vec3& origin, const vec3& dir, float max_distance,
+                                  CollisionLayer mask, Entity ignore, bool any_hit,
+                                  bool hit_triggers) {
+    RaycastHit closest;
+    closest.distance = max_distance;
+    
+    BeginQuery();
+    TraverseRayCells(origin, dir, max_distance, [&](u32 cell, float, float t_exit) {
+        for (std::span<const CellEntry> entries : GetCellEntries(cell)) {
+            for (const CellEntry& entry : entries) {
+                if (entry.entity == ignore || !HasLayer(mask, entry.layer)) continue;
+                if (SkipsTrigger(entry, hit_triggers)) continue;
+                
+                // Colliders spanning several cells are tested once per ray
+                if (!MarkSeen(entry)) continue;
+                Entity entity = entry.entity;
+                
+                float t;
+                vec3 normal;
+                if (RayVsCollider(entity, origin, dir, closest.distance, t, normal) && t < closest.distance) {
+                    closest.hit = true;
+                    closest.distance = t;
+                    closest.point = origin + dir * t;
+                    closest.normal = normal;
+                    closest.entity = entity;
+                    if (any_hit) return false;
+                }
+            }
+        }
+        
+        // A hit inside this cell is closer than anything in the cells beyond it; a hit
+        // further along (collider reaching into later cells) may still be beaten there
+        return !(closest.hit && closest.distance <= t_exit);
+    });
+    
+    return closest;
+}
+
+bool PhysicsWorld::RayVsCollider(Entity entity, const vec3& origin, const vec3& dir,
+                                  float max_dist, float& t, vec3& normal) {
+    auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
+    auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
+    if (!transform || !collider) return false;
+    
+    switch (collider->type) {
+        case ColliderType::Sphere:
+            return RayVsSphere(origin, dir, collider->GetWorldSphere(transform->position), max_dist, t, normal);
+        case ColliderType::Box:
+            return RayVsAABB(origin, dir, collider->GetWorldBounds(transform->position), max_dist, t, normal);
+        case ColliderType::Capsule:
+            return RayVsCapsule(origin, dir, collider->GetWorldCapsule(transform->position), max_dist, t, normal);
+        default:
+            return false;
+    }
+}
+
 // ===== Sphere Cast =====
 
 SweepHit PhysicsWorld::SphereCast(const vec3& origin, float radius, const vec3& direction,
@@ -202,7 +535,7 @@ SweepHit PhysicsWorld::SphereCast(const vec3& origin, float radius, const vec3&
     sweep_bounds.max.y = std::max(origin.y, origin.y + dir.y * max_distance) + radius;
     sweep_bounds.max.z = std::max(origin.z, origin.z + dir.z * max_distance) + radius;
     
-    auto candidates = GetNearbyEntities(sweep_bounds, mask, ignore);
+    auto candidates = GatherCandidates(sweep_bounds, mask, ignore);
     
     for (Entity entity : candidates) {
         auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
@@ -274,7 +607,7 @@ SweepHit PhysicsWorld::CapsuleCast(const Capsule& capsule, const vec3& direction
     sweep_bounds.max.y = std::max(start_bounds.max.y, end_bounds.max.y);
     sweep_bounds.max.z = std::max(start_bounds.max.z, end_bounds.max.z);
     
-    auto candidates = GetNearbyEntities(sweep_bounds, mask, ignore);
+    auto candidates = GatherCandidates(sweep_bounds, mask, ignore);
     
     // Binary search for collision time
     for (Entity entity : candidates) {
@@ -341,6 +674,13 @@ SweepHit PhysicsWorld::CapsuleCast(const Capsule& capsule, const vec3& direction
 std::vector<Entity> PhysicsWorld::OverlapSphere(const vec3& center, float radius,
                                                   CollisionLayer mask) {
     std::vector<Entity> result;
+    OverlapSphere(center, radius, result, mask);
+    return result;
+}
+
+void PhysicsWorld::OverlapSphere(const vec3& center, float radius, std::vector<Entity>& out,
+                                 CollisionLayer mask) {
+    out.clear();
     
     AABB bounds{
         center - vec3{radius, radius, radius},
@@ -348,7 +688,7 @@ std::vector<Entity> PhysicsWorld::OverlapSphere(const vec3& center, float radius
     };
     
     Sphere test_sphere{center, radius};
-    auto candidates = GetNearbyEntities(bounds, mask);
+    auto candidates = GatherCandidates(bounds, mask);
     
     for (Entity entity : candidates) {
         auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
@@ -380,16 +720,20 @@ std::vector<Entity> PhysicsWorld::OverlapSphere(const vec3& center, float radius
         }
         
         if (overlap) {
-            result.push_back(entity);
+            out.push_back(entity);
         }
     }
-    
-    return result;
 }
 
 std::vector<Entity> PhysicsWorld::OverlapBox(const AABB& box, CollisionLayer mask) {
     std::vector<Entity> result;
-    auto candidates = GetNearbyEntities(box, mask);
+    OverlapBox(box, result, mask);
+    return result;
+}
+
+void PhysicsWorld::OverlapBox(const AABB& box, std::vector<Entity>& out, CollisionLayer mask) {
+    out.clear();
+    auto candidates = GatherCandidates(box, mask);
     
     for (Entity entity : candidates) {
         auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
@@ -398,58 +742,62 @@ std::vector<Entity> PhysicsWorld::OverlapBox(const AABB& box, CollisionLayer mas
         
         AABB entity_bounds = collider->GetWorldBounds(transform->position);
         if (box.intersects(entity_bounds)) {
-            result.push_back(entity);
+            out.push_back(entity);
         }
     }
-    
-    return result;
 }
 
 std::vector<Entity> PhysicsWorld::OverlapCapsule(const Capsule& capsule, CollisionLayer mask) {
     std::vector<Entity> result;
-    AABB bounds = capsule.GetBounds();
-    auto candidates = GetNearbyEntities(bounds, mask);
+    OverlapCapsule(capsule, result, mask);
+    return result;
+}
+
+void PhysicsWorld::OverlapCapsule(const Capsule& capsule, std::vector<Entity>& out, CollisionLayer mask) {
+    out.clear();
+    for (Entity entity : GatherCandidates(capsule.GetBounds(), mask)) {
+        if (CapsuleVsCollider(capsule, entity)) {
+            out.push_back(entity);
+        }
+    }
+}
+
+bool PhysicsWorld::OverlapCapsuleAny(const Capsule& capsule, CollisionLayer mask) {
+    for (Entity entity : GatherCandidates(capsule.GetBounds(), mask)) {
+        if (CapsuleVsCollider(capsule, entity)) return true;
+    }
+    return false;
+}
+
+bool PhysicsWorld::CapsuleVsCollider(const Capsule& capsule, Entity entity) {
+    auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
+    auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
+    if (!transform || !collider) return false;
     
-    for (Entity entity : candidates) {
-        auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
-        auto* collider = m_ecs->GetComponent<ColliderComponent>(entity);
-        if (!transform || !collider) continue;
-        
-        vec3 normal;
-        float penetration;
-        bool overlap = false;
-        
-        switch (collider->type) {
-            case ColliderType::Sphere: {
-                Sphere sphere = collider->GetWorldSphere(transform->position);
-                overlap = SphereVsCapsule(sphere, capsule, normal, penetration);
-                break;
-            }
-            case ColliderType::Box: {
-                AABB box = collider->GetWorldBounds(transform->position);
-                overlap = CapsuleVsAABB(capsule, box, normal, penetration);
-                break;
-            }
-            case ColliderType::Capsule: {
-                Capsule other = collider->GetWorldCapsule(transform->position);
-                overlap = CapsuleVsCapsule(capsule, other, normal, penetration);
-                break;
-            }
-            default:
-                break;
+    vec3 normal;
+    float penetration;
+    
+    switch (collider->type) {
+        case ColliderType::Sphere: {
+            Sphere sphere = collider->GetWorldSphere(transform->position);
+            return SphereVsCapsule(sphere, capsule, normal, penetration);
         }
-        
-        if (overlap) {
-            result.push_back(entity);
+        case ColliderType::Box: {
+            AABB box = collider->GetWorldBounds(transform->position);
+            return CapsuleVsAABB(capsule, box, normal, penetration);
+        }
+        case ColliderType::Capsule: {
+            Capsule other = collider->GetWorldCapsule(transform->position);
+            return CapsuleVsCapsule(capsule, other, normal, penetration);
         }
+        default:
+            return false;
     }
-    
-    return result;
 }
 
 Entity PhysicsWorld::PointTest(const vec3& point, CollisionLayer mask) {
     AABB bounds{point, point};
-    auto candidates = GetNearbyEntities(bounds, mask);
+    auto candidates = GatherCandidates(bounds, mask);
     
     for (Entity entity : candidates) {
         auto* transform = m_ecs->GetComponent<TransformComponent>(entity);
@@ -491,12 +839,9 @@ Entity PhysicsWorld::PointTest(const vec3& point, CollisionLayer mask) {
 // ===== Collision Detection =====
 
 bool PhysicsWorld::TestCollision(Entity a, Entity b, CollisionEvent& out_event) {
-    auto* transform_a = m_ecs->GetComponent<TransformComponent>(a);
     auto* collider_a = m_ecs->GetComponent<ColliderComponent>(a);
-    auto* transform_b = m_ecs->GetComponent<TransformComponent>(b);
     auto* collider_b = m_ecs->GetComponent<ColliderComponent>(b);
-    
-    if (!transform_a || !collider_a || !transform_b || !collider_b) return false;
+    if (!collider_a || !collider_b) return false;
     
     // Check layer masks
     if (!HasLayer(collider_a->mask, collider_b->layer) ||
@@ -504,6 +849,135 @@ bool PhysicsWorld::TestCollision(Entity a, Entity b, CollisionEvent& out_event)
         return false;
     }
     
+    return TestColliderPair(a, b, out_event);
+}
+
+void PhysicsWorld::DetectCollisions() {
+    RebuildCellEntries();
+    
+    // Only cells holding dynamic entries can produce pairs (static pairs never collide)
+    const std::vector<u32>& active_cells = m_dynamic_entries.occupied;
+    
+    // Broad + narrow phase, PAIR_CELLS_PER_JOB active cells per job into per-job buffers
+    u32 active_count = static_cast<u32>(active_cells.size());
+    u32 chunk_count = (active_count + PAIR_CELLS_PER_JOB - 1) / PAIR_CELLS_PER_JOB;
+    if (m_contact_chunks.size() < chunk_count) {
+        m_contact_chunks.resize(chunk_count);
+    }
+    
+    auto find_contacts = [this, &active_cells, active_count](u32 chunk) {
+        std::vector<CollisionEvent>& contacts = m_contact_chunks[chunk];
+        contacts.clear();
+        
+        u32 end = std::min((chunk + 1) * PAIR_CELLS_PER_JOB, active_count);
+        for (u32 i = chunk * PAIR_CELLS_PER_JOB; i < end; ++i) {
+            u32 cell = active_cells[i];
+            std::span<const CellEntry> dynamics = m_dynamic_entries.Get(cell);
+            std::span<const CellEntry> statics = m_static_entries.Get(cell);
+            u64 cell_key = m_cell_table.cell_keys[cell];
+            for (size_t a = 0; a < dynamics.size(); ++a) {
+                for (size_t b = a + 1; b < dynamics.size(); ++b) {
+                    TestCellPair(dynamics[a], dynamics[b], cell_key, contacts);
+                }
+                for (const CellEntry& other : statics) {
+                    TestCellPair(dynamics[a], other, cell_key, contacts);
+                }
+            }
+        }
+    };
+    
+    if (m_jobs && chunk_count > 1) {
+        m_jobs->Wait(m_jobs->ParallelFor(chunk_count, [&](u32 chunk, u32) { find_contacts(chunk); },
+                                         1, JobPriority::High));
+    } else {
+        for (u32 chunk = 0; chunk < chunk_count; ++chunk) {
+            find_contacts(chunk);
+        }
+    }
+    
+    m_contacts.clear();
+    for (u32 chunk = 0; chunk < chunk_count; ++chunk) {
+        m_contacts.insert(m_contacts.end(), m_contact_chunks[chunk].begin(), m_contact_chunks[chunk].end());
+    }
+    
+    auto pair_key = [](const CollisionEvent& event) {
+        return (static_cast<u64>(event.entity_a) << 32) | event.entity_b;
+    };
+    std::sort(m_contacts.begin(), m_contacts.end(), [&](const CollisionEvent& a, const CollisionEvent& b) {
+        return pair_key(a) < pair_key(b);
+    });
+    
+    // Merge with last frame's pairs: new -> Enter, both -> Stay, gone -> Exit
+    m_collision_events.clear();
+    m_new_pairs.clear();
+    auto emit_exit = [this](const ContactPair& gone) {
+        CollisionEvent& exit = m_collision_events.emplace_back();
+        exit.entity_a = gone.entity_a;
+        exit.entity_b = gone.entity_b;
+        exit.is_trigger = gone.is_trigger;
+        exit.phase = CollisionPhase::Exit;
+    };
+    
+    size_t previous = 0;
+    for (const CollisionEvent& contact : m_contacts) {
+        u64 key = pair_key(contact);
+        for (; previous < m_pairs.size() && m_pairs[previous].key < key; ++previous) {
+            emit_exit(m_pairs[previous]);
+        }
+        
+        bool stays = previous < m_pairs.size() && m_pairs[previous].key == key;
+        if (stays) ++previous;
+        
+        CollisionEvent& event = m_collision_events.emplace_back(contact);
+        event.phase = stays ? CollisionPhase::Stay : CollisionPhase::Enter;
+        m_new_pairs.push_back({key, contact.entity_a, contact.entity_b, contact.is_trigger});
+    }
+    for (; previous < m_pairs.size(); ++previous) {
+        emit_exit(m_pairs[previous]);
+    }
+    
+    m_pairs.swap(m_new_pairs);
+}
+
+void PhysicsWorld::TestCellPair(const CellEntry& a, const CellEntry& b, u64 cell_key,
+                                std::vector<CollisionEvent>& out_contacts) {
+    const ColliderProxy& proxy_a = m_proxies[a.slot];
+    const ColliderProxy& proxy_b = m_proxies[b.slot];
+    
+    // Pairs sharing several cells are taken in the first cell of the shared range only
+    ivec3 first{
+        std::max(proxy_a.min_cell.x, proxy_b.min_cell.x),
+        std::max(proxy_a.min_cell.y, proxy_b.min_cell.y),
+        std::max(proxy_a.min_cell.z, proxy_b.min_cell.z)
+    };
+    if (PackCell(first) != cell_key) return;
+    if (!ShouldCollide(proxy_a, proxy_b)) return;
+    
+    // Lower entity first, so a pair always has the same key and normal direction
+    Entity first_entity = std::min(a.entity, b.entity);
+    Entity second_entity = std::max(a.entity, b.entity);
+    CollisionEvent contact;
+    if (TestColliderPair(first_entity, second_entity, contact)) {
+        out_contacts.push_back(contact);
+    }
+}
+
+bool PhysicsWorld::ShouldCollide(const ColliderProxy& a, const ColliderProxy& b) {
+    if (a.is_trigger || b.is_trigger) {
+        return (a.is_trigger && HasLayer(a.mask, b.layer)) ||
+               (b.is_trigger && HasLayer(b.mask, a.layer));
+    }
+    return HasLayer(a.mask, b.layer) && HasLayer(b.mask, a.layer);
+}
+
+bool PhysicsWorld::TestColliderPair(Entity a, Entity b, CollisionEvent& out_event) {
+    auto* transform_a = m_ecs->GetComponent<TransformComponent>(a);
+    auto* collider_a = m_ecs->GetComponent<ColliderComponent>(a);
+    auto* transform_b = m_ecs->GetComponent<TransformComponent>(b);
+    auto* collider_b = m_ecs->GetComponent<ColliderComponent>(b);
+    
+    if (!transform_a || !collider_a || !transform_b || !collider_b) return false;
+    
     vec3 normal;
     float penetration;
     bool hit = false;
@@ -605,60 +1079,39 @@ ivec3 PhysicsWorld::PositionToCell(const vec3& pos) const {
     };
 }
 
-size_t PhysicsWorld::CellHash(const ivec3& cell) const {
-    // Simple spatial hash
-    size_t h = 0;
-    h ^= std::hash<i32>{}(cell.x) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    h ^= std::hash<i32>{}(cell.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    h ^= std::hash<i32>{}(cell.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
-    return h;
-}
-
-std::vector<ivec3> PhysicsWorld::GetOverlappingCells(const AABB& bounds) const {
-    std::vector<ivec3> cells;
-    
-    ivec3 min_cell = PositionToCell(bounds.min);
-    ivec3 max_cell = PositionToCell(bounds.max);
+void PhysicsWorld::BeginQuery() {
+    RebuildCellEntries();
     
-    for (i32 x = min_cell.x; x <= max_cell.x; ++x) {
-        for (i32 y = min_cell.y; y <= max_cell.y; ++y) {
-            for (i32 z = min_cell.z; z <= max_cell.z; ++z) {
-                cells.push_back({x, y, z});
-            }
-        }
+    if (++m_query.epoch == 0) {
+        // Wrapped: stamps from 2^32 queries ago would read as seen
+        std::fill(m_query.stamps.begin(), m_query.stamps.end(), 0);
+        m_query.epoch = 1;
     }
-    
-    return cells;
 }
 
-std::vector<Entity> PhysicsWorld::GetNearbyEntities(const AABB& bounds,
-                                                      CollisionLayer mask,
-                                                      Entity ignore) {
-    std::vector<Entity> result;
-    
-    auto cells = GetOverlappingCells(bounds);
-    
-    for (const ivec3& cell_coord : cells) {
-        size_t hash = CellHash(cell_coord);
-        auto it = m_cells.find(hash);
-        if (it == m_cells.end()) continue;
+std::span<const Entity> PhysicsWorld::GatherCandidates(const AABB& bounds,
+                                                        CollisionLayer mask,
+                                                        Entity ignore,
+                                                        bool hit_triggers) {
+    m_query.candidates.clear();
+    BeginQuery();
+    
+    ForEachOverlappingCell(bounds, [&](const ivec3& cell_coord) {
+        u32 cell = m_cell_table.Find(PackCell(cell_coord));
+        if (cell == INVALID_INDEX) return;
         
-        for (Entity entity : it->second.entities) {
-            if (entity == ignore) continue;
-            
-            // Check if already in result
-            if (std::find(result.begin(), result.end(), entity) != result.end()) continue;
-            
-            // Check layer
-            if (auto* collider = m_ecs->GetComponent<ColliderComponent>(entity)) {
-                if (HasLayer(mask, collider->layer)) {
-                    result.push_back(entity);
+        for (std::span<const CellEntry> entries : GetCellEntries(cell)) {
+            for (const CellEntry& entry : entries) {
+                if (entry.entity == ignore || !HasLayer(mask, entry.layer)) continue;
+                if (SkipsTrigger(entry, hit_triggers)) continue;
+                if (MarkSeen(entry)) {
+                    m_query.candidates.push_back(entry.entity);
                 }
             }
         }
-    }
+    });
     
-    return result;
+    return m_query.candidates;
 }
 
 // ===== Ray vs Shape Tests =====
@@ -4,16 +4,28 @@
 #include "core/math/math.h"
 #include "collision_shapes.h"
 #include "gameplay/ecs/ecs.h"
+#include <array>
+#include <span>
 #include <vector>
 #include <unordered_map>
 
 namespace action {
 
+class JobSystem;
+
 /*
  * PhysicsWorld - Spatial acceleration for collision queries
  * 
  * Uses a simple grid-based spatial hash for fast broad-phase.
  * Good enough for action games with moderate entity counts.
+ * 
+ * Static colliders (ColliderComponent::is_static) are inserted once: call
+ * RefreshCollider after moving one or changing its shape, layer or flags.
+ * Dynamic colliders are re-celled by UpdateSpatialHash. DetectCollisions
+ * reports enter/stay/exit events once per frame.
+ * 
+ * Queries skip trigger colliders unless asked, do not allocate once warmed
+ * up and are not thread-safe (one query at a time per world).
  */
 
 struct RaycastHit {
@@ -36,6 +48,23 @@ struct SweepHit {
     operator bool() const { return hit; }
 };
 
+// One ray of a batched query (AI line of sight, projectiles)
+struct RayQuery {
+    vec3 origin{0, 0, 0};
+    vec3 direction{0, 0, 1};
+    float max_distance = 1000.0f;
+    CollisionLayer mask = CollisionLayer::All;
+    Entity ignore = INVALID_ENTITY;
+    bool any_hit = false;  // Stop at the first hit found, not the closest (visibility tests)
+    bool hit_triggers = false;  // Also report trigger colliders
+};
+
+enum class CollisionPhase : u8 {
+    Enter,  // First frame the pair touches
+    Stay,
+    Exit    // First frame the pair no longer touches (contact data is zero)
+};
+
 // Collision event for scripts
 struct CollisionEvent {
     Entity entity_a = INVALID_ENTITY;
@@ -44,6 +73,7 @@ struct CollisionEvent {
     vec3 normal{0, 0, 0};
     float penetration = 0.0f;
     bool is_trigger = false;
+    CollisionPhase phase = CollisionPhase::Enter;
 };
 
 class PhysicsWorld {
@@ -54,25 +84,50 @@ public:
     bool Initialize(ECS* ecs, float cell_size = 4.0f);
     void Shutdown();
     
-    // Rebuild spatial hash (call after entities move)
+    // Update spatial hash (call after entities move): moves dynamic colliders
+    // that changed cells and inserts colliders added since the last update
     void UpdateSpatialHash();
     
     // Add/remove colliders from world
     void AddCollider(Entity entity);
     void RemoveCollider(Entity entity);
     
+    // Re-inserts a collider on the next update (static colliders that moved or changed)
+    void RefreshCollider(Entity entity);
+    
+    // Floating origin: re-cells every collider from its transform. Call after
+    // ECS::ShiftOrigin has moved the transforms by shift.
+    void ShiftOrigin(const vec3& shift);
+    
+    u32 GetColliderCount() const { return static_cast<u32>(m_collider_slots.size()); }
+    
+    // Dynamic colliders re-inserted by the last UpdateSpatialHash
+    u32 GetMovedColliderCount() const { return m_moved_count; }
+    
     // ===== Queries =====
     
-    // Raycast against all colliders
+    // Raycast against all colliders. Queries skip trigger colliders unless
+    // hit_triggers is set (sweeps and overlaps always skip them).
     RaycastHit Raycast(const vec3& origin, const vec3& direction, 
                        float max_distance = 1000.0f,
                        CollisionLayer mask = CollisionLayer::All,
-                       Entity ignore = INVALID_ENTITY);
+                       Entity ignore = INVALID_ENTITY,
+                       bool hit_triggers = false);
     
     // Raycast returning all hits
     std::vector<RaycastHit> RaycastAll(const vec3& origin, const vec3& direction,
                                         float max_distance = 1000.0f,
-                                        CollisionLayer mask = CollisionLayer::All);
+                                        CollisionLayer mask = CollisionLayer::All,
+                                        bool hit_triggers = false);
+    
+    // Batched raycasts: out_hits[i] is the result of rays[i] (out_hits must be at
+    // least as large). Any-hit rays report the first blocker found.
+    void RaycastBatch(std::span<const RayQuery> rays, std::span<RaycastHit> out_hits);
+    
+    // True if no collider blocks the segment from -> to
+    bool HasLineOfSight(const vec3& from, const vec3& to,
+                        CollisionLayer mask = CollisionLayer::All,
+                        Entity ignore = INVALID_ENTITY);
     
     // Sphere sweep (for projectiles, fast-moving objects)
     SweepHit SphereCast(const vec3& origin, float radius, const vec3& direction,
@@ -86,15 +141,24 @@ public:
                          CollisionLayer mask = CollisionLayer::All,
                          Entity ignore = INVALID_ENTITY);
     
-    // Overlap queries
+    // Overlap queries (the out forms clear out and keep its capacity)
     std::vector<Entity> OverlapSphere(const vec3& center, float radius,
                                        CollisionLayer mask = CollisionLayer::All);
+    void OverlapSphere(const vec3& center, float radius, std::vector<Entity>& out,
+                       CollisionLayer mask = CollisionLayer::All);
     
     std::vector<Entity> OverlapBox(const AABB& box,
                                     CollisionLayer mask = CollisionLayer::All);
+    void OverlapBox(const AABB& box, std::vector<Entity>& out,
+                    CollisionLayer mask = CollisionLayer::All);
     
     std::vector<Entity> OverlapCapsule(const Capsule& capsule,
                                         CollisionLayer mask = CollisionLayer::All);
+    void OverlapCapsule(const Capsule& capsule, std::vector<Entity>& out,
+                        CollisionLayer mask = CollisionLayer::All);
+    
+    // True if anything overlaps the capsule (stops at the first overlap)
+    bool OverlapCapsuleAny(const Capsule& capsule, CollisionLayer mask = CollisionLayer::All);
     
     // Check if a point is inside any collider
     Entity PointTest(const vec3& point, CollisionLayer mask = CollisionLayer::All);
@@ -104,33 +168,214 @@ public:
     // Test two entities for collision
     bool TestCollision(Entity a, Entity b, CollisionEvent& out_event);
     
-    // Get all collision events this frame
+    // Finds this frame's touching pairs and generates their events (call after
+    // UpdateSpatialHash). Runs on the job system when one is set.
+    void DetectCollisions();
+    
+    // Get all collision events this frame (entity_a < entity_b, ordered by pair)
     const std::vector<CollisionEvent>& GetCollisionEvents() const { return m_collision_events; }
     
+    // Pairs touching after the last DetectCollisions
+    u32 GetContactPairCount() const { return static_cast<u32>(m_pairs.size()); }
+    
+    // Optional: split pair finding across workers (serial without one)
+    void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+    
     // ===== Settings =====
     
     void SetGravity(const vec3& gravity) { m_gravity = gravity; }
     vec3 GetGravity() const { return m_gravity; }
     
 private:
-    // Spatial hash cell
-    struct Cell {
-        std::vector<Entity> entities;
+    // Collider in a cell; layer is cached at insertion for mask tests
+    struct CellEntry {
+        Entity entity = INVALID_ENTITY;
+        u32 slot = 0;  // Index into m_proxies and m_query.stamps
+        CollisionLayer layer = CollisionLayer::Default;
+    };
+    
+    static constexpr u32 INVALID_INDEX = ~0u;
+    
+    // Open-addressing map from packed cell coordinates to dense cell indices
+    // (linear probing, power-of-two capacity, at most half full). Cells are
+    // never removed, so indices stay valid until Clear; RebuildCellEntries
+    // clears it once most cells have no entries left.
+    struct CellTable {
+        static constexpr u64 EMPTY_KEY = ~0ull;  // Packed keys use 63 bits
+        
+        std::vector<u64> keys;       // Per bucket
+        std::vector<u32> cells;      // Per bucket: cell index
+        std::vector<u64> cell_keys;  // Per cell index
+        
+        static u32 HashKey(u64 key) {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdull;
+            key ^= key >> 33;
+            return static_cast<u32>(key);
+        }
+        
+        u32 Find(u64 key) const {
+            if (keys.empty()) return INVALID_INDEX;
+            u32 mask = static_cast<u32>(keys.size()) - 1;
+            for (u32 i = HashKey(key) & mask;; i = (i + 1) & mask) {
+                if (keys[i] == key) return cells[i];
+                if (keys[i] == EMPTY_KEY) return INVALID_INDEX;
+            }
+        }
+        
+        u32 FindOrAdd(u64 key);
+        void Clear();
+        u32 GetCellCount() const { return static_cast<u32>(cell_keys.size()); }
+    };
+    
+    // Cell entries in CSR form: the entries of cell c are
+    // entries[offsets[c], offsets[c + 1]). Cells added after the last
+    // rebuild have no entries yet.
+    struct CellEntryList {
+        std::vector<u32> offsets;
+        std::vector<CellEntry> entries;
+        std::vector<u32> occupied;  // Cells with entries, ascending
+        
+        std::span<const CellEntry> Get(u32 cell) const {
+            if (cell + 1 >= offsets.size()) return {};
+            return {entries.data() + offsets[cell], offsets[cell + 1] - offsets[cell]};
+        }
+    };
+    
+    // Counting sort input: one entry and its cell
+    struct CellBuildItem {
+        u32 cell;
+        CellEntry entry;
+    };
+    
+    // Registered collider. Its slot (index in m_proxies) is stable while registered.
+    struct ColliderProxy {
+        Entity entity = INVALID_ENTITY;  // INVALID_ENTITY: free slot
+        ivec3 min_cell;                  // Cell range (valid if in_grid)
+        ivec3 max_cell;
+        CollisionLayer layer = CollisionLayer::Default;
+        CollisionLayer mask = CollisionLayer::All;  // Collider mask and trigger flag, for pair filtering
+        bool is_trigger = false;
+        u32 dynamic_index = INVALID_INDEX;  // Position in m_dynamic_slots
+        bool is_static = false;
+        bool in_grid = false;  // Has entries in its CSR list (after the next rebuild)
+        bool pending = false;  // In m_pending_slots
+    };
+    
+    // Scratch state shared by all queries (reused, never shrunk)
+    struct QueryScratch {
+        std::vector<Entity> candidates;
+        std::vector<u32> stamps;  // Per collider slot: epoch of the last query that saw it
+        u32 epoch = 0;
     };
     
     // Convert position to cell coordinate
     ivec3 PositionToCell(const vec3& pos) const;
     
-    // Get cell hash from coordinates
-    size_t CellHash(const ivec3& cell) const;
+    // Table key of a cell coordinate
+    static u64 PackCell(const ivec3& cell) {
+        constexpr u64 mask = (1ull << 21) - 1;
+        return ((static_cast<u64>(static_cast<u32>(cell.x)) & mask) << 42) |
+               ((static_cast<u64>(static_cast<u32>(cell.y)) & mask) << 21) |
+               (static_cast<u64>(static_cast<u32>(cell.z)) & mask);
+    }
+    
+    // Entries of one cell: static, then dynamic
+    std::array<std::span<const CellEntry>, 2> GetCellEntries(u32 cell) const {
+        return {m_static_entries.Get(cell), m_dynamic_entries.Get(cell)};
+    }
+    
+    // Calls func(cell_coord) for every cell an AABB overlaps
+    template<typename Func>
+    void ForEachOverlappingCell(const AABB& bounds, Func&& func) const;
+    
+    template<typename Func>
+    void ForEachCellInRange(const ivec3& min_cell, const ivec3& max_cell, Func&& func) const;
+    
+    // Grid membership of one collider slot (marks its CSR list for rebuild)
+    void InsertIntoGrid(u32 slot, const ivec3& min_cell, const ivec3& max_cell, CollisionLayer layer);
+    void RemoveFromGrid(u32 slot);
+    
+    // Touching pair remembered between frames
+    struct ContactPair {
+        u64 key;  // entity_a << 32 | entity_b
+        Entity entity_a;
+        Entity entity_b;
+        bool is_trigger;
+    };
+    
+    // Cells (holding dynamic entries) per pair-finding job
+    static constexpr u32 PAIR_CELLS_PER_JOB = 256;
+    
+    // The cell table is rebuilt from the occupied cells once it holds more than
+    // CELL_TABLE_MIN_COMPACT cells and over CELL_TABLE_EMPTY_RATIO empty cells per
+    // occupied one (objects that wandered off leave empty cells behind)
+    static constexpr u32 CELL_TABLE_MIN_COMPACT = 4096;
+    static constexpr u32 CELL_TABLE_EMPTY_RATIO = 3;
+    
+    // Static slots checked for destroyed entities per update (round robin)
+    static constexpr u32 STATIC_SWEEP_PER_UPDATE = 1024;
+    
+    // Broad phase of one pair inside a cell; appends the contact if the shapes touch
+    void TestCellPair(const CellEntry& a, const CellEntry& b, u64 cell_key,
+                      std::vector<CollisionEvent>& out_contacts);
+    
+    // Layer/trigger filter of a candidate pair
+    static bool ShouldCollide(const ColliderProxy& a, const ColliderProxy& b);
+    
+    // Narrow phase without the mask test
+    bool TestColliderPair(Entity a, Entity b, CollisionEvent& out_event);
     
-    // Get all cells that an AABB overlaps
-    std::vector<ivec3> GetOverlappingCells(const AABB& bounds) const;
+    // Rebuilds the CSR lists marked dirty (both after compacting the cell table)
+    void RebuildCellEntries();
+    void BuildCellEntries(bool is_static);
     
-    // Get potential colliders near a point/bounds
-    std::vector<Entity> GetNearbyEntities(const AABB& bounds, 
-                                           CollisionLayer mask,
-                                           Entity ignore = INVALID_ENTITY);
+    // Takes a slot out of the grid and the dynamic/pending lists
+    void DetachProxy(u32 slot);
+    
+    // Detaches a slot, forgets its entity and frees the slot for reuse
+    void ReleaseProxy(u32 slot);
+    
+    // Releases static colliders whose entity was destroyed without RemoveCollider
+    void SweepDeadStatics();
+    
+    // Starts a query: applies removals/refreshes made since the last update and
+    // makes entries stamped before it count as unseen again
+    void BeginQuery();
+    
+    // First visit of the entry in the current query? (marks it seen)
+    bool MarkSeen(const CellEntry& entry) {
+        if (m_query.stamps[entry.slot] == m_query.epoch) return false;
+        m_query.stamps[entry.slot] = m_query.epoch;
+        return true;
+    }
+    
+    // Potential colliders near a point/bounds, each once. Valid until the next query.
+    std::span<const Entity> GatherCandidates(const AABB& bounds,
+                                             CollisionLayer mask,
+                                             Entity ignore = INVALID_ENTITY,
+                                             bool hit_triggers = false);
+    
+    // Visits the occupied cells the ray passes through, in order, as visit(cell_index, t_enter, t_exit)
+    // with t along the normalized direction; stops when visit returns false or at max_distance
+    template<typename Visitor>
+    void TraverseRayCells(const vec3& origin, const vec3& dir, float max_distance, Visitor&& visit) const;
+    
+    // Closest (or, with any_hit, first found) hit of one ray
+    RaycastHit CastRay(const vec3& origin, const vec3& dir, float max_distance,
+                       CollisionLayer mask, Entity ignore, bool any_hit, bool hit_triggers);
+    
+    // Trigger colliders only block queries that ask for them
+    bool SkipsTrigger(const CellEntry& entry, bool hit_triggers) const {
+        return !hit_triggers && m_proxies[entry.slot].is_trigger;
+    }
+    
+    // Ray against one entity's collider (false if it has none)
+    bool RayVsCollider(Entity entity, const vec3& origin, const vec3& dir,
+                       float max_dist, float& t, vec3& normal);
+    
+    // Capsule against one entity's collider (false if it has none)
+    bool CapsuleVsCollider(const Capsule& capsule, Entity entity);
     
     // Shape-specific collision tests
     bool RayVsSphere(const vec3& origin, const vec3& dir, const Sphere& sphere,
@@ -159,14 +404,35 @@ private:
     // Spatial hash
     float m_cell_size = 4.0f;
     float m_inv_cell_size = 0.25f;
-    std::unordered_map<size_t, Cell> m_cells;
-    
-    // All registered colliders
-    std::vector<Entity> m_colliders;
+    CellTable m_cell_table;
+    CellEntryList m_static_entries;
+    CellEntryList m_dynamic_entries;
+    bool m_static_dirty = false;
+    bool m_dynamic_dirty = false;
+    std::vector<CellBuildItem> m_build_items;  // Rebuild scratch
+    std::vector<u32> m_build_cursor;
+    
+    // All registered colliders, by slot
+    std::vector<ColliderProxy> m_proxies;
+    std::vector<u32> m_free_slots;
+    std::unordered_map<Entity, u32> m_collider_slots;
+    std::vector<u32> m_dynamic_slots;  // Checked by every update
+    std::vector<u32> m_pending_slots;  // Added or refreshed, not in the grid yet
+    u32 m_static_sweep_cursor = 0;
+    u32 m_moved_count = 0;
+    
+    QueryScratch m_query;
     
     // Collision events from this frame
     std::vector<CollisionEvent> m_collision_events;
     
+    // Pair finding: per-job contact buffers, this frame's contacts, last frame's pairs
+    JobSystem* m_jobs = nullptr;
+    std::vector<std::vector<CollisionEvent>> m_contact_chunks;
+    std::vector<CollisionEvent> m_contacts;
+    std::vector<ContactPair> m_pairs;      // Sorted by key
+    std::vector<ContactPair> m_new_pairs;
+    
     // Global settings
     vec3 m_gravity{0, -20.0f, 0};  // Slightly higher than real gravity for snappy feel
 };
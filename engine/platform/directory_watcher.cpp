@@ -0,0 +1,215 @@
+#include "directory_watcher.h"
+#include "core/logging.h"
+#include <filesystem>
+
+#ifdef PLATFORM_LINUX
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace action {
+
+#ifdef PLATFORM_LINUX
+
+namespace {
+
+constexpr u32 WATCH_MASK = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE |
+                           IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+// Event paths are built as <directory>/<name>, matching directory_iterator paths
+std::string TrimSeparators(std::string directory) {
+    while (directory.size() > 1 && directory.back() == '/') {
+        directory.pop_back();
+    }
+    return directory;
+}
+
+bool IsUnder(const std::string& path, const std::string& directory) {
+    return path.size() >= directory.size() && path.compare(0, directory.size(), directory) == 0 &&
+           (path.size() == directory.size() || path[directory.size()] == '/');
+}
+
+} // namespace
+
+bool DirectoryWatcher::IsSupported() {
+    return true;
+}
+
+bool DirectoryWatcher::Open() {
+    Close();
+
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        LOG_WARN("inotify_init1 failed: {}", std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void DirectoryWatcher::Close() {
+    std::lock_guard lock(m_mutex);
+    if (m_fd >= 0) {
+        ::close(m_fd);  // Drops every watch
+    }
+    m_fd = -1;
+    m_watches.clear();
+    m_overflow = false;
+}
+
+bool DirectoryWatcher::IsOpen() const {
+    return m_fd >= 0;
+}
+
+bool DirectoryWatcher::AddDirectory(const std::string& directory, bool recursive) {
+    std::lock_guard lock(m_mutex);
+    if (m_fd < 0) return false;
+
+    return AddWatch(TrimSeparators(directory), recursive, nullptr);
+}
+
+void DirectoryWatcher::RemoveDirectory(const std::string& directory) {
+    std::lock_guard lock(m_mutex);
+    RemoveWatchesUnder(TrimSeparators(directory));
+}
+
+bool DirectoryWatcher::AddWatch(const std::string& directory, bool recursive,
+                                std::vector<DirectoryChangeEvent>* out_existing) {
+    int wd = inotify_add_watch(m_fd, directory.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        // ENOSPC: fs.inotify.max_user_watches exhausted
+        LOG_WARN("inotify_add_watch failed for {}: {}", directory, std::strerror(errno));
+        return false;
+    }
+    m_watches[wd] = {directory, recursive};
+
+    if (!recursive && !out_existing) return true;
+
+    // Register subdirectories; for a directory that just appeared, also report the
+    // files that were written into it before its watch existed
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        std::string path = entry.path().string();
+        if (entry.is_directory(ec)) {
+            if (recursive) {
+                if (out_existing) {
+                    out_existing->push_back({path, DirectoryChange::Created, true, true});
+                }
+                if (!AddWatch(path, true, out_existing)) return false;
+            }
+        } else if (out_existing && entry.is_regular_file(ec)) {
+            out_existing->push_back({path, DirectoryChange::Created, false, true});
+        }
+    }
+    return true;
+}
+
+void DirectoryWatcher::RemoveWatchesUnder(const std::string& directory) {
+    for (auto it = m_watches.begin(); it != m_watches.end();) {
+        if (IsUnder(it->second.path, directory)) {
+            inotify_rm_watch(m_fd, it->first);
+            it = m_watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool DirectoryWatcher::Poll(u32 timeout_ms, std::vector<DirectoryChangeEvent>& out_events) {
+    if (m_fd < 0) return false;
+
+    pollfd descriptor{m_fd, POLLIN, 0};
+    int ready = poll(&descriptor, 1, static_cast<int>(timeout_ms));
+    if (ready < 0) return errno == EINTR;
+    if (ready == 0) return true;
+
+    alignas(inotify_event) char buffer[64 * 1024];
+    std::lock_guard lock(m_mutex);
+
+    while (true) {
+        ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EAGAIN || errno == EINTR) break;
+            LOG_ERROR("inotify read failed: {}", std::strerror(errno));
+            return false;
+        }
+        if (length == 0) break;
+
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                m_overflow = true;
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                m_watches.erase(event->wd);  // Directory deleted or unmounted
+                continue;
+            }
+
+            auto it = m_watches.find(event->wd);
+            if (it == m_watches.end() || event->len == 0) continue;
+
+            std::string path = it->second.path + "/" + event->name;
+            bool recursive = it->second.recursive;
+
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    out_events.push_back({path, DirectoryChange::Created, true, true});
+                    if (recursive) {
+                        AddWatch(path, true, &out_events);  // May rehash m_watches (it is not used after)
+                    }
+                } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    // Moved-away directories keep their watches; drop them with the subtree
+                    RemoveWatchesUnder(path);
+                    out_events.push_back({path, DirectoryChange::Deleted, true, false});
+                }
+                continue;
+            }
+
+            if (event->mask & IN_CREATE) {
+                out_events.push_back({path, DirectoryChange::Created, false, false});
+            } else if (event->mask & IN_MOVED_TO) {
+                out_events.push_back({path, DirectoryChange::Created, false, true});
+            } else if (event->mask & IN_MODIFY) {
+                out_events.push_back({path, DirectoryChange::Modified, false, false});
+            } else if (event->mask & IN_CLOSE_WRITE) {
+                out_events.push_back({path, DirectoryChange::Modified, false, true});
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                out_events.push_back({path, DirectoryChange::Deleted, false, false});
+            }
+        }
+    }
+    return true;
+}
+
+bool DirectoryWatcher::ConsumeOverflow() {
+    std::lock_guard lock(m_mutex);
+    bool overflow = m_overflow;
+    m_overflow = false;
+    return overflow;
+}
+
+u32 DirectoryWatcher::GetWatchCount() const {
+    std::lock_guard lock(m_mutex);
+    return static_cast<u32>(m_watches.size());
+}
+
+#else
+
+bool DirectoryWatcher::IsSupported() { return false; }
+bool DirectoryWatcher::Open() { return false; }
+void DirectoryWatcher::Close() {}
+bool DirectoryWatcher::IsOpen() const { return false; }
+bool DirectoryWatcher::AddDirectory(const std::string&, bool) { return false; }
+void DirectoryWatcher::RemoveDirectory(const std::string&) {}
+bool DirectoryWatcher::Poll(u32, std::vector<DirectoryChangeEvent>&) { return false; }
+bool DirectoryWatcher::ConsumeOverflow() { return false; }
+u32 DirectoryWatcher::GetWatchCount() const { return 0; }
+
+#endif
+
+} // namespace action
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/types.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace action {
+
+/*
+ * Directory Watcher - Kernel file change notifications (inotify on Linux)
+ *
+ * - Recursive watches: subdirectories are registered up front, and new ones
+ *   as they appear (files already inside a new directory are reported as Created)
+ * - Reports raw events; callers coalesce them (editors and exporters produce
+ *   several create/modify/close events per save)
+ * - Poll() runs on one thread; Add/Remove may be called from any thread
+ * - IsSupported() is false on other platforms: callers fall back to polling
+ *   file timestamps
+ */
+
+enum class DirectoryChange : u8 {
+    Created,
+    Modified,   // Data written; write_finished marks the writer closing the file
+    Deleted
+};
+
+struct DirectoryChangeEvent {
+    std::string path;
+    DirectoryChange change;
+    bool is_directory = false;
+    bool write_finished = false;  // IN_CLOSE_WRITE / moved into place
+};
+
+class DirectoryWatcher {
+public:
+    DirectoryWatcher() = default;
+    ~DirectoryWatcher() { Close(); }
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    static bool IsSupported();
+
+    bool Open();
+    void Close();
+    bool IsOpen() const;
+
+    bool AddDirectory(const std::string& directory, bool recursive);
+    void RemoveDirectory(const std::string& directory);
+
+    // Waits up to timeout_ms for events and appends them. Returns false when the
+    // watcher failed (caller should switch to polling).
+    bool Poll(u32 timeout_ms, std::vector<DirectoryChangeEvent>& out_events);
+
+    // Kernel queue overflowed since the last call: events were lost, rescan
+    bool ConsumeOverflow();
+
+    u32 GetWatchCount() const;
+
+private:
+#ifdef PLATFORM_LINUX
+    struct Watch {
+        std::string path;
+        bool recursive = false;
+    };
+
+    // Lock held
+    bool AddWatch(const std::string& directory, bool recursive, std::vector<DirectoryChangeEvent>* out_existing);
+    void RemoveWatchesUnder(const std::string& directory);
+
+    int m_fd = -1;
+    mutable std::mutex m_mutex;
+    std::unordered_map<int, Watch> m_watches;  // Watch descriptor -> directory
+    bool m_overflow = false;
+#endif
+};
+
+} // namespace action
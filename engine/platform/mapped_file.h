@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/types.h"
+#include <span>
+#include <string>
+
+namespace action {
+
+/*
+ * Mapped File - Read-only memory-mapped view of a file
+ * 
+ * - Pages come straight from the OS file cache, no copy into a heap buffer
+ * - Safe to use from worker threads (one instance per thread)
+ * - Closes the mapping on destruction; move-only
+ */
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    // prefetch: the whole file will be read (start readahead); off for random access
+    bool Open(const std::string& path, bool prefetch = true);
+    void Close();
+    
+    bool IsOpen() const { return m_data != nullptr; }
+    const u8* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    std::span<const u8> GetBytes() const { return {m_data, m_size}; }
+    
+private:
+    const u8* m_data = nullptr;
+    size_t m_size = 0;
+    
+#ifdef PLATFORM_WINDOWS
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+} // namespace action
@@ -365,6 +365,7 @@ SerialObject SceneSerializer::SerializeEditorNode(const EditorNode& node) {
     obj.type_name = "EditorNode";
     
     obj.Set("id", static_cast<i64>(node.id));
+    obj.Set("persistent_id", static_cast<i64>(node.persistent_id));
     obj.Set("entity", static_cast<i64>(node.entity));
     obj.Set("name", node.name);
     obj.Set("type", node.type);
@@ -406,6 +407,7 @@ EditorNode SceneSerializer::DeserializeEditorNode(const SerialObject& obj) {
     EditorNode node;
     
     node.id = static_cast<u32>(obj.Get<i64>("id", 0));
+    node.persistent_id = static_cast<u32>(obj.Get<i64>("persistent_id", 0));
     node.entity = static_cast<Entity>(obj.Get<i64>("entity", INVALID_ENTITY));
     node.name = obj.Get<std::string>("name", "Node");
     node.type = obj.Get<std::string>("type", "Node3D");
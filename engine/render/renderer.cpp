@@ -6,6 +6,7 @@
 #include <cstring>
 #include <cmath>
 #include <array>
+#include <cstddef>
 #include <vector>
 
 #ifdef PLATFORM_WINDOWS
@@ -210,6 +211,9 @@ void Renderer::Shutdown() {
     if (m_forward_pipeline != VK_NULL_HANDLE) {
         vkDestroyPipeline(device, m_forward_pipeline, nullptr);
     }
+    if (m_forward_packed_pipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(device, m_forward_packed_pipeline, nullptr);
+    }
     if (m_pipeline_layout != VK_NULL_HANDLE) {
         vkDestroyPipelineLayout(device, m_pipeline_layout, nullptr);
     }
@@ -1047,11 +1051,44 @@ bool Renderer::CreatePipelines() {
         return false;
     }
     
+    // Packed vertex variant (VertexFormat::Packed16): same state, 16-byte vertices
+    VkShaderModule packed_vert_module = LoadShaderModule("shaders/compiled/forward_packed_vert.spv");
+    if (packed_vert_module == VK_NULL_HANDLE) {
+        LOG_ERROR("Failed to load packed vertex shader");
+        vkDestroyShaderModule(device, vert_module, nullptr);
+        vkDestroyShaderModule(device, frag_module, nullptr);
+        return false;
+    }
+    shader_stages[0].module = packed_vert_module;
+    
+    VkVertexInputBindingDescription packed_binding = binding_desc;
+    packed_binding.stride = GetVertexStride(VertexFormat::Packed16);
+    
+    std::array<VkVertexInputAttributeDescription, 3> packed_attribs = attrib_descs;
+    packed_attribs[0].format = VK_FORMAT_R16G16B16A16_UNORM;  // Position + pad
+    packed_attribs[0].offset = offsetof(PackedVertex, position);
+    packed_attribs[1].format = VK_FORMAT_R16G16_SNORM;        // Octahedral normal
+    packed_attribs[1].offset = offsetof(PackedVertex, normal);
+    packed_attribs[2].format = VK_FORMAT_R16G16_SFLOAT;       // Half UV
+    packed_attribs[2].offset = offsetof(PackedVertex, uv);
+    
+    vertex_input.pVertexBindingDescriptions = &packed_binding;
+    vertex_input.pVertexAttributeDescriptions = packed_attribs.data();
+    
+    VkResult packed_result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr,
+                                                       &m_forward_packed_pipeline);
+    
     // Cleanup shader modules (no longer needed after pipeline creation)
+    vkDestroyShaderModule(device, packed_vert_module, nullptr);
     vkDestroyShaderModule(device, vert_module, nullptr);
     vkDestroyShaderModule(device, frag_module, nullptr);
     
-    LOG_INFO("Created forward rendering pipeline");
+    if (packed_result != VK_SUCCESS) {
+        LOG_ERROR("Failed to create packed vertex pipeline");
+        return false;
+    }
+    
+    LOG_INFO("Created forward rendering pipelines (float and packed vertices)");
     
     // ========================================
     // Create skybox pipeline
@@ -1923,31 +1960,46 @@ void Renderer::RecordCommandBuffer(u32 image_index, const RenderList& render_lis
     // Draw scene objects with forward pipeline
     // ========================================
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_forward_pipeline);
+    VertexFormat bound_format = VertexFormat::Float32;
     
     // Draw objects from render list
     if (m_assets) {
         u32 draw_count = 0;
         
         for (const auto& obj : render_list.opaque) {
-            MeshData* mesh = m_assets->GetMesh(obj.mesh);
+            const MeshGpuData* mesh = m_assets->GetMeshGpu(obj.mesh);
             if (!mesh || !mesh->uploaded) continue;
-            if (!mesh->gpu_vertex_buffer) continue;
+            if (!mesh->vertex_buffer) continue;
+            
+            // Pipeline variant follows the mesh's vertex layout (rebind only on change)
+            if (mesh->vertex_format != bound_format) {
+                bound_format = mesh->vertex_format;
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                  bound_format == VertexFormat::Packed16 ? m_forward_packed_pipeline
+                                                                         : m_forward_pipeline);
+            }
             
             // Cast void* handles back to VkBuffer
-            VkBuffer vertex_buffer = reinterpret_cast<VkBuffer>(mesh->gpu_vertex_buffer);
-            VkBuffer index_buffer = reinterpret_cast<VkBuffer>(mesh->gpu_index_buffer);
+            VkBuffer vertex_buffer = reinterpret_cast<VkBuffer>(mesh->vertex_buffer);
+            VkBuffer index_buffer = reinterpret_cast<VkBuffer>(mesh->index_buffer);
             
             // Bind mesh buffers
             VkBuffer vertex_buffers[] = {vertex_buffer};
             VkDeviceSize offsets[] = {0};
             vkCmdBindVertexBuffers(cmd, 0, 1, vertex_buffers, offsets);
-            vkCmdBindIndexBuffer(cmd, index_buffer, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdBindIndexBuffer(cmd, index_buffer, 0, mesh->index16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
             
             // Set push constants for this object
             PushConstants push{};
             push.model = obj.transform;
             push.normalMatrix = obj.transform;  // TODO: Proper normal matrix for non-uniform scale
             
+            // Packed positions are unorm within the mesh bounds
+            if (mesh->vertex_format == VertexFormat::Packed16) {
+                push.model = obj.transform * mat4::translate(mesh->position_offset) *
+                             mat4::scale(mesh->position_scale);
+            }
+            
             // Use object's color
             push.color = obj.color;
             
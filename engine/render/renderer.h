@@ -214,6 +214,7 @@ private:
     // Pipelines
     VkPipelineLayout m_pipeline_layout = VK_NULL_HANDLE;
     VkPipeline m_forward_pipeline = VK_NULL_HANDLE;
+    VkPipeline m_forward_packed_pipeline = VK_NULL_HANDLE;  // VertexFormat::Packed16 meshes
     VkPipeline m_skybox_pipeline = VK_NULL_HANDLE;
     VkPipeline m_grid_pipeline = VK_NULL_HANDLE;
     bool m_show_grid = true;  // Toggle for editor grid
@@ -14,6 +14,7 @@ Resource::Resource()
 Resource::Resource(const std::string& path)
     : m_id(s_next_id++)
     , m_path(path)
+    , m_path_id(StringID::Intern(path))
 {
 }
 
@@ -1,24 +1,32 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/string_id.h"
 #include <string>
 #include <memory>
 #include <atomic>
 #include <unordered_map>
+#include <vector>
 
 namespace action {
 
 // Forward declarations
 class ResourceLoader;
+class Resource;
+
+// Shared pointer type for resources
+template<typename T>
+using Ref = std::shared_ptr<T>;
 
 /*
  * Resource - Base class for all loadable assets (Godot-style)
  * 
  * Features:
  * - Reference counting for memory management
- * - Unique path for caching/deduplication
+ * - Unique path for caching/deduplication (cached by its interned StringID)
  * - Type identification
  * - Load/unload lifecycle
+ * - Dependency declarations (loaded by ResourceLoader before the resource is cached)
  */
 
 // Resource unique ID
@@ -46,7 +54,8 @@ public:
     // ===== Identification =====
     ResourceID GetID() const { return m_id; }
     const std::string& GetPath() const { return m_path; }
-    void SetPath(const std::string& path) { m_path = path; }
+    StringID GetPathID() const { return m_path_id; }
+    void SetPath(const std::string& path) { m_path = path; m_path_id = StringID::Intern(path); }
     
     // Type name for serialization
     virtual std::string GetTypeName() const { return "Resource"; }
@@ -75,6 +84,13 @@ public:
     virtual void Unload() {}
     virtual void Reload();
     
+    // ===== Dependencies =====
+    // Paths this resource needs (e.g. a material's textures), known once it is loaded.
+    // ResourceLoader loads them (in parallel for async loads) and hands each back
+    // through ResolveDependency before the resource is cached.
+    virtual std::vector<std::string> GetDependencies() const { return {}; }
+    virtual void ResolveDependency(const std::string& path, Ref<Resource> dependency) { (void)path; (void)dependency; }
+    
     // ===== Dirty State (for editor) =====
     bool IsDirty() const { return m_dirty; }
     void SetDirty(bool dirty = true) { m_dirty = dirty; }
@@ -97,16 +113,13 @@ private:
     
     ResourceID m_id = INVALID_RESOURCE_ID;
     std::string m_path;
+    StringID m_path_id;
     ResourceState m_state = ResourceState::Unloaded;
     bool m_dirty = false;
     
     std::unordered_map<std::string, std::string> m_import_settings;
 };
 
-// Shared pointer type for resources
-template<typename T>
-using Ref = std::shared_ptr<T>;
-
 // Helper to create resources
 template<typename T, typename... Args>
 Ref<T> MakeResource(Args&&... args) {
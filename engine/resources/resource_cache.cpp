@@ -1,5 +1,6 @@
 #include "resource_cache.h"
 #include "core/logging.h"
+#include "core/profiler.h"
 #include <algorithm>
 #include <cstdint>
 
@@ -7,7 +8,7 @@ namespace action {
 
 bool ResourceCache::Initialize(const ResourceCacheConfig& config) {
     m_config = config;
-    LOG_INFO("ResourceCache initialized (max: %zuMB)", config.max_memory / (1024 * 1024));
+    LOG_INFO("ResourceCache initialized (max: {}MB, {} shards)", config.max_memory / (1024 * 1024), SHARD_COUNT);
     return true;
 }
 
@@ -16,175 +17,304 @@ void ResourceCache::Shutdown() {
     LOG_INFO("ResourceCache shutdown");
 }
 
+ResourceCache::Shard& ResourceCache::GetShard(StringID path_id) const {
+    return m_shards[(path_id.GetHash() >> 32) & (SHARD_COUNT - 1)];
+}
+
+ResourceCache::IdShard& ResourceCache::GetIdShard(ResourceID id) const {
+    return m_id_shards[id & (SHARD_COUNT - 1)];
+}
+
 void ResourceCache::Add(Ref<Resource> resource) {
     if (!resource) return;
     
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    const std::string& path = resource->GetPath();
-    
-    // Check for duplicates
-    if (!m_config.allow_duplicates && !path.empty() && m_resources_by_path.count(path)) {
-        LOG_WARN("Resource already cached: %s", path.c_str());
-        return;
-    }
-    
-    CacheEntry entry;
-    entry.resource = resource;
-    entry.last_access_order = ++m_access_counter;
-    entry.memory_size = resource->GetMemoryUsage();
+    // Only path-addressable resources can be found again
+    StringID path_id = resource->GetPathID();
+    if (!path_id.IsValid()) return;
     
-    if (!path.empty()) {
-        m_resources_by_path[path] = entry;
+    Shard& shard = GetShard(path_id);
+    {
+        std::unique_lock lock(shard.mutex);
+        
+        auto existing = shard.entries.find(path_id);
+        if (existing != shard.entries.end()) {
+            // Check for duplicates
+            if (!m_config.allow_duplicates) {
+                LOG_WARN("Resource already cached: {}", resource->GetPath());
+                return;
+            }
+            EraseEntry(shard, existing);
+        }
+        
+        auto [it, inserted] = shard.entries.try_emplace(path_id);
+        CacheEntry& entry = it->second;
+        entry.resource = resource;
+        entry.memory_size = resource->GetMemoryUsage();
+        entry.path_id = path_id;
+        shard.probation.PushBack(&entry);
+        
+        m_memory_usage.fetch_add(entry.memory_size, std::memory_order_relaxed);
+        m_resource_count.fetch_add(1, std::memory_order_relaxed);
+        
+        IdShard& id_shard = GetIdShard(resource->GetID());
+        {
+            std::lock_guard id_lock(id_shard.mutex);
+            id_shard.paths[resource->GetID()] = path_id;
+        }
+        IndexType(resource.get());
     }
-    m_path_by_id[resource->GetID()] = path;
     
-    m_memory_usage += entry.memory_size;
-    
-    // Check if we need to GC
-    if (m_memory_usage > m_config.gc_threshold) {
-        GarbageCollect();
+    // Over the threshold: evict least recently used down to the target (one thread at
+    // a time; the others keep adding)
+    if (m_memory_usage.load(std::memory_order_relaxed) > m_config.gc_threshold &&
+        !m_evicting.exchange(true, std::memory_order_acquire)) {
+        size_t target = static_cast<size_t>(m_config.max_memory * m_config.gc_target_ratio);
+        EvictToMemory(std::min(target, m_config.gc_threshold));
+        m_evicting.store(false, std::memory_order_release);
+        
+        size_t usage = m_memory_usage.load(std::memory_order_relaxed);
+        if (usage > m_config.max_memory) {
+            LOG_WARN("ResourceCache over budget: {}MB held outside the cache", usage / (1024 * 1024));
+        }
     }
 }
 
-Ref<Resource> ResourceCache::Get(const std::string& path) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+Ref<Resource> ResourceCache::Get(StringID path_id) const {
+    Shard& shard = GetShard(path_id);
+    std::shared_lock lock(shard.mutex);
     
-    auto it = m_resources_by_path.find(path);
-    if (it != m_resources_by_path.end()) {
-        // Update access order for LRU tracking (m_access_counter is mutable)
-        const_cast<CacheEntry&>(it->second).last_access_order = ++m_access_counter;
-        return it->second.resource;
-    }
+    auto it = shard.entries.find(path_id);
+    if (it == shard.entries.end()) return nullptr;
     
-    return nullptr;
+    // Readers only set the reference bit; skip the store if it is already set (no cache line ping-pong)
+    if (!it->second.referenced.load(std::memory_order_relaxed)) {
+        it->second.referenced.store(true, std::memory_order_relaxed);
+    }
+    return it->second.resource;
 }
 
-bool ResourceCache::Has(const std::string& path) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_resources_by_path.count(path) > 0;
+bool ResourceCache::Has(StringID path_id) const {
+    Shard& shard = GetShard(path_id);
+    std::shared_lock lock(shard.mutex);
+    return shard.entries.find(path_id) != shard.entries.end();
 }
 
-void ResourceCache::Remove(const std::string& path) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+void ResourceCache::Remove(StringID path_id) {
+    Shard& shard = GetShard(path_id);
+    std::unique_lock lock(shard.mutex);
     
-    auto it = m_resources_by_path.find(path);
-    if (it != m_resources_by_path.end()) {
-        m_memory_usage -= it->second.memory_size;
-        m_path_by_id.erase(it->second.resource->GetID());
-        m_resources_by_path.erase(it);
+    auto it = shard.entries.find(path_id);
+    if (it != shard.entries.end()) {
+        EraseEntry(shard, it);
     }
 }
 
 void ResourceCache::Remove(ResourceID id) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    auto path_it = m_path_by_id.find(id);
-    if (path_it != m_path_by_id.end()) {
-        auto res_it = m_resources_by_path.find(path_it->second);
-        if (res_it != m_resources_by_path.end()) {
-            m_memory_usage -= res_it->second.memory_size;
-            m_resources_by_path.erase(res_it);
-        }
-        m_path_by_id.erase(path_it);
+    StringID path_id;
+    {
+        IdShard& id_shard = GetIdShard(id);
+        std::lock_guard lock(id_shard.mutex);
+        
+        auto path_it = id_shard.paths.find(id);
+        if (path_it == id_shard.paths.end()) return;
+        path_id = path_it->second;
+    }
+    
+    Shard& shard = GetShard(path_id);
+    std::unique_lock lock(shard.mutex);
+    
+    // The path may have been re-cached with another resource in between
+    auto it = shard.entries.find(path_id);
+    if (it != shard.entries.end() && it->second.resource->GetID() == id) {
+        EraseEntry(shard, it);
     }
 }
 
 void ResourceCache::Clear() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_resources_by_path.clear();
-    m_path_by_id.clear();
-    m_memory_usage = 0;
+    for (Shard& shard : m_shards) {
+        std::unique_lock lock(shard.mutex);
+        shard.entries.clear();
+        shard.probation = {};
+        shard.protected_segment = {};
+    }
+    for (IdShard& id_shard : m_id_shards) {
+        std::lock_guard lock(id_shard.mutex);
+        id_shard.paths.clear();
+    }
+    {
+        std::unique_lock lock(m_type_mutex);
+        m_types.clear();
+    }
+    m_memory_usage.store(0, std::memory_order_relaxed);
+    m_resource_count.store(0, std::memory_order_relaxed);
 }
 
-void ResourceCache::GarbageCollect() {
-    // Remove resources with no external references
-    std::vector<std::string> to_remove;
+void ResourceCache::EraseEntry(Shard& shard, std::unordered_map<StringID, CacheEntry>::iterator it) {
+    CacheEntry& entry = it->second;
+    (entry.is_protected ? shard.protected_segment : shard.probation).Unlink(&entry);
     
-    for (const auto& [path, entry] : m_resources_by_path) {
-        // shared_ptr use_count of 1 means only cache holds the reference
-        if (entry.resource.use_count() == 1) {
-            to_remove.push_back(path);
-        }
+    // Keep the resource alive until it is out of the type index
+    Ref<Resource> resource = std::move(it->second.resource);
+    m_memory_usage.fetch_sub(it->second.memory_size, std::memory_order_relaxed);
+    m_resource_count.fetch_sub(1, std::memory_order_relaxed);
+    shard.entries.erase(it);
+    
+    IdShard& id_shard = GetIdShard(resource->GetID());
+    {
+        std::lock_guard lock(id_shard.mutex);
+        id_shard.paths.erase(resource->GetID());
+    }
+    UnindexType(resource.get());
+}
+
+void ResourceCache::IndexType(Resource* resource) {
+    std::unique_lock lock(m_type_mutex);
+    m_types[std::type_index(typeid(*resource))].resources[resource->GetID()] = resource;
+}
+
+void ResourceCache::UnindexType(Resource* resource) {
+    std::unique_lock lock(m_type_mutex);
+    auto it = m_types.find(std::type_index(typeid(*resource)));
+    if (it != m_types.end()) {
+        it->second.resources.erase(resource->GetID());
     }
+}
+
+void ResourceCache::GarbageCollect() {
+    PROFILE_SCOPE("ResourceCache::GarbageCollect");
     
-    for (const auto& path : to_remove) {
-        auto it = m_resources_by_path.find(path);
-        if (it != m_resources_by_path.end()) {
-            m_memory_usage -= it->second.memory_size;
-            m_path_by_id.erase(it->second.resource->GetID());
-            m_resources_by_path.erase(it);
+    // Remove resources with no external references
+    size_t removed = 0;
+    for (Shard& shard : m_shards) {
+        std::unique_lock lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            // shared_ptr use_count of 1 means only cache holds the reference
+            if (it->second.resource.use_count() == 1) {
+                auto next = std::next(it);
+                EraseEntry(shard, it);
+                it = next;
+                removed++;
+            } else {
+                ++it;
+            }
         }
     }
     
-    if (!to_remove.empty()) {
-        LOG_DEBUG("GC: removed %zu unreferenced resources", to_remove.size());
+    if (removed > 0) {
+        LOG_DEBUG("GC: removed {} unreferenced resources", removed);
     }
     
     // If still over limit, evict LRU
-    if (m_memory_usage > m_config.gc_threshold) {
+    if (m_memory_usage.load(std::memory_order_relaxed) > m_config.gc_threshold) {
         size_t target = static_cast<size_t>(m_config.max_memory * m_config.gc_target_ratio);
         EvictToMemory(target);
     }
 }
 
 void ResourceCache::EvictToMemory(size_t target_bytes) {
-    if (m_memory_usage <= target_bytes) return;
-
-    // Sort by last access order
-    std::vector<std::pair<std::string, u64>> entries;
-    for (const auto& [path, entry] : m_resources_by_path) {
-        // Only evict resources with single reference (cache only)
-        if (entry.resource.use_count() == 1) {
-            entries.emplace_back(path, entry.last_access_order);
+    PROFILE_SCOPE("ResourceCache::EvictToMemory");
+    
+    size_t usage = m_memory_usage.load(std::memory_order_relaxed);
+    if (usage <= target_bytes) return;
+    size_t overflow = usage - target_bytes;
+    
+    // First pass: each shard frees its share of the overflow, in proportion to its
+    // size, from its probationary segment only; the working set stays protected
+    u32 start = m_sweep_shard.fetch_add(1, std::memory_order_relaxed);
+    for (u32 i = 0; i < SHARD_COUNT; i++) {
+        Shard& shard = m_shards[(start + i) & (SHARD_COUNT - 1)];
+        std::unique_lock lock(shard.mutex);
+        
+        size_t shard_bytes = shard.probation.bytes + shard.protected_segment.bytes;
+        size_t share = static_cast<size_t>(static_cast<double>(overflow) * shard_bytes / usage);
+        if (share > 0) {
+            EvictFromShard(shard, share, false);
         }
     }
-
-    // Sort oldest first (lowest access counter = least recently used)
-    std::sort(entries.begin(), entries.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
     
-    // Evict until under target
-    for (const auto& [path, _] : entries) {
-        if (m_memory_usage <= target_bytes) break;
+    // Second pass: shards that could not pay their share (entries in use or protected)
+    // are covered by the rest, demoting protected entries past protected_ratio
+    for (u32 i = 0; i < SHARD_COUNT; i++) {
+        size_t current = m_memory_usage.load(std::memory_order_relaxed);
+        if (current <= target_bytes) break;
         
-        auto it = m_resources_by_path.find(path);
-        if (it != m_resources_by_path.end()) {
-            m_memory_usage -= it->second.memory_size;
-            m_path_by_id.erase(it->second.resource->GetID());
-            m_resources_by_path.erase(it);
-        }
+        Shard& shard = m_shards[(start + i) & (SHARD_COUNT - 1)];
+        std::unique_lock lock(shard.mutex);
+        EvictFromShard(shard, current - target_bytes, true);
     }
 }
 
-void ResourceCache::EvictLRU() {
-    // Find oldest entry with single reference
-    u64 oldest_order = UINT64_MAX;
-    std::string oldest_path;
-
-    for (const auto& [path, entry] : m_resources_by_path) {
-        if (entry.resource.use_count() == 1 && entry.last_access_order < oldest_order) {
-            oldest_order = entry.last_access_order;
-            oldest_path = path;
+size_t ResourceCache::EvictFromShard(Shard& shard, size_t bytes_to_free, bool demote) {
+    size_t freed = 0;
+    
+    // Every step moves or evicts one entry; an entry is examined at most twice per
+    // call (once in each segment), which bounds the work when everything is in use
+    size_t steps = shard.entries.size() * 2;
+    while (freed < bytes_to_free && steps-- > 0) {
+        // Keep the protected segment within its share; its LRU end drops to probation
+        // unless it was used again since its promotion
+        size_t shard_bytes = shard.probation.bytes + shard.protected_segment.bytes;
+        size_t protected_capacity = static_cast<size_t>(shard_bytes * m_config.protected_ratio);
+        CacheEntry* entry = shard.probation.head;
+        if (!entry || (demote && shard.protected_segment.bytes > protected_capacity)) {
+            CacheEntry* demoted = shard.protected_segment.head;
+            if (!demoted || !demote) break;
+            
+            shard.protected_segment.Unlink(demoted);
+            if (demoted->referenced.exchange(false, std::memory_order_relaxed)) {
+                shard.protected_segment.PushBack(demoted);
+            } else {
+                demoted->is_protected = false;
+                shard.probation.PushBack(demoted);
+            }
+            continue;
+        }
+        
+        // Only evict resources with single reference (cache only) that were not used
+        // since they entered probation
+        if (entry->resource.use_count() == 1 && !entry->referenced.load(std::memory_order_relaxed)) {
+            freed += entry->memory_size;
+            EraseEntry(shard, shard.entries.find(entry->path_id));
+            continue;
+        }
+        
+        shard.probation.Unlink(entry);
+        if (entry->referenced.exchange(false, std::memory_order_relaxed)) {
+            entry->is_protected = true;
+            shard.protected_segment.PushBack(entry);
+        } else {
+            shard.probation.PushBack(entry);  // In use: retry after the rest
         }
     }
+    return freed;
+}
 
-    if (!oldest_path.empty()) {
-        // Inline removal to avoid deadlock (caller may hold m_mutex)
-        auto it = m_resources_by_path.find(oldest_path);
-        if (it != m_resources_by_path.end()) {
-            m_memory_usage -= it->second.memory_size;
-            m_path_by_id.erase(it->second.resource->GetID());
-            m_resources_by_path.erase(it);
-        }
+void ResourceCache::SegmentList::PushBack(CacheEntry* entry) {
+    entry->prev = tail;
+    entry->next = nullptr;
+    if (tail) {
+        tail->next = entry;
+    } else {
+        head = entry;
     }
+    tail = entry;
+    bytes += entry->memory_size;
 }
 
-void ResourceCache::UpdateMemoryUsage() {
-    m_memory_usage = 0;
-    for (const auto& [path, entry] : m_resources_by_path) {
-        m_memory_usage += entry.resource->GetMemoryUsage();
+void ResourceCache::SegmentList::Unlink(CacheEntry* entry) {
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        tail = entry->prev;
     }
+    entry->prev = nullptr;
+    entry->next = nullptr;
+    bytes -= entry->memory_size;
 }
 
 } // namespace action
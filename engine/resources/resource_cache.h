@@ -1,9 +1,13 @@
 #pragma once
 
 #include "resource.h"
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
 #include <typeindex>
+#include <vector>
 
 namespace action {
 
@@ -11,10 +15,29 @@ namespace action {
  * ResourceCache - Caches loaded resources for reuse (Godot-style)
  * 
  * Features:
- * - Path-based caching (same path = same resource)
+ * - Path-based caching (same path = same resource), keyed by the path's
+ *   StringID: lookups by ID hash nothing, lookups by string hash it once
  * - Automatic reference counting
- * - LRU eviction when memory limit reached
+ * - Segmented LRU eviction when memory limit reached
  * - Type-safe resource retrieval
+ * 
+ * Concurrency:
+ * - Entries are split over SHARD_COUNT shards by path ID, each with its own
+ *   reader/writer lock; Get/Has take a shared lock on one shard only
+ * - Recency is a per-entry reference bit set on Get (no global counter, no
+ *   list updates under the shared lock)
+ * 
+ * Eviction (segmented LRU, per shard, intrusive lists):
+ * - New entries enter the probationary segment; the eviction scan promotes
+ *   entries referenced since insertion to the protected segment, so one-off
+ *   loads never push out the working set
+ * - The protected segment is capped at protected_ratio of the shard's bytes;
+ *   its least recently promoted entries drop back to probation
+ * - Crossing gc_threshold evicts down to gc_target_ratio * max_memory,
+ *   each shard first giving up its share of the overflow from probation. Cost is
+ *   proportional to the entries examined, not to the cache size.
+ * - Per-type index: GetResourcesOfType visits only the matching types'
+ *   resources, with one dynamic_cast per type instead of per entry
  */
 
 struct ResourceCacheConfig {
@@ -22,10 +45,13 @@ struct ResourceCacheConfig {
     size_t gc_threshold = 400_MB;        // Start GC when this is reached
     float gc_target_ratio = 0.7f;        // Target 70% after GC
     bool allow_duplicates = false;       // Allow same path multiple times
+    float protected_ratio = 0.8f;        // Share of each shard's bytes in the protected LRU segment
 };
 
 class ResourceCache {
 public:
+    static constexpr u32 SHARD_COUNT = 16;  // Power of two
+    
     ResourceCache() = default;
     ~ResourceCache() = default;
     
@@ -38,20 +64,25 @@ public:
     void Add(Ref<Resource> resource);
     
     // Get a cached resource by path (nullptr if not cached)
-    Ref<Resource> Get(const std::string& path) const;
+    Ref<Resource> Get(StringID path_id) const;
+    Ref<Resource> Get(const std::string& path) const { return Get(StringID(path)); }
     
     // Get typed resource
     template<typename T>
-    Ref<T> GetAs(const std::string& path) const {
-        Ref<Resource> res = Get(path);
+    Ref<T> GetAs(StringID path_id) const {
+        Ref<Resource> res = Get(path_id);
         return res ? std::dynamic_pointer_cast<T>(res) : nullptr;
     }
+    template<typename T>
+    Ref<T> GetAs(const std::string& path) const { return GetAs<T>(StringID(path)); }
     
     // Check if resource is cached
-    bool Has(const std::string& path) const;
+    bool Has(StringID path_id) const;
+    bool Has(const std::string& path) const { return Has(StringID(path)); }
     
     // Remove from cache
-    void Remove(const std::string& path);
+    void Remove(StringID path_id);
+    void Remove(const std::string& path) { Remove(StringID(path)); }
     void Remove(ResourceID id);
     
     // Clear all cached resources
@@ -60,55 +91,112 @@ public:
     // ===== Memory Management =====
     
     // Get total memory used by cached resources
-    size_t GetMemoryUsage() const { return m_memory_usage; }
+    size_t GetMemoryUsage() const { return m_memory_usage.load(std::memory_order_relaxed); }
     size_t GetMaxMemory() const { return m_config.max_memory; }
     
-    // Run garbage collection (remove unreferenced resources)
+    // Run garbage collection (remove every unreferenced resource; full scan)
     void GarbageCollect();
     
-    // Force evict resources to reach target memory
+    // Evict unreferenced resources, least recently used first, to reach target memory
     void EvictToMemory(size_t target_bytes);
     
     // ===== Statistics =====
-    size_t GetResourceCount() const { return m_resources_by_path.size(); }
+    size_t GetResourceCount() const { return m_resource_count.load(std::memory_order_relaxed); }
     
     // Get all resources of a specific type
     template<typename T>
     std::vector<Ref<T>> GetResourcesOfType() const;
     
-    // Iterate all cached resources
+    // Iterate all cached resources (one shard locked at a time; func must not modify the cache)
     template<typename Func>
     void ForEach(Func&& func) const;
-    
+
 private:
     struct CacheEntry {
         Ref<Resource> resource;
-        u64 last_access_order = 0;
         size_t memory_size = 0;
+        mutable std::atomic<bool> referenced{false};  // Set by Get under a shared lock
+        
+        // Segment list links (shard lock held); map nodes never move
+        CacheEntry* prev = nullptr;
+        CacheEntry* next = nullptr;
+        StringID path_id;
+        bool is_protected = false;
+    };
+    
+    // Doubly-linked list, least recently used at head
+    struct SegmentList {
+        CacheEntry* head = nullptr;
+        CacheEntry* tail = nullptr;
+        size_t bytes = 0;
+        
+        void PushBack(CacheEntry* entry);
+        void Unlink(CacheEntry* entry);
+    };
+    
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<StringID, CacheEntry> entries;
+        SegmentList probation;
+        SegmentList protected_segment;
+    };
+    
+    // Resource id -> path id, striped separately: taken inside a path shard lock,
+    // never the other way
+    struct IdShard {
+        std::mutex mutex;
+        std::unordered_map<ResourceID, StringID> paths;
+    };
+    
+    // Resources of one dynamic type, keyed by id. Non-owning: entries are
+    // unindexed before the cache drops its reference.
+    struct TypeBucket {
+        std::unordered_map<ResourceID, Resource*> resources;
     };
     
-    void UpdateMemoryUsage();
-    void EvictLRU();
+    Shard& GetShard(StringID path_id) const;
+    IdShard& GetIdShard(ResourceID id) const;
+    
+    // Shard lock held: unlinks the entry and its id/type index records
+    void EraseEntry(Shard& shard, std::unordered_map<StringID, CacheEntry>::iterator it);
+    void IndexType(Resource* resource);
+    void UnindexType(Resource* resource);
+    
+    // Shard lock held: evicts unreferenced (cache-only) entries, least recently used
+    // first, until bytes_to_free are freed or every entry was examined twice. With
+    // demote, protected entries beyond protected_ratio fall back to probation first.
+    // Returns bytes freed.
+    size_t EvictFromShard(Shard& shard, size_t bytes_to_free, bool demote);
     
     ResourceCacheConfig m_config;
     
-    mutable std::mutex m_mutex;
-    std::unordered_map<std::string, CacheEntry> m_resources_by_path;
-    std::unordered_map<ResourceID, std::string> m_path_by_id;
+    mutable std::array<Shard, SHARD_COUNT> m_shards;
+    mutable std::array<IdShard, SHARD_COUNT> m_id_shards;
+    std::atomic<u32> m_sweep_shard{0};  // Shard the next eviction starts at
     
-    size_t m_memory_usage = 0;
-    mutable u64 m_access_counter = 0;  // Monotonic counter for LRU ordering
+    mutable std::shared_mutex m_type_mutex;
+    std::unordered_map<std::type_index, TypeBucket> m_types;
+    
+    std::atomic<size_t> m_memory_usage{0};
+    std::atomic<size_t> m_resource_count{0};
+    std::atomic<bool> m_evicting{false};  // One threshold eviction at a time; other adders skip it
 };
 
 // Template implementations
 template<typename T>
 std::vector<Ref<T>> ResourceCache::GetResourcesOfType() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_lock lock(m_type_mutex);
     std::vector<Ref<T>> result;
     
-    for (const auto& [path, entry] : m_resources_by_path) {
-        if (Ref<T> typed = std::dynamic_pointer_cast<T>(entry.resource)) {
-            result.push_back(typed);
+    for (const auto& [type, bucket] : m_types) {
+        if (bucket.resources.empty()) continue;
+        
+        // Every resource in a bucket has the same dynamic type: test one
+        if (!dynamic_cast<T*>(bucket.resources.begin()->second)) continue;
+        
+        result.reserve(result.size() + bucket.resources.size());
+        for (const auto& [id, resource] : bucket.resources) {
+            result.push_back(std::static_pointer_cast<T>(resource->shared_from_this()));
         }
     }
     
@@ -117,9 +205,11 @@ std::vector<Ref<T>> ResourceCache::GetResourcesOfType() const {
 
 template<typename Func>
 void ResourceCache::ForEach(Func&& func) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (const auto& [path, entry] : m_resources_by_path) {
-        func(entry.resource);
+    for (const Shard& shard : m_shards) {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [path_id, entry] : shard.entries) {
+            func(entry.resource);
+        }
     }
 }
 
@@ -1,10 +1,31 @@
 #include "resource_loader.h"
+#include "resource_types.h"
 #include "core/logging.h"
+#include "core/profiler.h"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
 
 namespace action {
 
+namespace {
+
+// Paths being loaded synchronously on this thread, outermost first (dependency cycle guard)
+thread_local std::vector<std::string> t_load_chain;
+
+bool InChain(const std::vector<std::string>& chain, const std::string& path) {
+    return std::find(chain.begin(), chain.end(), path) != chain.end();
+}
+
+// Loader for resource types whose Load() reads their own path
+template<typename T>
+Ref<Resource> LoadResourceOfType(const std::string& path) {
+    Ref<T> resource = MakeResource<T>(path);
+    return resource->Load() ? resource : nullptr;
+}
+
+} // namespace
+
 bool ResourceLoader::Initialize(ResourceCache& cache, const ResourceLoaderConfig& config) {
     m_cache = &cache;
     m_config = config;
@@ -14,6 +35,7 @@ bool ResourceLoader::Initialize(ResourceCache& cache, const ResourceLoaderConfig
 }
 
 void ResourceLoader::Shutdown() {
+    WaitForAsyncLoads();
     m_loaders.clear();
     m_type_map.clear();
     m_cache = nullptr;
@@ -30,7 +52,7 @@ void ResourceLoader::RegisterLoader(const std::string& extension, LoaderFunc loa
     for (auto& c : ext) c = static_cast<char>(std::tolower(c));
     
     m_loaders[ext] = loader;
-    LOG_DEBUG("Registered loader for extension: %s", ext.c_str());
+    LOG_DEBUG("Registered loader for extension: {}", ext);
 }
 
 void ResourceLoader::RegisterLoader(const std::vector<std::string>& extensions, LoaderFunc loader) {
@@ -39,15 +61,43 @@ void ResourceLoader::RegisterLoader(const std::vector<std::string>& extensions,
     }
 }
 
+void ResourceLoader::RegisterDefaultLoaders() {
+    RegisterLoader(".mat", LoadResourceOfType<MaterialResource>);
+    RegisterLoader({".png", ".jpg", ".jpeg", ".tga", ".ktx2"}, LoadResourceOfType<TextureResource>);
+    
+    m_type_map[".mat"] = MaterialResource::GetStaticTypeName();
+    for (const char* ext : {".png", ".jpg", ".jpeg", ".tga", ".ktx2"}) {
+        m_type_map[ext] = TextureResource::GetStaticTypeName();
+    }
+}
+
 Ref<Resource> ResourceLoader::Load(const std::string& path) {
+    StringID path_id(path);
+    Ref<Resource> cached;
+    if (!BeginLoad(path_id, cached)) {
+        return cached;
+    }
+    
+    // --- Load from disk (without holding the mutex) ---
+    Ref<Resource> resource = LoadInternal(path);
+    if (resource) {
+        LoadDependencies(*resource);
+    }
+    
+    FinishLoad(path_id, resource);
+    return resource;
+}
+
+bool ResourceLoader::BeginLoad(StringID path_id, Ref<Resource>& out_cached) {
     // Fast path: check cache without taking the load mutex.
     // ResourceCache::Get() is thread-safe (has its own internal mutex).
     if (m_config.use_cache && m_cache) {
-        if (Ref<Resource> cached = m_cache->Get(path)) {
-            return cached;
+        if (Ref<Resource> cached = m_cache->Get(path_id)) {
+            out_cached = std::move(cached);
+            return false;
         }
     }
-
+    
     // -----------------------------------------------------------------------
     // TOCTOU-safe serialization for concurrent loads of the same path.
     //
@@ -55,65 +105,316 @@ Ref<Resource> ResourceLoader::Load(const std::string& path) {
     // both call LoadInternal(), and end up with two distinct Resource objects
     // for the same file -- only one of which gets cached.
     // -----------------------------------------------------------------------
-    {
-        std::unique_lock<std::mutex> lock(m_load_mutex);
-
-        // Double-check cache while holding the load mutex so we don't race with
-        // a thread that just finished loading and added to the cache.
-        if (m_config.use_cache && m_cache) {
-            if (Ref<Resource> cached = m_cache->Get(path)) {
-                return cached;
-            }
+    std::unique_lock<std::mutex> lock(m_load_mutex);
+    
+    // Double-check cache while holding the load mutex so we don't race with
+    // a thread that just finished loading and added to the cache.
+    if (m_config.use_cache && m_cache) {
+        if (Ref<Resource> cached = m_cache->Get(path_id)) {
+            out_cached = std::move(cached);
+            return false;
         }
-
-        // If another thread is already loading this path, wait for it to finish
-        // (cv.wait releases the lock while waiting, allowing other paths to proceed).
-        m_load_cv.wait(lock, [&] { return m_loading_paths.count(path) == 0; });
-
-        // Re-check cache: the thread we were waiting for may have just added it.
-        if (m_config.use_cache && m_cache) {
-            if (Ref<Resource> cached = m_cache->Get(path)) {
-                return cached;
-            }
+    }
+    
+    // If another thread is already loading this path, wait for it to finish
+    // (cv.wait releases the lock while waiting, allowing other paths to proceed).
+    m_load_cv.wait(lock, [&] { return m_loading_paths.count(path_id) == 0; });
+    
+    // Re-check cache: the thread we were waiting for may have just added it.
+    if (m_config.use_cache && m_cache) {
+        if (Ref<Resource> cached = m_cache->Get(path_id)) {
+            out_cached = std::move(cached);
+            return false;
         }
+    }
+    
+    // We are the first thread to load this path -- mark it as in-flight.
+    m_loading_paths.insert(path_id);
+    return true;
+}
 
-        // We are the first thread to load this path -- mark it as in-flight.
-        m_loading_paths.insert(path);
-    }  // Release lock before the (potentially slow) disk read
-
-    // --- Load from disk (without holding the mutex) ---
-    Ref<Resource> resource = LoadInternal(path);
-
+void ResourceLoader::FinishLoad(StringID path_id, const Ref<Resource>& resource) {
     // --- Add to cache and unmark the in-flight path ---
     {
         std::lock_guard<std::mutex> lock(m_load_mutex);
-
+        
         if (resource && m_config.use_cache && m_cache) {
             m_cache->Add(resource);
         }
-
-        m_loading_paths.erase(path);
+        
+        m_loading_paths.erase(path_id);
     }
     // Wake up any threads waiting on this path.
     m_load_cv.notify_all();
+}
 
-    return resource;
+void ResourceLoader::LoadDependencies(Resource& resource) {
+    std::vector<std::string> dependencies = resource.GetDependencies();
+    if (dependencies.empty()) return;
+    
+    t_load_chain.push_back(resource.GetPath());
+    for (const auto& dependency : dependencies) {
+        if (InChain(t_load_chain, dependency)) {
+            LOG_WARN("Dependency cycle: {} -> {}", resource.GetPath(), dependency);
+            continue;
+        }
+        if (Ref<Resource> loaded = Load(dependency)) {
+            resource.ResolveDependency(dependency, loaded);
+        }
+    }
+    t_load_chain.pop_back();
 }
 
-std::future<Ref<Resource>> ResourceLoader::LoadAsync(const std::string& path) {
-    return std::async(std::launch::async, [this, path]() {
-        return Load(path);
-    });
+std::future<Ref<Resource>> ResourceLoader::LoadAsync(const std::string& path, JobPriority priority) {
+    auto promise = std::make_shared<std::promise<Ref<Resource>>>();
+    std::future<Ref<Resource>> future = promise->get_future();
+    LoadAsync(path, [promise](Ref<Resource> resource) {
+        promise->set_value(std::move(resource));
+    }, priority);
+    return future;
+}
+
+void ResourceLoader::LoadAsync(const std::string& path, LoadCallback on_loaded, JobPriority priority) {
+    RequestAsync(path, priority, std::move(on_loaded));
+}
+
+void ResourceLoader::LoadBatchAsync(const std::vector<std::string>& paths, BatchLoadCallback on_complete,
+                                    JobPriority priority) {
+    if (paths.empty()) {
+        if (on_complete) on_complete({});
+        return;
+    }
+    
+    struct Batch {
+        std::vector<Ref<Resource>> resources;
+        std::atomic<u32> remaining;
+        BatchLoadCallback on_complete;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->resources.resize(paths.size());
+    batch->remaining.store(static_cast<u32>(paths.size()), std::memory_order_relaxed);
+    batch->on_complete = std::move(on_complete);
+    
+    // Each request writes its own slot; the last one to finish reports the batch
+    for (size_t i = 0; i < paths.size(); i++) {
+        RequestAsync(paths[i], priority, [batch, i](Ref<Resource> resource) {
+            batch->resources[i] = std::move(resource);
+            if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && batch->on_complete) {
+                batch->on_complete(batch->resources);
+            }
+        });
+    }
 }
 
 void ResourceLoader::Preload(const std::string& path) {
     Load(path);  // Just load into cache
 }
 
-void ResourceLoader::Preload(const std::vector<std::string>& paths) {
-    for (const auto& path : paths) {
-        Preload(path);
+void ResourceLoader::Preload(const std::vector<std::string>& paths, JobPriority priority) {
+    PROFILE_SCOPE("ResourceLoader::Preload");
+    
+    std::promise<void> done;
+    std::future<void> future = done.get_future();
+    LoadBatchAsync(paths, [&done](const std::vector<Ref<Resource>>&) {
+        done.set_value();
+    }, priority);
+    future.wait();
+}
+
+void ResourceLoader::WaitForAsyncLoads() {
+    std::unique_lock lock(m_async_mutex);
+    m_async_cv.wait(lock, [this] { return m_async_in_flight == 0; });
+}
+
+u32 ResourceLoader::GetPendingAsyncLoadCount() const {
+    std::lock_guard lock(m_async_mutex);
+    return m_async_in_flight;
+}
+
+void ResourceLoader::RequestAsync(const std::string& path, JobPriority priority, LoadCallback callback) {
+    StringID path_id(path);
+    if (m_config.use_cache && m_cache) {
+        if (Ref<Resource> cached = m_cache->Get(path_id)) {
+            if (callback) callback(std::move(cached));
+            return;
+        }
+    }
+    
+    bool start_lane = false;
+    {
+        std::lock_guard lock(m_async_mutex);
+        
+        // Already queued or loading: share its result
+        auto existing = m_async_loads.find(path_id);
+        if (existing != m_async_loads.end()) {
+            if (callback) existing->second->callbacks.push_back(std::move(callback));
+            return;
+        }
+        
+        auto load = std::make_shared<AsyncLoad>();
+        load->path = path;
+        load->path_id = path_id;
+        load->priority = priority;
+        if (callback) load->callbacks.push_back(std::move(callback));
+        
+        m_async_loads.emplace(path_id, load);
+        m_async_queues[static_cast<u32>(priority)].push_back(std::move(load));
+        m_async_in_flight++;
+        
+        // Lanes drain the queues until empty, so only start one below the limit
+        u32 max_lanes = static_cast<u32>(m_config.async_thread_count);
+        if (m_jobs && (max_lanes == 0 || max_lanes > m_jobs->GetWorkerCount())) {
+            max_lanes = std::max(1u, m_jobs->GetWorkerCount());
+        }
+        if (!m_jobs) {
+            max_lanes = 1;  // The requesting thread (or the one already draining)
+        }
+        if (m_active_lanes < max_lanes) {
+            m_active_lanes++;
+            start_lane = true;
+        }
+    }
+    
+    if (start_lane) {
+        if (m_jobs) {
+            m_jobs->Submit([this]() { RunAsyncLane(); }, priority);
+        } else {
+            RunAsyncLane();
+        }
+    }
+}
+
+void ResourceLoader::RunAsyncLane() {
+    while (true) {
+        std::shared_ptr<AsyncLoad> load;
+        {
+            std::lock_guard lock(m_async_mutex);
+            for (int p = static_cast<int>(m_async_queues.size()) - 1; p >= 0; --p) {
+                auto& queue = m_async_queues[p];
+                if (!queue.empty()) {
+                    load = std::move(queue.front());
+                    queue.pop_front();
+                    break;
+                }
+            }
+            if (!load) {
+                m_active_lanes--;
+                return;
+            }
+        }
+        ProcessAsyncLoad(load);
+    }
+}
+
+void ResourceLoader::ProcessAsyncLoad(const std::shared_ptr<AsyncLoad>& load) {
+    PROFILE_SCOPE("ResourceLoader::ProcessAsyncLoad");
+    
+    Ref<Resource> cached;
+    if (!BeginLoad(load->path_id, cached)) {
+        CompleteAsyncLoad(load, std::move(cached));
+        return;
+    }
+    
+    Ref<Resource> resource = LoadInternal(load->path);
+    
+    // A dependency that (through any in-flight load, ours or another request's)
+    // already waits for this path would never finish: skip it. Checked and
+    // recorded under one lock, so two loads cannot each miss the other's wait.
+    std::vector<std::string> dependencies;
+    if (resource) {
+        std::lock_guard lock(m_async_mutex);
+        for (auto& dependency : resource->GetDependencies()) {
+            StringID dependency_id(dependency);
+            if (dependency_id == load->path_id || WaitsOn(dependency_id, load->path_id)) {
+                LOG_WARN("Dependency cycle: {} -> {}", load->path, dependency);
+                continue;
+            }
+            load->waiting_on.push_back(dependency_id);
+            dependencies.push_back(std::move(dependency));
+        }
+    }
+    
+    if (dependencies.empty()) {
+        FinishLoad(load->path_id, resource);
+        CompleteAsyncLoad(load, std::move(resource));
+        return;
+    }
+    
+    // Load dependencies in parallel without holding this lane; the last one to
+    // finish resolves them, caches the resource and completes the request
+    struct DependencyWait {
+        Ref<Resource> resource;
+        std::vector<std::string> paths;
+        std::vector<Ref<Resource>> loaded;
+        std::atomic<u32> remaining;
+    };
+    auto wait = std::make_shared<DependencyWait>();
+    wait->resource = resource;
+    wait->paths = std::move(dependencies);
+    wait->loaded.resize(wait->paths.size());
+    wait->remaining.store(static_cast<u32>(wait->paths.size()), std::memory_order_relaxed);
+    
+    resource->SetState(ResourceState::Loading);
+    
+    for (size_t i = 0; i < wait->paths.size(); i++) {
+        RequestAsync(wait->paths[i], load->priority, [this, load, wait, i](Ref<Resource> dependency) {
+            wait->loaded[i] = std::move(dependency);
+            if (wait->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            
+            for (size_t d = 0; d < wait->paths.size(); d++) {
+                if (wait->loaded[d]) {
+                    wait->resource->ResolveDependency(wait->paths[d], wait->loaded[d]);
+                }
+            }
+            wait->resource->SetState(ResourceState::Loaded);
+            
+            FinishLoad(load->path_id, wait->resource);
+            CompleteAsyncLoad(load, wait->resource);
+        });
+    }
+}
+
+bool ResourceLoader::WaitsOn(StringID from, StringID target) const {
+    std::vector<StringID> stack{from};
+    std::unordered_set<StringID> visited;
+    while (!stack.empty()) {
+        StringID id = stack.back();
+        stack.pop_back();
+        if (!visited.insert(id).second) continue;
+        
+        // Not in flight: it is requested fresh and checks its own dependencies
+        auto it = m_async_loads.find(id);
+        if (it == m_async_loads.end()) continue;
+        
+        for (StringID dependency : it->second->waiting_on) {
+            if (dependency == target) return true;
+            stack.push_back(dependency);
+        }
+    }
+    return false;
+}
+
+void ResourceLoader::CompleteAsyncLoad(const std::shared_ptr<AsyncLoad>& load, Ref<Resource> resource) {
+    // Later requests for the path hit the cache (or start a new load after a failure)
+    std::vector<LoadCallback> callbacks;
+    {
+        std::lock_guard lock(m_async_mutex);
+        auto it = m_async_loads.find(load->path_id);
+        if (it != m_async_loads.end() && it->second == load) {
+            m_async_loads.erase(it);
+        }
+        callbacks = std::move(load->callbacks);
+    }
+    
+    for (auto& callback : callbacks) {
+        callback(resource);
+    }
+    
+    {
+        std::lock_guard lock(m_async_mutex);
+        m_async_in_flight--;
     }
+    m_async_cv.notify_all();
 }
 
 bool ResourceLoader::Exists(const std::string& path) const {
@@ -136,7 +437,7 @@ std::string ResourceLoader::GetResourceType(const std::string& extension) const
 
 Ref<Resource> ResourceLoader::LoadInternal(const std::string& path) {
     if (!Exists(path)) {
-        LOG_ERROR("Resource not found: %s", path.c_str());
+        LOG_ERROR("Resource not found: {}", path);
         return nullptr;
     }
     
@@ -144,11 +445,11 @@ Ref<Resource> ResourceLoader::LoadInternal(const std::string& path) {
     
     auto it = m_loaders.find(ext);
     if (it == m_loaders.end()) {
-        LOG_ERROR("No loader registered for extension: %s", ext.c_str());
+        LOG_ERROR("No loader registered for extension: {}", ext);
         return nullptr;
     }
     
-    LOG_DEBUG("Loading resource: %s", path.c_str());
+    LOG_DEBUG("Loading resource: {}", path);
     
     Ref<Resource> resource = it->second(path);
     if (resource) {
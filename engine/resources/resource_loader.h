@@ -2,6 +2,9 @@
 
 #include "resource.h"
 #include "resource_cache.h"
+#include "core/jobs/job_system.h"
+#include <array>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -17,17 +20,37 @@ namespace action {
  * Features:
  * - Automatic type detection by extension
  * - Custom loader registration
- * - Async loading support
+ * - Async loading on the JobSystem, at per-request priority
+ * - Dependencies (Resource::GetDependencies) loaded before the resource is
+ *   cached; async loads fetch them in parallel
+ * - Batch loads with one completion callback
  * - Integrated caching
+ * 
+ * Async model:
+ * - Requests go into per-priority queues drained by at most async_thread_count
+ *   "lane" jobs, so preloading a level never occupies more workers than that
+ * - Lanes never block on dependencies: a resource waiting for its dependencies
+ *   holds no lane, and the last dependency to finish completes it
+ * - Concurrent requests for a path share one load (in-flight loads are
+ *   tracked by the path's StringID)
+ * - Without a JobSystem, async loads run on the requesting thread
  */
 
 // Loader function type
 using LoaderFunc = std::function<Ref<Resource>(const std::string& path)>;
 
+// Async completion (nullptr on failure). Runs on the thread that finished the
+// load, or inline on the requesting thread for cache hits. Must not block on
+// other loads (a lane would stall).
+using LoadCallback = std::function<void(Ref<Resource> resource)>;
+
+// Batch completion: resources in request order (nullptr for failures)
+using BatchLoadCallback = std::function<void(const std::vector<Ref<Resource>>& resources)>;
+
 struct ResourceLoaderConfig {
     bool use_cache = true;
     bool async_default = false;
-    size_t async_thread_count = 2;
+    size_t async_thread_count = 2;  // Max JobSystem workers loading at once (0 = all workers)
 };
 
 class ResourceLoader {
@@ -38,12 +61,17 @@ public:
     bool Initialize(ResourceCache& cache, const ResourceLoaderConfig& config = {});
     void Shutdown();
     
+    void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+    
     // ===== Loader Registration =====
     
     // Register a loader for specific extensions
     void RegisterLoader(const std::string& extension, LoaderFunc loader);
     void RegisterLoader(const std::vector<std::string>& extensions, LoaderFunc loader);
     
+    // Loaders for the built-in file types: .mat materials and image textures
+    void RegisterDefaultLoaders();
+    
     // ===== Loading =====
     
     // Load resource (uses cache if available)
@@ -54,14 +82,25 @@ public:
     Ref<T> Load(const std::string& path);
     
     // Async load
-    std::future<Ref<Resource>> LoadAsync(const std::string& path);
+    std::future<Ref<Resource>> LoadAsync(const std::string& path, JobPriority priority = JobPriority::Normal);
+    void LoadAsync(const std::string& path, LoadCallback on_loaded, JobPriority priority = JobPriority::Normal);
     
     template<typename T>
-    std::future<Ref<T>> LoadAsync(const std::string& path);
+    std::future<Ref<T>> LoadAsync(const std::string& path, JobPriority priority = JobPriority::Normal);
+    
+    // Async load of a set of resources; on_complete runs once all of them (and
+    // their dependencies) are done
+    void LoadBatchAsync(const std::vector<std::string>& paths, BatchLoadCallback on_complete,
+                        JobPriority priority = JobPriority::Normal);
     
-    // Preload (load into cache without returning)
+    // Preload (load into cache without returning). The list form loads in parallel
+    // and blocks until done; do not call it from a load callback.
     void Preload(const std::string& path);
-    void Preload(const std::vector<std::string>& paths);
+    void Preload(const std::vector<std::string>& paths, JobPriority priority = JobPriority::Normal);
+    
+    // Block until every async load has completed
+    void WaitForAsyncLoads();
+    u32 GetPendingAsyncLoadCount() const;
     
     // ===== State =====
     
@@ -76,22 +115,55 @@ public:
     
     // ===== Cache Access =====
     ResourceCache* GetCache() { return m_cache; }
-    
+
 private:
+    // One path being loaded asynchronously, shared by every request for it
+    struct AsyncLoad {
+        std::string path;
+        StringID path_id;
+        JobPriority priority = JobPriority::Normal;
+        std::vector<StringID> waiting_on;     // Dependencies it waits for (cycle guard)
+        std::vector<LoadCallback> callbacks;  // Guarded by m_async_mutex
+    };
+    
+    // Returns true if the caller must load the path (it is then marked in flight and
+    // must be passed to FinishLoad); false with out_cached set when it was cached
+    bool BeginLoad(StringID path_id, Ref<Resource>& out_cached);
+    void FinishLoad(StringID path_id, const Ref<Resource>& resource);
+    
     Ref<Resource> LoadInternal(const std::string& path);
+    void LoadDependencies(Resource& resource);
+    
+    void RequestAsync(const std::string& path, JobPriority priority, LoadCallback callback);
+    void RunAsyncLane();
+    void ProcessAsyncLoad(const std::shared_ptr<AsyncLoad>& load);
+    void CompleteAsyncLoad(const std::shared_ptr<AsyncLoad>& load, Ref<Resource> resource);
+    
+    // True if the in-flight load of from waits, directly or through other in-flight
+    // loads, for target (m_async_mutex held)
+    bool WaitsOn(StringID from, StringID target) const;
     
     ResourceLoaderConfig m_config;
     ResourceCache* m_cache = nullptr;
+    JobSystem* m_jobs = nullptr;
     
     std::unordered_map<std::string, LoaderFunc> m_loaders;
     std::unordered_map<std::string, std::string> m_type_map;  // extension -> type name
-
+    
     // TOCTOU-safe concurrent loading:
     //   Only one thread loads a given path at a time.  Other concurrent requests
     //   for the same path block until the first load completes, then read from cache.
     std::mutex              m_load_mutex;
     std::condition_variable m_load_cv;
-    std::unordered_set<std::string> m_loading_paths;  // paths currently being loaded
+    std::unordered_set<StringID> m_loading_paths;  // paths currently being loaded
+    
+    // Async requests: queued by priority, drained by lane jobs
+    mutable std::mutex      m_async_mutex;
+    std::condition_variable m_async_cv;  // Signaled when an async load completes
+    std::array<std::deque<std::shared_ptr<AsyncLoad>>, 4> m_async_queues;
+    std::unordered_map<StringID, std::shared_ptr<AsyncLoad>> m_async_loads;  // Queued or waiting on dependencies
+    u32 m_active_lanes = 0;
+    u32 m_async_in_flight = 0;
 };
 
 // Template implementations
@@ -102,10 +174,13 @@ Ref<T> ResourceLoader::Load(const std::string& path) {
 }
 
 template<typename T>
-std::future<Ref<T>> ResourceLoader::LoadAsync(const std::string& path) {
-    return std::async(std::launch::async, [this, path]() {
-        return Load<T>(path);
-    });
+std::future<Ref<T>> ResourceLoader::LoadAsync(const std::string& path, JobPriority priority) {
+    auto promise = std::make_shared<std::promise<Ref<T>>>();
+    std::future<Ref<T>> future = promise->get_future();
+    LoadAsync(path, [promise](Ref<Resource> resource) {
+        promise->set_value(resource ? std::dynamic_pointer_cast<T>(resource) : nullptr);
+    }, priority);
+    return future;
 }
 
 } // namespace action
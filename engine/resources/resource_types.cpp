@@ -1,5 +1,7 @@
 #include "resource_types.h"
 #include "core/logging.h"
+#include "serialization/json_format.h"
+#include <filesystem>
 #include <fstream>
 
 namespace action {
@@ -58,7 +60,33 @@ void MeshResource::CalculateBounds() {
 // ===== MaterialResource =====
 
 bool MaterialResource::Load() {
-    // Material loading from file
+    // Built in code: nothing to read
+    const std::string& path = GetPath();
+    if (path.empty()) {
+        SetState(ResourceState::Loaded);
+        return true;
+    }
+    
+    if (!std::filesystem::exists(path)) {
+        LOG_ERROR("MaterialResource::Load(): '{}' not found", path);
+        SetState(ResourceState::Failed);
+        return false;
+    }
+    
+    // JSON material: factors plus texture references. The textures themselves
+    // are loaded by ResourceLoader as dependencies (GetDependencies).
+    Deserializer in(JsonFormat::LoadFromFile(path));
+    m_albedo_color = in.ReadVec4("albedo_color", m_albedo_color);
+    m_metallic = in.ReadFloat("metallic", m_metallic);
+    m_roughness = in.ReadFloat("roughness", m_roughness);
+    m_emission_strength = in.ReadFloat("emission_strength", m_emission_strength);
+    m_transparent = in.ReadBool("transparent", m_transparent);
+    m_double_sided = in.ReadBool("double_sided", m_double_sided);
+    
+    m_albedo_path = in.ReadResourceRef("albedo_texture");
+    m_normal_path = in.ReadResourceRef("normal_texture");
+    m_metallic_roughness_path = in.ReadResourceRef("metallic_roughness_texture");
+    
     SetState(ResourceState::Loaded);
     return true;
 }
@@ -69,6 +97,27 @@ void MaterialResource::Unload() {
     m_metallic_roughness.reset();
 }
 
+std::vector<std::string> MaterialResource::GetDependencies() const {
+    std::vector<std::string> paths;
+    if (!m_albedo_path.empty() && !m_albedo) paths.push_back(m_albedo_path);
+    if (!m_normal_path.empty() && !m_normal) paths.push_back(m_normal_path);
+    if (!m_metallic_roughness_path.empty() && !m_metallic_roughness) paths.push_back(m_metallic_roughness_path);
+    return paths;
+}
+
+void MaterialResource::ResolveDependency(const std::string& path, Ref<Resource> dependency) {
+    auto texture = std::dynamic_pointer_cast<TextureResource>(dependency);
+    if (!texture) {
+        LOG_WARN("Material {}: dependency {} is not a texture", GetPath(), path);
+        return;
+    }
+    
+    // One file may fill several slots
+    if (path == m_albedo_path) m_albedo = texture;
+    if (path == m_normal_path) m_normal = texture;
+    if (path == m_metallic_roughness_path) m_metallic_roughness = texture;
+}
+
 // ===== ShaderResource =====
 
 bool ShaderResource::Load() {
@@ -140,6 +140,15 @@ public:
     void SetNormalTexture(Ref<TextureResource> tex) { m_normal = tex; }
     void SetMetallicRoughnessTexture(Ref<TextureResource> tex) { m_metallic_roughness = tex; }
     
+    // Texture paths, read from the material file by Load; ResourceLoader loads them as dependencies
+    const std::string& GetAlbedoTexturePath() const { return m_albedo_path; }
+    const std::string& GetNormalTexturePath() const { return m_normal_path; }
+    const std::string& GetMetallicRoughnessTexturePath() const { return m_metallic_roughness_path; }
+    
+    void SetAlbedoTexturePath(const std::string& path) { m_albedo_path = path; }
+    void SetNormalTexturePath(const std::string& path) { m_normal_path = path; }
+    void SetMetallicRoughnessTexturePath(const std::string& path) { m_metallic_roughness_path = path; }
+    
     // Properties
     vec4 GetAlbedoColor() const { return m_albedo_color; }
     float GetMetallic() const { return m_metallic; }
@@ -160,11 +169,18 @@ public:
     bool Load() override;
     void Unload() override;
     
+    std::vector<std::string> GetDependencies() const override;
+    void ResolveDependency(const std::string& path, Ref<Resource> dependency) override;
+    
 private:
     Ref<TextureResource> m_albedo;
     Ref<TextureResource> m_normal;
     Ref<TextureResource> m_metallic_roughness;
     
+    std::string m_albedo_path;
+    std::string m_normal_path;
+    std::string m_metallic_roughness_path;
+    
     vec4 m_albedo_color{1, 1, 1, 1};
     float m_metallic = 0.0f;
     float m_roughness = 0.5f;
@@ -260,7 +260,9 @@ private:
  * TriggerZone - Physics-enabled trigger volume
  * 
  * Use this to detect when entities enter/exit a zone.
- * Configure with ColliderComponent + Trigger layer.
+ * Uses the entity's ColliderComponent (made a trigger on the Trigger layer,
+ * masked to trigger_layer) or adds a sphere of trigger_radius, and reacts to
+ * PhysicsWorld trigger events instead of polling.
  */
 class TriggerZone : public Script {
 public:
@@ -269,32 +271,50 @@ public:
     std::string on_enter_message = "";
     bool destroy_on_trigger = false;
     CollisionLayer trigger_layer = CollisionLayer::Player;
+    float trigger_radius = 1.0f;  // Sphere added when the entity has no collider
     
-    void OnUpdate(float dt) override {
-        auto* physics = GetPhysics();
-        if (!physics) return;
+    void OnStart() override {
+        auto* collider = GetComponent<ColliderComponent>();
+        if (!collider) {
+            collider = &AddComponent<ColliderComponent>();
+            collider->type = ColliderType::Sphere;
+            collider->radius = trigger_radius;
+        }
+        collider->layer = CollisionLayer::Trigger;
+        collider->mask = trigger_layer;
+        collider->is_trigger = true;
         
-        vec3 pos = GetPosition();
-        auto overlaps = physics->OverlapSphere(pos, 1.0f, trigger_layer);
+        if (auto* physics = GetPhysics()) {
+            physics->AddCollider(GetEntity());
+        }
+    }
+    
+    void OnTriggerEnter(Entity other) override {
+        if (m_triggered) return;
         
-        for (auto entity : overlaps) {
-            if (entity != GetEntity()) {
-                OnTriggered(entity);
-                if (destroy_on_trigger) {
-                    DestroySelf();
-                    return;
-                }
-            }
+        OnTriggered(other);
+        if (destroy_on_trigger) {
+            m_triggered = true;
+            DestroySelf();
+        }
+    }
+    
+    void OnDestroy() override {
+        if (auto* physics = GetPhysics()) {
+            physics->RemoveCollider(GetEntity());
         }
     }
     
     virtual void OnTriggered(Entity other) {
-        Log("Trigger activated by entity!");
+        Log(on_enter_message.empty() ? "Trigger activated by entity!" : on_enter_message);
     }
+    
+private:
+    bool m_triggered = false;
 };
 
 /*
- * HealthPickup - Example collectible that uses physics overlap
+ * HealthPickup - Example collectible driven by physics trigger events
  */
 class HealthPickup : public Script {
 public:
@@ -304,10 +324,24 @@ public:
     float heal_amount = 25.0f;
     float bob_speed = 2.0f;
     float bob_height = 0.3f;
+    CollisionLayer pickup_layer = CollisionLayer::Player;
     
     void OnStart() override {
         m_start_y = GetPosition().y;
         m_time = 0.0f;
+        
+        // Trigger sphere: the physics world reports the player walking into it
+        auto* collider = GetComponent<ColliderComponent>();
+        if (!collider) collider = &AddComponent<ColliderComponent>();
+        collider->type = ColliderType::Sphere;
+        collider->radius = pickup_radius;
+        collider->layer = CollisionLayer::Trigger;
+        collider->mask = pickup_layer;
+        collider->is_trigger = true;
+        
+        if (auto* physics = GetPhysics()) {
+            physics->AddCollider(GetEntity());
+        }
     }
     
     void OnUpdate(float dt) override {
@@ -319,19 +353,27 @@ public:
         
         // Rotate for visual effect
         Rotate(vec3{0, 90 * dt, 0});
+    }
+    
+    void OnTriggerEnter(Entity other) override {
+        if (m_collected) return;
+        m_collected = true;
         
-        // Check for player overlap using physics
-        auto overlaps = OverlapSphere(pos, pickup_radius);
-        if (!overlaps.empty()) {
-            // In a real game, you'd give health to the player here
-            Log("Health pickup collected! +" + std::to_string(static_cast<int>(heal_amount)));
-            DestroySelf();
+        // In a real game, you'd give health to the player here
+        Log("Health pickup collected! +" + std::to_string(static_cast<int>(heal_amount)));
+        DestroySelf();
+    }
+    
+    void OnDestroy() override {
+        if (auto* physics = GetPhysics()) {
+            physics->RemoveCollider(GetEntity());
         }
     }
     
 private:
     float m_start_y = 0.0f;
     float m_time = 0.0f;
+    bool m_collected = false;
 };
 
 /*
@@ -357,7 +399,8 @@ public:
         vec3 pos = GetPosition();
         
         // Raycast ahead to detect hits
-        RaycastHit hit = Raycast(pos, m_direction, move_distance + 0.1f);
+        RaycastHit hit = Raycast(pos, m_direction, move_distance + 0.1f,
+                                 static_cast<CollisionLayer>(hit_mask));
         if (hit) {
             OnHit(hit);
             DestroySelf();
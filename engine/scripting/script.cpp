@@ -140,9 +140,10 @@ void Script::DestroySelf(float delay) {
     Destroy(m_entity, delay);
 }
 
-RaycastHit Script::Raycast(const vec3& origin, const vec3& direction, float max_distance) {
+RaycastHit Script::Raycast(const vec3& origin, const vec3& direction, float max_distance,
+                           CollisionLayer mask) {
     if (m_physics) {
-        return m_physics->Raycast(origin, direction, max_distance);
+        return m_physics->Raycast(origin, direction, max_distance, mask);
     }
     return RaycastHit{};
 }
@@ -3,6 +3,7 @@
 #include "core/types.h"
 #include "core/math/math.h"
 #include "gameplay/ecs/ecs.h"
+#include "physics/collision_shapes.h"
 #include <string>
 
 namespace action {
@@ -16,6 +17,7 @@ class Renderer;
 class ScriptSystem;
 class PhysicsWorld;
 struct RaycastHit;
+struct CollisionEvent;
 
 /*
  * Script - Base class for all game scripts
@@ -62,13 +64,14 @@ public:
     virtual void OnLateUpdate(float dt) {}          // Called after all Updates
     virtual void OnDestroy() {}                     // Called when script/entity is destroyed
     
-    // Collision callbacks (requires physics component)
+    // Collision callbacks (requires a ColliderComponent registered with PhysicsWorld)
     virtual void OnCollisionEnter(Entity other) {}
     virtual void OnCollisionStay(Entity other) {}
     virtual void OnCollisionExit(Entity other) {}
     
-    // Trigger callbacks
+    // Trigger callbacks (either collider is a trigger)
     virtual void OnTriggerEnter(Entity other) {}
+    virtual void OnTriggerStay(Entity other) {}
     virtual void OnTriggerExit(Entity other) {}
     
     // Script info
@@ -135,7 +138,8 @@ public:
     PhysicsWorld* GetPhysics() const { return m_physics; }
     
     // Physics helpers (shortcuts for common operations)
-    RaycastHit Raycast(const vec3& origin, const vec3& direction, float max_distance = 100.0f);
+    RaycastHit Raycast(const vec3& origin, const vec3& direction, float max_distance = 100.0f,
+                       CollisionLayer mask = CollisionLayer::All);
     std::vector<Entity> OverlapSphere(const vec3& center, float radius);
     
     // Logging
@@ -103,11 +103,16 @@ Script* ScriptSystem::GetScript(Entity entity, const std::string& type_name) {
 
 void ScriptSystem::Update(float dt) {
     StartPendingScripts();
+    DispatchCollisionEvents();
     
-    m_ecs->ForEach<ScriptComponent>([dt](Entity entity, ScriptComponent& comp) {
+    // Distant entities tick every Nth frame with the accumulated dt (simulation LOD)
+    m_ecs->ForEach<ScriptComponent>([this, dt](Entity entity, ScriptComponent& comp) {
+        float step = dt;
+        if (!GetSimulationStep(*m_ecs, entity, dt, step)) return;
+        
         for (auto& script : comp.scripts) {
             if (script && script->IsEnabled()) {
-                script->OnUpdate(dt);
+                script->OnUpdate(step);
             }
         }
     });
@@ -126,10 +131,13 @@ void ScriptSystem::FixedUpdate(float fixed_dt) {
 }
 
 void ScriptSystem::LateUpdate(float dt) {
-    m_ecs->ForEach<ScriptComponent>([dt](Entity entity, ScriptComponent& comp) {
+    m_ecs->ForEach<ScriptComponent>([this, dt](Entity entity, ScriptComponent& comp) {
+        float step = dt;
+        if (!GetSimulationStep(*m_ecs, entity, dt, step)) return;
+        
         for (auto& script : comp.scripts) {
             if (script && script->IsEnabled()) {
-                script->OnLateUpdate(dt);
+                script->OnLateUpdate(step);
             }
         }
     });
@@ -139,6 +147,41 @@ const std::vector<std::string>& ScriptSystem::GetRegisteredScriptTypes() const {
     return ScriptFactory::Instance().GetRegisteredTypes();
 }
 
+void ScriptSystem::DispatchCollisionEvents() {
+    if (!m_physics) return;
+    
+    for (const CollisionEvent& event : m_physics->GetCollisionEvents()) {
+        DispatchCollisionEvent(event.entity_a, event.entity_b, event);
+        DispatchCollisionEvent(event.entity_b, event.entity_a, event);
+    }
+}
+
+void ScriptSystem::DispatchCollisionEvent(Entity self, Entity other, const CollisionEvent& event) {
+    // Re-fetched per script: callbacks may add scripts or components
+    for (size_t i = 0;; ++i) {
+        auto* comp = m_ecs->GetComponent<ScriptComponent>(self);
+        if (!comp || i >= comp->scripts.size()) break;
+        
+        Script* script = comp->scripts[i].get();
+        if (!script || !script->IsEnabled()) continue;
+        
+        switch (event.phase) {
+            case CollisionPhase::Enter:
+                if (event.is_trigger) script->OnTriggerEnter(other);
+                else script->OnCollisionEnter(other);
+                break;
+            case CollisionPhase::Stay:
+                if (event.is_trigger) script->OnTriggerStay(other);
+                else script->OnCollisionStay(other);
+                break;
+            case CollisionPhase::Exit:
+                if (event.is_trigger) script->OnTriggerExit(other);
+                else script->OnCollisionExit(other);
+                break;
+        }
+    }
+}
+
 void ScriptSystem::StartPendingScripts() {
     // Copy to avoid issues if OnStart adds more scripts
     std::vector<Script*> to_start = std::move(m_pending_start);
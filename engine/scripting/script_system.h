@@ -175,6 +175,10 @@ private:
     void StartPendingScripts();
     void ProcessDestroyQueue();
     
+    // Sends this frame's PhysicsWorld collision events to both entities' scripts
+    void DispatchCollisionEvents();
+    void DispatchCollisionEvent(Entity self, Entity other, const CollisionEvent& event);
+    
     ECS* m_ecs = nullptr;
     Input* m_input = nullptr;
     AssetManager* m_assets = nullptr;
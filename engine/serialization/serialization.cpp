@@ -250,9 +250,15 @@ void Serializer::WriteObject(const std::string& key, const SerialObject& obj) {
 }
 
 void Serializer::WriteResourceRef(const std::string& key, const std::string& resource_path) {
+    // Same ID as AssetManager gives the path (normalized)
+    WriteResourceRef(key, MakeAssetID(resource_path));
+}
+
+void Serializer::WriteResourceRef(const std::string& key, StringID resource_id) {
     SerialObject ref;
     ref.type_name = "ResourceRef";
-    ref.Set("path", resource_path);
+    ref.Set("id", resource_id.ToHex());
+    ref.Set("path", std::string(resource_id.GetString()));
     WriteObject(key, ref);
 }
 
@@ -338,7 +344,28 @@ const SerialObject* Deserializer::GetObject(const std::string& key) const {
 std::string Deserializer::ReadResourceRef(const std::string& key) const {
     auto* obj = GetObject(key);
     if (!obj || obj->type_name != "ResourceRef") return "";
-    return obj->Get<std::string>("path", "");
+    
+    std::string path = obj->Get<std::string>("path", "");
+    if (path.empty()) {
+        path = StringID::FromHex(obj->Get<std::string>("id", "")).GetString();
+    }
+    return path;
+}
+
+StringID Deserializer::ReadResourceID(const std::string& key) const {
+    auto* obj = GetObject(key);
+    if (!obj || obj->type_name != "ResourceRef") return {};
+    
+    StringID id = StringID::FromHex(obj->Get<std::string>("id", ""));
+    std::string path = obj->Get<std::string>("path", "");
+    if (path.empty()) return id;  // ID only: loadable if its path was interned elsewhere
+    
+    // The path is what gets loaded; a mismatching ID means the file was edited by hand
+    StringID path_id = MakeAssetID(path);
+    if (id.IsValid() && id != path_id) {
+        LOG_WARN("Resource ref '{}': id {} does not match path {}, using the path", key, id.ToHex(), path);
+    }
+    return path_id;
 }
 
 } // namespace action
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/string_id.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -17,7 +18,9 @@ namespace action {
  * Features:
  * - JSON and binary formats
  * - Scene serialization with node hierarchy
- * - Resource references
+ * - Resource references: the normalized path plus its AssetID (hex, so text
+ *   formats keep all 64 bits). The path wins when both are present; the ID
+ *   alone is used only if the path is missing
  * - Type registration for custom types
  * - Version handling for backwards compatibility
  */
@@ -96,6 +99,7 @@ public:
     
     // Resource reference
     void WriteResourceRef(const std::string& key, const std::string& resource_path);
+    void WriteResourceRef(const std::string& key, StringID resource_id);  // Path from the intern table
     
     // Get current object
     SerialObject& Current() { return m_stack.back(); }
@@ -140,6 +144,10 @@ public:
     // Resource reference
     std::string ReadResourceRef(const std::string& key) const;
     
+    // ID of a resource reference (MakeAssetID of the stored path, so it matches
+    // AssetManager's); invalid if there is none
+    StringID ReadResourceID(const std::string& key) const;
+    
     // Check existence
     bool Has(const std::string& key) const { return m_current->Has(key); }
     
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core/types.h"
+#include <functional>
+
+namespace action {
+
+// Chunk coordinate (absolute grid cell on the X/Z plane)
+struct ChunkCoord {
+    i32 x, z;
+    
+    bool operator==(const ChunkCoord& o) const { return x == o.x && z == o.z; }
+};
+
+struct ChunkCoordHash {
+    size_t operator()(const ChunkCoord& c) const {
+        return std::hash<i64>{}((static_cast<i64>(c.x) << 32) | static_cast<u32>(c.z));
+    }
+};
+
+} // namespace action
@@ -0,0 +1,375 @@
+#include "chunk_persistence.h"
+#include "core/logging.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+
+namespace action {
+
+namespace {
+
+constexpr u32 DELTA_MAGIC = 0x4C444341;  // "ACDL"
+constexpr u16 DELTA_VERSION = 2;  // 2: assets saved as paths instead of runtime handles
+
+// Record layout on disk (little-endian, tightly packed). RECORD_SIZE is the
+// fixed part; the mesh and material paths follow it.
+constexpr size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 4 + 4 + 4;
+constexpr size_t RECORD_SIZE = 4 + 12 + 12 + 16 + 1 + 2 + 2;
+
+template<typename T>
+void Put(std::vector<u8>& out, const T& value) {
+    const u8* bytes = reinterpret_cast<const u8*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+T Take(const u8*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+void PutVec3(std::vector<u8>& out, const vec3& v) {
+    Put(out, v.x);
+    Put(out, v.y);
+    Put(out, v.z);
+}
+
+vec3 TakeVec3(const u8*& cursor) {
+    float x = Take<float>(cursor);
+    float y = Take<float>(cursor);
+    float z = Take<float>(cursor);
+    return {x, y, z};
+}
+
+// Paths longer than a u16 length are not asset paths; they are saved empty
+std::string_view AssetPath(AssetID id) {
+    std::string_view path = id.GetString();
+    return path.size() <= UINT16_MAX ? path : std::string_view{};
+}
+
+AssetID TakeAssetPath(const u8*& cursor, u16 length) {
+    std::string_view path(reinterpret_cast<const char*>(cursor), length);
+    cursor += length;
+    return path.empty() ? AssetID{} : MakeAssetID(path);
+}
+
+} // namespace
+
+ChunkDeltaStore::~ChunkDeltaStore() {
+    Shutdown();
+}
+
+bool ChunkDeltaStore::Initialize(const std::string& directory) {
+    m_directory = directory;
+
+    if (m_directory.empty()) {
+        LOG_INFO("ChunkDeltaStore: in-memory only (no delta directory)");
+        return true;
+    }
+
+    try {
+        std::filesystem::create_directories(m_directory);
+
+        // One directory listing at startup so HasDelta() never hits the disk
+        for (const auto& entry : std::filesystem::directory_iterator(m_directory)) {
+            if (!entry.is_regular_file()) continue;
+
+            ChunkCoord coord{0, 0};
+            std::string name = entry.path().filename().string();
+            if (std::sscanf(name.c_str(), "chunk_%d_%d.delta", &coord.x, &coord.z) == 2) {
+                m_on_disk.insert(coord);
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("ChunkDeltaStore: cannot use delta directory {}: {}", m_directory, e.what());
+        m_directory.clear();
+        return false;
+    }
+
+    m_running = true;
+    m_io_thread = std::thread(&ChunkDeltaStore::IOThread, this);
+
+    LOG_INFO("ChunkDeltaStore: {} ({} saved chunks)", m_directory, m_on_disk.size());
+    return true;
+}
+
+void ChunkDeltaStore::Shutdown() {
+    if (m_running) {
+        m_running = false;
+        m_cv.notify_all();
+    }
+
+    // The I/O thread drains its queues before exiting
+    if (m_io_thread.joinable()) {
+        m_io_thread.join();
+    }
+}
+
+void ChunkDeltaStore::Store(ChunkDelta delta) {
+    std::lock_guard lock(m_mutex);
+
+    u64 version = m_next_version++;
+    if (IsPersistent()) {
+        m_write_queue.push_back({delta, version});
+    }
+
+    ChunkCoord coord = delta.coord;
+    m_cache[coord] = {std::move(delta), version};
+}
+
+bool ChunkDeltaStore::HasDelta(ChunkCoord coord) const {
+    std::lock_guard lock(m_mutex);
+    return m_cache.contains(coord) || m_on_disk.contains(coord);
+}
+
+void ChunkDeltaStore::RequestLoad(ChunkCoord coord) {
+    std::lock_guard lock(m_mutex);
+
+    // Newest state may not have reached the disk yet
+    if (auto it = m_cache.find(coord); it != m_cache.end()) {
+        m_loaded.push_back(it->second.delta);
+        return;
+    }
+
+    if (m_on_disk.contains(coord) && m_running) {
+        m_read_queue.push_back(coord);
+        m_cv.notify_one();
+        return;
+    }
+
+    // Nothing saved: complete with an empty delta so the chunk finishes loading
+    m_loaded.push_back(ChunkDelta{coord, {}, {}});
+}
+
+void ChunkDeltaStore::CollectLoaded(std::vector<ChunkDelta>& out) {
+    std::lock_guard lock(m_mutex);
+
+    for (auto& delta : m_loaded) {
+        out.push_back(std::move(delta));
+    }
+    m_loaded.clear();
+}
+
+void ChunkDeltaStore::Discard() {
+    std::lock_guard lock(m_mutex);
+
+    m_cache.clear();
+    m_on_disk.clear();
+    m_write_queue.clear();
+    m_read_queue.clear();
+    m_loaded.clear();
+}
+
+u32 ChunkDeltaStore::GetQueuedWriteCount() const {
+    std::lock_guard lock(m_mutex);
+    return static_cast<u32>(m_write_queue.size());
+}
+
+u32 ChunkDeltaStore::GetQueuedReadCount() const {
+    std::lock_guard lock(m_mutex);
+    return static_cast<u32>(m_read_queue.size());
+}
+
+void ChunkDeltaStore::IOThread() {
+    while (true) {
+        std::vector<ChunkCoord> reads;
+        std::vector<WriteRequest> writes;
+        {
+            std::unique_lock lock(m_mutex);
+
+            // Reads wake the thread immediately; writes wait for the batch window
+            m_cv.wait_for(lock, std::chrono::milliseconds(WRITE_BATCH_DELAY_MS), [this]() {
+                return !m_running || !m_read_queue.empty();
+            });
+
+            reads.swap(m_read_queue);
+            writes.swap(m_write_queue);
+
+            if (!m_running && reads.empty() && writes.empty()) {
+                break;
+            }
+        }
+
+        for (ChunkCoord coord : reads) {
+            ChunkDelta delta;
+            if (!ReadDelta(coord, delta)) {
+                LOG_WARN("ChunkDeltaStore: discarding unreadable delta for chunk ({}, {})",
+                         coord.x, coord.z);
+                delta = ChunkDelta{coord, {}, {}};
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_loaded.push_back(std::move(delta));
+        }
+
+        if (writes.empty()) continue;
+
+        PROFILE_SCOPE("ChunkDeltaStore::WriteBatch");
+
+        // Coalesce: only the newest delta per chunk in this batch hits the disk
+        std::sort(writes.begin(), writes.end(), [](const WriteRequest& a, const WriteRequest& b) {
+            return a.version > b.version;
+        });
+
+        std::unordered_set<ChunkCoord, ChunkCoordHash> written;
+        for (const auto& request : writes) {
+            if (!written.insert(request.delta.coord).second) continue;
+
+            if (!WriteDelta(request.delta)) {
+                // Keep serving it from memory; it will be retried on the next unload
+                continue;
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_on_disk.insert(request.delta.coord);
+
+            // Drop the cached copy unless a newer Store() replaced it meanwhile
+            auto it = m_cache.find(request.delta.coord);
+            if (it != m_cache.end() && it->second.version == request.version) {
+                m_cache.erase(it);
+            }
+        }
+    }
+}
+
+std::string ChunkDeltaStore::GetDeltaPath(ChunkCoord coord) const {
+    return m_directory + "/chunk_" + std::to_string(coord.x) + "_" + std::to_string(coord.z) + ".delta";
+}
+
+bool ChunkDeltaStore::WriteDelta(const ChunkDelta& delta) const {
+    std::vector<u8> data = Encode(delta);
+    std::string path = GetDeltaPath(delta.coord);
+    std::string temp_path = path + ".tmp";
+
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG_ERROR("ChunkDeltaStore: failed to open {}", temp_path);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            LOG_ERROR("ChunkDeltaStore: failed to write {}", temp_path);
+            return false;
+        }
+    }
+
+    // Rename so readers never see a half-written delta
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_ERROR("ChunkDeltaStore: failed to replace {}: {}", path, ec.message());
+        return false;
+    }
+
+    return true;
+}
+
+bool ChunkDeltaStore::ReadDelta(ChunkCoord coord, ChunkDelta& out) const {
+    std::ifstream file(GetDeltaPath(coord), std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    std::streamsize size = file.tellg();
+    if (size <= 0) return false;
+
+    std::vector<u8> data(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), size)) return false;
+
+    return Decode(data, out) && out.coord == coord;
+}
+
+std::vector<u8> ChunkDeltaStore::Encode(const ChunkDelta& delta) {
+    std::vector<u8> out;
+    out.reserve(HEADER_SIZE + delta.removed_ids.size() * sizeof(u32) +
+                delta.objects.size() * RECORD_SIZE);
+
+    Put(out, DELTA_MAGIC);
+    Put(out, DELTA_VERSION);
+    Put(out, u16{0});
+    Put(out, delta.coord.x);
+    Put(out, delta.coord.z);
+    Put(out, static_cast<u32>(delta.removed_ids.size()));
+    Put(out, static_cast<u32>(delta.objects.size()));
+
+    for (u32 id : delta.removed_ids) {
+        Put(out, id);
+    }
+
+    for (const auto& record : delta.objects) {
+        std::string_view mesh_path = AssetPath(record.mesh);
+        std::string_view material_path = AssetPath(record.material);
+
+        Put(out, record.persistent_id);
+        PutVec3(out, record.position);
+        PutVec3(out, record.half_extents);
+        Put(out, record.color.x);
+        Put(out, record.color.y);
+        Put(out, record.color.z);
+        Put(out, record.color.w);
+        Put(out, static_cast<u8>(record.visible ? 1 : 0));
+        Put(out, static_cast<u16>(mesh_path.size()));
+        Put(out, static_cast<u16>(material_path.size()));
+        out.insert(out.end(), mesh_path.begin(), mesh_path.end());
+        out.insert(out.end(), material_path.begin(), material_path.end());
+    }
+
+    return out;
+}
+
+bool ChunkDeltaStore::Decode(std::span<const u8> data, ChunkDelta& out) {
+    if (data.size() < HEADER_SIZE) return false;
+
+    const u8* cursor = data.data();
+    if (Take<u32>(cursor) != DELTA_MAGIC) return false;
+    if (Take<u16>(cursor) != DELTA_VERSION) return false;
+    Take<u16>(cursor);  // Reserved
+
+    out.coord.x = Take<i32>(cursor);
+    out.coord.z = Take<i32>(cursor);
+    u32 removed_count = Take<u32>(cursor);
+    u32 object_count = Take<u32>(cursor);
+
+    // Minimum size (all paths empty); the paths are checked per record
+    size_t minimum = HEADER_SIZE + static_cast<size_t>(removed_count) * sizeof(u32) +
+                     static_cast<size_t>(object_count) * RECORD_SIZE;
+    if (data.size() < minimum) return false;
+    const u8* end = data.data() + data.size();
+
+    out.removed_ids.resize(removed_count);
+    for (u32& id : out.removed_ids) {
+        id = Take<u32>(cursor);
+    }
+
+    out.objects.resize(object_count);
+    for (auto& record : out.objects) {
+        if (static_cast<size_t>(end - cursor) < RECORD_SIZE) return false;
+
+        record.persistent_id = Take<u32>(cursor);
+        record.entity = INVALID_ENTITY;  // Runtime handles do not survive a restart
+        record.position = TakeVec3(cursor);
+        record.half_extents = TakeVec3(cursor);
+        record.color.x = Take<float>(cursor);
+        record.color.y = Take<float>(cursor);
+        record.color.z = Take<float>(cursor);
+        record.color.w = Take<float>(cursor);
+        record.visible = Take<u8>(cursor) != 0;
+
+        u16 mesh_length = Take<u16>(cursor);
+        u16 material_length = Take<u16>(cursor);
+        if (static_cast<size_t>(end - cursor) < static_cast<size_t>(mesh_length) + material_length) return false;
+        record.mesh = TakeAssetPath(cursor, mesh_length);
+        record.material = TakeAssetPath(cursor, material_length);
+    }
+
+    return cursor == end;
+}
+
+} // namespace action
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/string_id.h"
+#include "chunk_coord.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace action {
+
+/*
+ * Chunk Delta Persistence
+ *
+ * Runtime changes to a chunk (moved, spawned or destroyed objects) are
+ * captured as a compact delta when the chunk unloads and re-applied when
+ * it streams back in.
+ *
+ * - Objects are matched by persistent_id (0 = transient, never saved)
+ * - Meshes and materials are saved as asset paths; runtime handles are
+ *   only reused within the session that created them
+ * - All disk I/O runs on one background thread; writes are batched
+ * - The newest delta is served from memory until its write lands
+ * - Empty directory = memory only (survives unload, not restart)
+ */
+
+// Saved state of one persistent object
+struct ChunkObjectRecord {
+    u32 persistent_id = 0;
+    Entity entity = INVALID_ENTITY;  // Runtime only, not written to disk
+    vec3 position;
+    vec3 half_extents;
+    AssetID mesh;                    // Invalid for procedural meshes
+    AssetID material;
+    MeshHandle mesh_handle;          // Runtime only, not written to disk
+    MaterialHandle material_handle;  // Runtime only, not written to disk
+    vec4 color;
+    bool visible = true;
+};
+
+// Everything that differs from a chunk's authored content
+struct ChunkDelta {
+    ChunkCoord coord{0, 0};
+    std::vector<u32> removed_ids;            // Persistent objects destroyed at runtime
+    std::vector<ChunkObjectRecord> objects;  // Current state of persistent objects
+};
+
+class ChunkDeltaStore {
+public:
+    ChunkDeltaStore() = default;
+    ~ChunkDeltaStore();
+
+    bool Initialize(const std::string& directory);
+    void Shutdown();  // Flushes queued writes before returning
+
+    // Main thread API - never touches the disk
+    void Store(ChunkDelta delta);
+    bool HasDelta(ChunkCoord coord) const;
+    void RequestLoad(ChunkCoord coord);
+    void CollectLoaded(std::vector<ChunkDelta>& out);
+    void Discard();  // Forget all deltas (files already written are kept)
+
+    // Stats
+    u32 GetQueuedWriteCount() const;
+    u32 GetQueuedReadCount() const;
+    bool IsPersistent() const { return !m_directory.empty(); }
+
+    // Compact binary encoding
+    static std::vector<u8> Encode(const ChunkDelta& delta);
+    static bool Decode(std::span<const u8> data, ChunkDelta& out);
+
+private:
+    struct CachedDelta {
+        ChunkDelta delta;
+        u64 version = 0;
+    };
+
+    struct WriteRequest {
+        ChunkDelta delta;
+        u64 version = 0;
+    };
+
+    void IOThread();
+    std::string GetDeltaPath(ChunkCoord coord) const;
+    bool WriteDelta(const ChunkDelta& delta) const;
+    bool ReadDelta(ChunkCoord coord, ChunkDelta& out) const;
+
+    std::string m_directory;
+
+    // Everything below is guarded by m_mutex; disk I/O happens outside it
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    // Newest delta per chunk until it is safely on disk
+    std::unordered_map<ChunkCoord, CachedDelta, ChunkCoordHash> m_cache;
+    // Chunks with a delta file written (this session or a previous one)
+    std::unordered_set<ChunkCoord, ChunkCoordHash> m_on_disk;
+    u64 m_next_version = 1;
+
+    std::vector<WriteRequest> m_write_queue;
+    std::vector<ChunkCoord> m_read_queue;
+    std::vector<ChunkDelta> m_loaded;
+
+    std::thread m_io_thread;
+    std::atomic<bool> m_running{false};
+
+    // Writes wait this long so bursts of unloads land in one batch
+    static constexpr u32 WRITE_BATCH_DELAY_MS = 100;
+};
+
+} // namespace action
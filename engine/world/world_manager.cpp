@@ -1,4 +1,5 @@
 #include "world_manager.h"
+#include "assets/asset_manager.h"
 #include "core/logging.h"
 #include "core/profiler.h"
 #include <algorithm>
@@ -14,11 +15,26 @@ bool WorldManager::Initialize(const WorldManagerConfig& config) {
              config.hot_zone_radius, config.warm_zone_radius, config.cold_zone_radius);
     LOG_INFO("  Draw distance: {}m", config.draw_distance);
     
+    if (!m_deltas.Initialize(config.delta_directory)) {
+        LOG_WARN("WorldManager: chunk deltas will not persist across sessions");
+    }
+    
     return true;
 }
 
 void WorldManager::Shutdown() {
+    // Chunks still resident at exit are saved as if they had unloaded
+    for (auto& [coord, chunk] : m_chunks) {
+        if (chunk.dirty && !chunk.delta_pending) {
+            m_deltas.Store(BuildDelta(chunk));
+        }
+        ReleaseChunkAssets(chunk);
+    }
+    m_deltas.Shutdown();
+    
     m_chunks.clear();
+    m_entity_to_chunk.clear();
+    m_persistent_to_chunk.clear();
     m_load_queue.clear();
     m_unload_queue.clear();
     
@@ -32,11 +48,17 @@ void WorldManager::Update(const vec3& player_pos, const vec3& player_velocity, f
     m_player_velocity = player_velocity;
     m_time += dt;
     
+    // Finish chunks whose saved delta arrived from the I/O thread
+    ApplyLoadedDeltas();
+    
     // Update streaming priorities
     UpdateStreamingPriorities(player_pos, player_velocity);
     
     // Process streaming queue
     ProcessStreamingQueue();
+    
+    // Reduced tick rates for distant entities
+    UpdateSimulationLOD(dt);
 }
 
 void WorldManager::GatherVisibleObjects(const Camera& camera, RenderList& out_list) {
@@ -166,18 +188,25 @@ Chunk* WorldManager::LoadChunk(ChunkCoord coord) {
     chunk.coord = coord;
     chunk.state = ChunkState::Loading;
     
-    // Calculate bounds
-    vec3 min_pos = ChunkToWorld(coord);
-    vec3 max_pos = min_pos + vec3(m_config.chunk_size, 1000.0f, m_config.chunk_size);
-    chunk.bounds = AABB(min_pos, max_pos);
+    chunk.bounds = GetChunkBounds(coord);
     
-    // TODO: Load chunk data from disk asynchronously
-    // For now, mark as loaded immediately
-    chunk.state = ChunkState::Loaded;
+    // Chunks with saved runtime changes stay Loading until the delta arrives;
+    // everything else has no on-disk content yet and is ready immediately
+    if (m_deltas.HasDelta(coord)) {
+        chunk.delta_pending = true;
+        m_deltas.RequestLoad(coord);
+    } else {
+        chunk.state = ChunkState::Loaded;
+    }
     chunk.last_access_time = m_time;
     
     auto [it, inserted] = m_chunks.emplace(coord, std::move(chunk));
     
+    if (m_chunk_load_callback) {
+        m_chunk_load_callback(it->second);
+    }
+    m_memory_usage += it->second.memory_usage;
+    
     LOG_DEBUG("Loaded chunk ({}, {})", coord.x, coord.z);
     
     return &it->second;
@@ -189,13 +218,24 @@ void WorldManager::UnloadChunk(ChunkCoord coord) {
     
     Chunk& chunk = it->second;
     
-    // Remove entities from index
-    for (Entity entity : chunk.entities) {
-        m_entity_to_chunk.erase(entity);
+    // Remove entities and persistent IDs from the indices
+    for (const auto& obj : chunk.objects) {
+        if (obj.entity != INVALID_ENTITY) m_entity_to_chunk.erase(obj.entity);
+        if (obj.persistent_id != 0) m_persistent_to_chunk.erase(obj.persistent_id);
     }
     
-    // TODO: Save modified chunk data
+    // Persist runtime changes; the write happens on the delta store's I/O thread
+    if (chunk.dirty) {
+        if (chunk.delta_pending) {
+            // Saving now would overwrite the delta we never got to apply
+            LOG_WARN("Chunk ({}, {}) unloaded before its delta loaded, changes dropped",
+                     coord.x, coord.z);
+        } else {
+            m_deltas.Store(BuildDelta(chunk));
+        }
+    }
     
+    ReleaseChunkAssets(chunk);
     m_memory_usage -= chunk.memory_usage;
     m_chunks.erase(it);
     
@@ -203,6 +243,15 @@ void WorldManager::UnloadChunk(ChunkCoord coord) {
 }
 
 void WorldManager::AddObject(const WorldObject& object) {
+    // Re-adding an indexed entity would leave a stale slot behind. This is a
+    // move, not a destruction, so it is not recorded in removed_ids.
+    if (auto it = m_entity_to_chunk.find(object.entity); it != m_entity_to_chunk.end()) {
+        ObjectLocation loc = it->second;
+        if (Chunk* old_chunk = GetChunk(loc.chunk)) {
+            SwapRemoveFromChunk(*old_chunk, loc.slot);
+        }
+    }
+    
     ChunkCoord coord = WorldToChunk(object.position);
     
     Chunk* chunk = GetChunk(coord);
@@ -210,11 +259,38 @@ void WorldManager::AddObject(const WorldObject& object) {
         chunk = LoadChunk(coord);
     }
     
-    chunk->objects.push_back(object);
-    chunk->entities.push_back(object.entity);
+    if (object.persistent_id != 0) {
+        // Destroyed at runtime: authored content must not bring it back
+        // (chunks still waiting for their delta are filtered in ApplyDelta)
+        if (std::find(chunk->removed_ids.begin(), chunk->removed_ids.end(), object.persistent_id) !=
+            chunk->removed_ids.end()) {
+            return;
+        }
+        
+        if (auto it = m_persistent_to_chunk.find(object.persistent_id); it != m_persistent_to_chunk.end()) {
+            ObjectLocation loc = it->second;
+            Chunk& owner = *GetChunk(loc.chunk);
+            
+            // Restored from a delta: the saved state is newer than the authored
+            // one, so keep it and attach the live entity to it
+            if (owner.entities[loc.slot] == INVALID_ENTITY && object.entity != INVALID_ENTITY) {
+                WorldObject& restored = owner.objects[loc.slot];
+                restored.entity = object.entity;
+                owner.entities[loc.slot] = object.entity;
+                m_entity_to_chunk[object.entity] = loc;
+                SyncEntityPosition(restored);
+                return;
+            }
+            
+            // Same object added twice: the new copy replaces the old one
+            SwapRemoveFromChunk(owner, loc.slot);
+        }
+    }
     
-    // Index entity for O(1) lookup
-    m_entity_to_chunk[object.entity] = coord;
+    InsertIntoChunk(*chunk, object);
+    if (object.persistent_id != 0) {
+        chunk->dirty = true;
+    }
 }
 
 void WorldManager::RemoveObject(Entity entity) {
@@ -223,38 +299,92 @@ void WorldManager::RemoveObject(Entity entity) {
     if (it == m_entity_to_chunk.end()) {
         return;  // Entity not found
     }
-    
-    ChunkCoord coord = it->second;
-    Chunk* chunk = GetChunk(coord);
-    if (!chunk) {
-        m_entity_to_chunk.erase(it);
+    RemoveObjectAt(it->second);
+}
+
+void WorldManager::RemovePersistentObject(u32 persistent_id) {
+    auto it = m_persistent_to_chunk.find(persistent_id);
+    if (it == m_persistent_to_chunk.end()) {
         return;
     }
+    RemoveObjectAt(it->second);
+}
+
+void WorldManager::RemoveObjectAt(ObjectLocation loc) {
+    Chunk* chunk = GetChunk(loc.chunk);
+    if (!chunk) {
+        return;  // Index entries are dropped when their chunk unloads
+    }
     
-    auto obj_it = std::find_if(chunk->objects.begin(), chunk->objects.end(),
-                                [entity](const WorldObject& o) { 
-                                    return o.entity == entity; 
-                                });
-    
-    if (obj_it != chunk->objects.end()) {
-        chunk->objects.erase(obj_it);
+    u32 persistent_id = chunk->objects[loc.slot].persistent_id;
+    if (persistent_id != 0) {
+        chunk->removed_ids.push_back(persistent_id);
+        chunk->dirty = true;
     }
     
-    auto ent_it = std::find(chunk->entities.begin(), chunk->entities.end(), entity);
-    if (ent_it != chunk->entities.end()) {
-        chunk->entities.erase(ent_it);
+    SwapRemoveFromChunk(*chunk, loc.slot);
+}
+
+void WorldManager::InsertIntoChunk(Chunk& chunk, const WorldObject& object) {
+    u32 slot = static_cast<u32>(chunk.objects.size());
+    chunk.objects.push_back(object);
+    chunk.entities.push_back(object.entity);
+    
+    // Index entity for O(1) lookup (standalone restored objects have none)
+    if (object.entity != INVALID_ENTITY) {
+        m_entity_to_chunk[object.entity] = {chunk.coord, slot};
+    }
+    if (object.persistent_id != 0) {
+        m_persistent_to_chunk[object.persistent_id] = {chunk.coord, slot};
+    }
+}
+
+void WorldManager::SwapRemoveFromChunk(Chunk& chunk, u32 slot) {
+    ENGINE_DEBUG_ASSERT(slot < chunk.objects.size(), "WorldManager: slot out of range");
+    ENGINE_DEBUG_ASSERT(chunk.objects.size() == chunk.entities.size(),
+                        "WorldManager: chunk arrays out of sync");
+    
+    Entity removed = chunk.entities[slot];
+    u32 removed_id = chunk.objects[slot].persistent_id;
+    u32 last = static_cast<u32>(chunk.objects.size() - 1);
+    
+    // Move the last object into the hole and re-point its index entries
+    if (slot != last) {
+        chunk.objects[slot] = std::move(chunk.objects[last]);
+        chunk.entities[slot] = chunk.entities[last];
+        if (chunk.entities[slot] != INVALID_ENTITY) {
+            m_entity_to_chunk[chunk.entities[slot]].slot = slot;
+        }
+        if (chunk.objects[slot].persistent_id != 0) {
+            m_persistent_to_chunk[chunk.objects[slot].persistent_id].slot = slot;
+        }
     }
     
-    m_entity_to_chunk.erase(it);
+    chunk.objects.pop_back();
+    chunk.entities.pop_back();
+    if (removed != INVALID_ENTITY) {
+        m_entity_to_chunk.erase(removed);
+    }
+    if (removed_id != 0) {
+        m_persistent_to_chunk.erase(removed_id);
+    }
 }
 
 void WorldManager::Clear() {
     // Clear all chunks and objects
+    for (auto& [coord, chunk] : m_chunks) {
+        ReleaseChunkAssets(chunk);
+    }
     m_chunks.clear();
     m_entity_to_chunk.clear();
+    m_persistent_to_chunk.clear();
     m_load_queue.clear();
     m_unload_queue.clear();
     m_memory_usage = 0;
+    m_origin_chunk = {0, 0};
+    
+    // Saved deltas belong to the previous scene
+    m_deltas.Discard();
 }
 
 Entity WorldManager::PickObject(const Ray& ray, float max_distance) {
@@ -319,59 +449,190 @@ void WorldManager::UpdateObject(Entity entity, const vec3& position, const vec4&
     if (it == m_entity_to_chunk.end()) {
         return;  // Entity not found
     }
-    
-    ChunkCoord old_coord = it->second;
+    UpdateObjectAt(it->second, position, color);
+}
+
+void WorldManager::UpdatePersistentObject(u32 persistent_id, const vec3& position, const vec4& color) {
+    auto it = m_persistent_to_chunk.find(persistent_id);
+    if (it == m_persistent_to_chunk.end()) {
+        return;
+    }
+    UpdateObjectAt(it->second, position, color);
+}
+
+void WorldManager::UpdateObjectAt(ObjectLocation loc, const vec3& position, const vec4& color) {
     ChunkCoord new_coord = WorldToChunk(position);
     
-    Chunk* old_chunk = GetChunk(old_coord);
+    Chunk* old_chunk = GetChunk(loc.chunk);
     if (!old_chunk) {
-        m_entity_to_chunk.erase(it);
+        return;  // Index entries are dropped when their chunk unloads
+    }
+    
+    WorldObject& obj = old_chunk->objects[loc.slot];
+    
+    // Editor syncs every node each frame; only real changes dirty the chunk
+    bool changed = obj.position.x != position.x || obj.position.y != position.y ||
+                   obj.position.z != position.z || obj.color.x != color.x ||
+                   obj.color.y != color.y || obj.color.z != color.z || obj.color.w != color.w;
+    if (!changed) {
         return;
     }
+    if (obj.persistent_id != 0) {
+        old_chunk->dirty = true;
+    }
     
-    // Check if entity moved to a different chunk
-    if (new_coord == old_coord) {
-        // Same chunk - just update position/color
-        for (auto& obj : old_chunk->objects) {
-            if (obj.entity == entity) {
-                obj.position = position;
-                obj.color = color;
-                vec3 half_size = obj.bounds.extents();
-                obj.bounds = AABB(position - half_size, position + half_size);
-                return;
-            }
+    obj.position = position;
+    obj.color = color;
+    vec3 half_size = obj.bounds.extents();
+    obj.bounds = AABB(position - half_size, position + half_size);
+    
+    // Same chunk - updated in place
+    if (new_coord == loc.chunk) {
+        return;
+    }
+    
+    // Entity moved to different chunk - relocate it.
+    // Resolve the destination first: LoadChunk may rehash m_chunks,
+    // but node-based storage keeps old_chunk valid.
+    Chunk* new_chunk = GetChunk(new_coord);
+    if (!new_chunk) {
+        new_chunk = LoadChunk(new_coord);
+    }
+    
+    WorldObject moved = std::move(obj);
+    SwapRemoveFromChunk(*old_chunk, loc.slot);
+    InsertIntoChunk(*new_chunk, moved);
+    if (moved.persistent_id != 0) {
+        new_chunk->dirty = true;
+    }
+}
+
+ChunkDelta WorldManager::BuildDelta(const Chunk& chunk) const {
+    ChunkDelta delta;
+    delta.coord = chunk.coord;
+    delta.removed_ids = chunk.removed_ids;
+    
+    // Chunk has no authored content yet, so every persistent object is delta.
+    // Positions are stored in absolute space so the origin can move freely.
+    vec3 origin = vec3(static_cast<float>(m_origin_chunk.x) * m_config.chunk_size, 0.0f,
+                       static_cast<float>(m_origin_chunk.z) * m_config.chunk_size);
+    
+    for (const auto& obj : chunk.objects) {
+        if (obj.persistent_id == 0) continue;
+        
+        ChunkObjectRecord record;
+        record.persistent_id = obj.persistent_id;
+        record.entity = obj.entity;
+        record.position = obj.position + origin;
+        record.half_extents = obj.bounds.extents();
+        record.mesh = m_assets ? m_assets->GetMeshID(obj.mesh) : AssetID{};
+        record.material = m_assets ? m_assets->GetMaterialID(obj.material) : AssetID{};
+        record.mesh_handle = obj.mesh;
+        record.material_handle = obj.material;
+        record.color = obj.color;
+        record.visible = obj.visible;
+        delta.objects.push_back(record);
+    }
+    
+    return delta;
+}
+
+void WorldManager::ApplyDelta(Chunk& chunk, const ChunkDelta& delta) {
+    // Keep removals made while the delta was loading
+    for (u32 id : delta.removed_ids) {
+        if (std::find(chunk.removed_ids.begin(), chunk.removed_ids.end(), id) == chunk.removed_ids.end()) {
+            chunk.removed_ids.push_back(id);
         }
-    } else {
-        // Entity moved to different chunk - relocate it
-        for (auto obj_it = old_chunk->objects.begin(); obj_it != old_chunk->objects.end(); ++obj_it) {
-            if (obj_it->entity == entity) {
-                WorldObject obj = *obj_it;
-                obj.position = position;
-                obj.color = color;
-                vec3 half_size = obj.bounds.extents();
-                obj.bounds = AABB(position - half_size, position + half_size);
-                
-                // Remove from old chunk
-                old_chunk->objects.erase(obj_it);
-                auto ent_it = std::find(old_chunk->entities.begin(), old_chunk->entities.end(), entity);
-                if (ent_it != old_chunk->entities.end()) {
-                    old_chunk->entities.erase(ent_it);
-                }
-                
-                // Add to new chunk
-                Chunk* new_chunk = GetChunk(new_coord);
-                if (!new_chunk) {
-                    new_chunk = LoadChunk(new_coord);
-                }
-                new_chunk->objects.push_back(obj);
-                new_chunk->entities.push_back(entity);
-                
-                // Update index
-                m_entity_to_chunk[entity] = new_coord;
-                return;
+    }
+    
+    // Destroyed objects that were authored again while the delta was loading
+    for (u32 id : chunk.removed_ids) {
+        auto it = m_persistent_to_chunk.find(id);
+        if (it != m_persistent_to_chunk.end() && it->second.chunk == chunk.coord) {
+            SwapRemoveFromChunk(chunk, it->second.slot);
+        }
+    }
+    
+    vec3 origin = vec3(static_cast<float>(m_origin_chunk.x) * m_config.chunk_size, 0.0f,
+                       static_cast<float>(m_origin_chunk.z) * m_config.chunk_size);
+    
+    for (const auto& record : delta.objects) {
+        WorldObject obj;
+        obj.position = record.position - origin;
+        obj.bounds = AABB(obj.position - record.half_extents, obj.position + record.half_extents);
+        
+        // Assets are resolved by path (handles from a previous session mean nothing);
+        // procedural meshes have no path and keep their handle within the session
+        obj.mesh = record.mesh_handle;
+        obj.material = record.material_handle;
+        if (m_assets && record.mesh.IsValid()) {
+            obj.mesh = m_assets->LoadMesh(record.mesh);
+            if (obj.mesh.is_valid()) {
+                chunk.mesh_refs.push_back(obj.mesh);
             }
         }
+        if (m_assets && record.material.IsValid()) {
+            obj.material = m_assets->LoadMaterial(record.material);
+        }
+        obj.color = record.color;
+        obj.lod_level = 0;
+        obj.visible = record.visible;
+        obj.persistent_id = record.persistent_id;
+        
+        // Already added again while the delta was loading (in any chunk): the
+        // saved state replaces that copy, which keeps its live entity
+        if (auto it = m_persistent_to_chunk.find(obj.persistent_id); it != m_persistent_to_chunk.end()) {
+            ObjectLocation loc = it->second;
+            Chunk& owner = *GetChunk(loc.chunk);
+            obj.entity = owner.entities[loc.slot];
+            SwapRemoveFromChunk(owner, loc.slot);
+            InsertIntoChunk(chunk, obj);
+            SyncEntityPosition(obj);
+            continue;
+        }
+        
+        // Re-attach the live entity if it survived the unload (same session) and
+        // nothing else has claimed it; otherwise the object renders standalone
+        bool reattach = record.entity != INVALID_ENTITY && m_ecs && m_ecs->IsAlive(record.entity) &&
+                        !m_entity_to_chunk.contains(record.entity);
+        obj.entity = reattach ? record.entity : INVALID_ENTITY;
+        
+        InsertIntoChunk(chunk, obj);
+    }
+}
+
+void WorldManager::SyncEntityPosition(const WorldObject& object) {
+    if (object.entity == INVALID_ENTITY || !m_ecs || !m_ecs->IsAlive(object.entity)) return;
+    
+    if (auto* transform = m_ecs->GetComponent<TransformComponent>(object.entity)) {
+        transform->position = object.position;
+    }
+}
+
+void WorldManager::ApplyLoadedDeltas() {
+    m_loaded_deltas.clear();
+    m_deltas.CollectLoaded(m_loaded_deltas);
+    
+    for (const auto& delta : m_loaded_deltas) {
+        Chunk* chunk = GetChunk(delta.coord);
+        if (!chunk || !chunk->delta_pending) continue;  // Unloaded again meanwhile
+        
+        ApplyDelta(*chunk, delta);
+        chunk->delta_pending = false;
+        chunk->state = ChunkState::Loaded;
+        
+        LOG_DEBUG("Applied delta to chunk ({}, {}): {} objects, {} removed",
+                  delta.coord.x, delta.coord.z, delta.objects.size(), delta.removed_ids.size());
+    }
+}
+
+void WorldManager::ReleaseChunkAssets(Chunk& chunk) {
+    if (m_assets) {
+        for (MeshHandle mesh : chunk.mesh_refs) {
+            m_assets->Release(mesh);
+        }
     }
+    chunk.mesh_refs.clear();
 }
 
 std::vector<Entity> WorldManager::QuerySphere(const vec3& center, float radius) {
@@ -389,7 +650,7 @@ std::vector<Entity> WorldManager::QuerySphere(const vec3& center, float radius)
             if (!chunk) continue;
             
             for (const auto& obj : chunk->objects) {
-                if (distance_sq(obj.position, center) <= radius_sq) {
+                if (obj.entity != INVALID_ENTITY && distance_sq(obj.position, center) <= radius_sq) {
                     result.push_back(obj.entity);
                 }
             }
@@ -411,7 +672,7 @@ std::vector<Entity> WorldManager::QueryAABB(const AABB& bounds) {
             if (!chunk) continue;
             
             for (const auto& obj : chunk->objects) {
-                if (bounds.intersects(obj.bounds)) {
+                if (obj.entity != INVALID_ENTITY && bounds.intersects(obj.bounds)) {
                     result.push_back(obj.entity);
                 }
             }
@@ -423,19 +684,68 @@ std::vector<Entity> WorldManager::QueryAABB(const AABB& bounds) {
 
 ChunkCoord WorldManager::WorldToChunk(const vec3& pos) const {
     return {
-        static_cast<i32>(std::floor(pos.x / m_config.chunk_size)),
-        static_cast<i32>(std::floor(pos.z / m_config.chunk_size))
+        static_cast<i32>(std::floor(pos.x / m_config.chunk_size)) + m_origin_chunk.x,
+        static_cast<i32>(std::floor(pos.z / m_config.chunk_size)) + m_origin_chunk.z
     };
 }
 
 vec3 WorldManager::ChunkToWorld(ChunkCoord coord) const {
+    // Integer subtraction first keeps the result exact near the origin
     return {
-        coord.x * m_config.chunk_size,
+        static_cast<float>(coord.x - m_origin_chunk.x) * m_config.chunk_size,
         0.0f,
-        coord.z * m_config.chunk_size
+        static_cast<float>(coord.z - m_origin_chunk.z) * m_config.chunk_size
     };
 }
 
+AABB WorldManager::GetChunkBounds(ChunkCoord coord) const {
+    vec3 min_pos = ChunkToWorld(coord);
+    vec3 max_pos = min_pos + vec3(m_config.chunk_size, 1000.0f, m_config.chunk_size);
+    return AABB(min_pos, max_pos);
+}
+
+bool WorldManager::ShouldRebaseOrigin(const vec3& player_pos) const {
+    if (m_config.origin_rebase_distance <= 0.0f) return false;
+    
+    float limit = m_config.origin_rebase_distance;
+    return std::abs(player_pos.x) > limit || std::abs(player_pos.z) > limit;
+}
+
+vec3 WorldManager::RebaseOrigin(const vec3& player_pos) {
+    return SetOriginChunk(WorldToChunk(player_pos));
+}
+
+vec3 WorldManager::ResetOrigin() {
+    return SetOriginChunk({0, 0});
+}
+
+vec3 WorldManager::SetOriginChunk(ChunkCoord new_origin) {
+    PROFILE_SCOPE("WorldManager::SetOriginChunk");
+    
+    if (new_origin == m_origin_chunk) {
+        return {0, 0, 0};
+    }
+    
+    // Shift is a whole number of chunks, so it is exact for power-of-two sizes
+    vec3 shift = ChunkToWorld(new_origin);
+    m_origin_chunk = new_origin;
+    
+    for (auto& [coord, chunk] : m_chunks) {
+        chunk.bounds = AABB(chunk.bounds.min - shift, chunk.bounds.max - shift);
+        
+        for (auto& obj : chunk.objects) {
+            obj.position = obj.position - shift;
+            obj.bounds = AABB(obj.bounds.min - shift, obj.bounds.max - shift);
+        }
+    }
+    
+    m_player_pos = m_player_pos - shift;
+    
+    LOG_INFO("World origin rebased to chunk ({}, {})", new_origin.x, new_origin.z);
+    
+    return shift;
+}
+
 void WorldManager::UpdateStreamingPriorities(const vec3& player_pos, const vec3& player_velocity) {
     PROFILE_SCOPE("UpdateStreamingPriorities");
     
@@ -443,8 +753,7 @@ void WorldManager::UpdateStreamingPriorities(const vec3& player_pos, const vec3&
     ChunkCoord player_chunk = WorldToChunk(player_pos);
     
     // Prediction based on velocity
-    float prediction_time = 2.0f;  // Look ahead 2 seconds
-    vec3 predicted_pos = player_pos + player_velocity * prediction_time;
+    vec3 predicted_pos = player_pos + player_velocity * m_config.prediction_time;
     ChunkCoord predicted_chunk = WorldToChunk(predicted_pos);
     
     // Calculate loading radius in chunks
@@ -455,13 +764,19 @@ void WorldManager::UpdateStreamingPriorities(const vec3& player_pos, const vec3&
     m_unload_queue.clear();
     
     // Find chunks to load (around player and prediction)
-    for (i32 dx = -cold_radius; dx <= cold_radius; ++dx) {
-        for (i32 dz = -cold_radius; dz <= cold_radius; ++dz) {
-            ChunkCoord coord = {player_chunk.x + dx, player_chunk.z + dz};
+    i32 min_x = std::min(player_chunk.x, predicted_chunk.x) - cold_radius;
+    i32 max_x = std::max(player_chunk.x, predicted_chunk.x) + cold_radius;
+    i32 min_z = std::min(player_chunk.z, predicted_chunk.z) - cold_radius;
+    i32 max_z = std::max(player_chunk.z, predicted_chunk.z) + cold_radius;
+    
+    for (i32 x = min_x; x <= max_x; ++x) {
+        for (i32 z = min_z; z <= max_z; ++z) {
+            ChunkCoord coord = {x, z};
             
-            // Check if within streaming distance
+            // Check if within streaming distance of either position
             vec3 chunk_center = ChunkToWorld(coord) + vec3(m_config.chunk_size * 0.5f, 0, m_config.chunk_size * 0.5f);
-            float dist = length(chunk_center - player_pos);
+            float dist = std::min(length(chunk_center - player_pos),
+                                  length(chunk_center - predicted_pos));
             
             if (dist <= m_config.cold_zone_radius) {
                 if (!GetChunk(coord)) {
@@ -471,29 +786,31 @@ void WorldManager::UpdateStreamingPriorities(const vec3& player_pos, const vec3&
         }
     }
     
-    // Find chunks to unload (too far from player)
+    // Find chunks to unload (too far from player and prediction)
     for (auto& [coord, chunk] : m_chunks) {
         vec3 chunk_center = ChunkToWorld(coord) + vec3(m_config.chunk_size * 0.5f, 0, m_config.chunk_size * 0.5f);
-        float dist = length(chunk_center - player_pos);
+        float dist = std::min(length(chunk_center - player_pos),
+                              length(chunk_center - predicted_pos));
         
         // Add hysteresis to prevent thrashing
         if (dist > m_config.cold_zone_radius * 1.2f) {
             m_unload_queue.push_back(coord);
         }
         
-        // Update chunk state based on zone
-        Zone zone = GetZone(chunk_center, player_pos);
+        // Update chunk state based on zone (pending chunks stay Loading)
+        SimZone zone = GetZone(chunk_center, player_pos);
+        ChunkState zone_state = chunk.delta_pending ? ChunkState::Loading : ChunkState::Loaded;
         switch (zone) {
-            case Zone::Hot:
-                chunk.state = ChunkState::Active;
+            case SimZone::Hot:
+                chunk.state = chunk.delta_pending ? ChunkState::Loading : ChunkState::Active;
                 chunk.priority = StreamPriority::Critical;
                 break;
-            case Zone::Warm:
-                chunk.state = ChunkState::Loaded;
+            case SimZone::Warm:
+                chunk.state = zone_state;
                 chunk.priority = StreamPriority::High;
                 break;
-            case Zone::Cold:
-                chunk.state = ChunkState::Loaded;
+            case SimZone::Cold:
+                chunk.state = zone_state;
                 chunk.priority = StreamPriority::Normal;
                 break;
             default:
@@ -504,10 +821,11 @@ void WorldManager::UpdateStreamingPriorities(const vec3& player_pos, const vec3&
         chunk.last_access_time = m_time;
     }
     
-    // Sort load queue by priority (closest first)
+    // Sort load queue by priority, ascending: ProcessStreamingQueue pops from
+    // the back, so the highest-priority chunk must be last
     std::sort(m_load_queue.begin(), m_load_queue.end(),
               [this, &player_pos, &player_velocity](const ChunkCoord& a, const ChunkCoord& b) {
-                  return CalculateStreamPriority(a, player_pos, player_velocity) >
+                  return CalculateStreamPriority(a, player_pos, player_velocity) <
                          CalculateStreamPriority(b, player_pos, player_velocity);
               });
 }
@@ -516,10 +834,9 @@ void WorldManager::ProcessStreamingQueue() {
     PROFILE_SCOPE("ProcessStreamingQueue");
     
     // Load high-priority chunks (limit per frame)
-    constexpr u32 MAX_LOADS_PER_FRAME = 2;
     u32 loads = 0;
     
-    while (!m_load_queue.empty() && loads < MAX_LOADS_PER_FRAME) {
+    while (!m_load_queue.empty() && loads < m_config.max_loads_per_frame) {
         ChunkCoord coord = m_load_queue.back();
         m_load_queue.pop_back();
         
@@ -528,16 +845,22 @@ void WorldManager::ProcessStreamingQueue() {
     }
     
     // Unload low-priority chunks (limit per frame)
-    constexpr u32 MAX_UNLOADS_PER_FRAME = 1;
     u32 unloads = 0;
     
-    while (!m_unload_queue.empty() && unloads < MAX_UNLOADS_PER_FRAME) {
+    while (!m_unload_queue.empty() && unloads < m_config.max_unloads_per_frame) {
         ChunkCoord coord = m_unload_queue.back();
         m_unload_queue.pop_back();
         
         UnloadChunk(coord);
         unloads++;
     }
+    
+    m_stream_stats.chunks_loaded = loads;
+    m_stream_stats.chunks_unloaded = unloads;
+    m_stream_stats.load_queue_depth = static_cast<u32>(m_load_queue.size());
+    m_stream_stats.unload_queue_depth = static_cast<u32>(m_unload_queue.size());
+    m_stream_stats.pending_delta_reads = m_deltas.GetQueuedReadCount();
+    m_stream_stats.pending_delta_writes = m_deltas.GetQueuedWriteCount();
 }
 
 float WorldManager::CalculateStreamPriority(const ChunkCoord& coord,
@@ -560,13 +883,55 @@ float WorldManager::CalculateStreamPriority(const ChunkCoord& coord,
     return priority;
 }
 
-WorldManager::Zone WorldManager::GetZone(const vec3& pos, const vec3& player_pos) const {
+SimZone WorldManager::GetZone(const vec3& pos, const vec3& player_pos) const {
     float dist = length(pos - player_pos);
     
-    if (dist <= m_config.hot_zone_radius) return Zone::Hot;
-    if (dist <= m_config.warm_zone_radius) return Zone::Warm;
-    if (dist <= m_config.cold_zone_radius) return Zone::Cold;
-    return Zone::Outside;
+    if (dist <= m_config.hot_zone_radius) return SimZone::Hot;
+    if (dist <= m_config.warm_zone_radius) return SimZone::Warm;
+    if (dist <= m_config.cold_zone_radius) return SimZone::Cold;
+    return SimZone::Outside;
+}
+
+void WorldManager::UpdateSimulationLOD(float dt) {
+    if (!m_ecs) return;
+    
+    PROFILE_SCOPE("UpdateSimulationLOD");
+    
+    ++m_sim_frame;
+    Entity player = m_ecs->GetPlayerEntity();
+    
+    m_ecs->ForEach<SimulationLODComponent, TransformComponent>(
+        [this, dt, player](Entity entity, SimulationLODComponent& lod, TransformComponent& transform) {
+            lod.previous_zone = lod.zone;
+            lod.zone = entity == player ? SimZone::Hot : GetZone(transform.position, m_player_pos);
+            
+            u32 interval = 1;
+            switch (lod.zone) {
+                case SimZone::Hot:
+                    interval = 1;
+                    break;
+                case SimZone::Warm:
+                    interval = m_config.warm_tick_interval;
+                    break;
+                default:
+                    interval = m_config.cold_tick_interval;
+                    break;
+            }
+            interval = std::clamp<u32>(interval, 1, UINT16_MAX);
+            lod.tick_interval = static_cast<u16>(interval);
+            
+            // Time-slice: the entity index picks the phase, so entities sharing
+            // an interval spread evenly across frames instead of spiking together
+            lod.accumulated_dt += dt;
+            lod.should_tick = (m_sim_frame + EntityIndex(entity)) % interval == 0;
+            
+            if (lod.should_tick) {
+                lod.tick_dt = lod.accumulated_dt;
+                lod.accumulated_dt = 0.0f;
+            } else {
+                lod.tick_dt = 0.0f;
+            }
+        });
 }
 
 } // namespace action
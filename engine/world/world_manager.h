@@ -4,11 +4,16 @@
 #include "gameplay/ecs/ecs.h"
 #include "render/renderer.h"
 #include "render/culling/frustum_culling.h"
+#include "chunk_persistence.h"
 #include <unordered_map>
+#include <functional>
+#include <string>
 #include <vector>
 
 namespace action {
 
+class AssetManager;
+
 /*
  * World Manager - Seamless Streaming System
  * 
@@ -17,6 +22,8 @@ namespace action {
  * - Predictive loading based on player velocity
  * - Streaming rings (hot/warm/cold zones)
  * - No loading screens
+ * - Floating origin (positions stay near 0 for float precision)
+ * - Simulation LOD (distant entities tick at reduced rate)
  * 
  * Optimized for GTX 660:
  * - 2MB/frame streaming budget
@@ -31,19 +38,13 @@ struct WorldManagerConfig {
     float cold_zone_radius = 2000.0f;    // Low LOD, streaming
     float lod_bias = 1.0f;
     float draw_distance = 400.0f;
-};
-
-// Chunk coordinate
-struct ChunkCoord {
-    i32 x, z;
-    
-    bool operator==(const ChunkCoord& o) const { return x == o.x && z == o.z; }
-};
-
-struct ChunkCoordHash {
-    size_t operator()(const ChunkCoord& c) const {
-        return std::hash<i64>{}((static_cast<i64>(c.x) << 32) | static_cast<u32>(c.z));
-    }
+    float prediction_time = 2.0f;        // Velocity look-ahead (seconds)
+    u32 max_loads_per_frame = 2;         // Streaming budget
+    u32 max_unloads_per_frame = 1;
+    u32 warm_tick_interval = 4;          // Simulation LOD: tick every Nth frame
+    u32 cold_tick_interval = 16;         // (1 = full rate)
+    float origin_rebase_distance = 1024.0f;  // Recentre world past this distance (0 = off)
+    std::string delta_directory;             // Chunk delta saves (empty = memory only)
 };
 
 // Streaming priority for assets
@@ -64,6 +65,16 @@ enum class ChunkState : u8 {
     Unloading = 4
 };
 
+// Per-frame streaming counters (profiling and offline tuning)
+struct StreamingStats {
+    u32 chunks_loaded = 0;         // This frame
+    u32 chunks_unloaded = 0;       // This frame
+    u32 load_queue_depth = 0;      // Still waiting after this frame's budget
+    u32 unload_queue_depth = 0;
+    u32 pending_delta_reads = 0;   // Delta store I/O queue
+    u32 pending_delta_writes = 0;
+};
+
 // World object (entity in the world)
 struct WorldObject {
     Entity entity = INVALID_ENTITY;
@@ -74,6 +85,7 @@ struct WorldObject {
     vec4 color{0.8f, 0.8f, 0.8f, 1.0f};  // Object color (default light gray)
     u8 lod_level;
     bool visible;
+    u32 persistent_id = 0;  // Stable ID for chunk delta persistence (0 = transient)
 };
 
 // Chunk data
@@ -82,9 +94,17 @@ struct Chunk {
     ChunkState state = ChunkState::Unloaded;
     AABB bounds;
     
+    // Parallel dense arrays: entities[i] == objects[i].entity.
+    // Removal swaps with the last slot, so order is not stable.
     std::vector<WorldObject> objects;
     std::vector<Entity> entities;
     
+    // Delta persistence
+    std::vector<u32> removed_ids;  // Persistent objects destroyed since authoring
+    std::vector<MeshHandle> mesh_refs;  // Held for restored objects, released on unload
+    bool dirty = false;            // Modified since load, delta must be saved
+    bool delta_pending = false;    // Waiting for saved delta from disk
+    
     // Streaming info
     StreamPriority priority = StreamPriority::Background;
     float last_access_time = 0;
@@ -110,30 +130,68 @@ public:
     Chunk* LoadChunk(ChunkCoord coord);
     void UnloadChunk(ChunkCoord coord);
     
-    // Add object to world (finds appropriate chunk)
+    // Add object to world (finds appropriate chunk). Persistent objects are
+    // matched by persistent_id: destroyed ones stay destroyed, and restored
+    // ones keep their saved state and take the new entity.
     void AddObject(const WorldObject& object);
     void RemoveObject(Entity entity);
     void UpdateObject(Entity entity, const vec3& position, const vec4& color);
     
+    // Same by persistent_id (reaches restored objects that have no entity)
+    void RemovePersistentObject(u32 persistent_id);
+    void UpdatePersistentObject(u32 persistent_id, const vec3& position, const vec4& color);
+    
     // Clear all objects from all chunks
     void Clear();
     
+    // Called after a chunk is created, before it is visible. Fills in content
+    // and Chunk::memory_usage (used by tools to stream synthetic worlds).
+    using ChunkLoadCallback = std::function<void(Chunk& chunk)>;
+    void SetChunkLoadCallback(ChunkLoadCallback callback) { m_chunk_load_callback = std::move(callback); }
+    
     // Raycast picking - returns entity hit by ray, or INVALID_ENTITY if none
     // Returns closest hit along the ray
     Entity PickObject(const Ray& ray, float max_distance = 1000.0f);
     
-    // Query
+    // Query (objects without an entity are not reported)
     std::vector<Entity> QuerySphere(const vec3& center, float radius);
     std::vector<Entity> QueryAABB(const AABB& bounds);
     
+    // Floating origin
+    // All engine positions are relative to a chunk-aligned world origin.
+    // Chunk coordinates stay absolute, so rebasing never re-keys chunks;
+    // only local positions shift by a whole number of chunks on X/Z.
+    bool ShouldRebaseOrigin(const vec3& player_pos) const;
+    vec3 RebaseOrigin(const vec3& player_pos);  // Returns shift subtracted from positions
+    vec3 ResetOrigin();                         // Back to absolute coordinates
+    ChunkCoord GetOriginChunk() const { return m_origin_chunk; }
+    ChunkCoord GetChunkCoord(const vec3& pos) const { return WorldToChunk(pos); }
+    AABB GetChunkBounds(ChunkCoord coord) const;
+    
+    // Simulation zone of a position relative to the current player position
+    SimZone GetZoneAt(const vec3& pos) const { return GetZone(pos, m_player_pos); }
+    
     // Stats
     u32 GetLoadedChunkCount() const { return static_cast<u32>(m_chunks.size()); }
     size_t GetMemoryUsage() const { return m_memory_usage; }
+    const ChunkDeltaStore& GetDeltaStore() const { return m_deltas; }
+    const StreamingStats& GetStreamingStats() const { return m_stream_stats; }
+    const WorldManagerConfig& GetConfig() const { return m_config; }
     
     // Set ECS reference for transform queries
     void SetECS(ECS* ecs) { m_ecs = ecs; }
     
+    // Set asset manager for saving and restoring object meshes/materials in deltas
+    void SetAssetManager(AssetManager* assets) { m_assets = assets; }
+    
 private:
+    // Entity location: owning chunk + dense slot in Chunk::objects/entities.
+    // Gives O(1) lookup, update and swap-remove (instead of O(chunks * objects))
+    struct ObjectLocation {
+        ChunkCoord chunk;
+        u32 slot;
+    };
+    
     // Chunk coordinate from world position
     ChunkCoord WorldToChunk(const vec3& pos) const;
     vec3 ChunkToWorld(ChunkCoord coord) const;
@@ -146,21 +204,47 @@ private:
                                    const vec3& player_velocity);
     
     // Zone classification
-    enum class Zone { Hot, Warm, Cold, Outside };
-    Zone GetZone(const vec3& pos, const vec3& player_pos) const;
+    SimZone GetZone(const vec3& pos, const vec3& player_pos) const;
+    
+    // Assign zones and time-sliced tick schedules (SimulationLODComponent)
+    void UpdateSimulationLOD(float dt);
+    
+    // Moves the origin and shifts all chunk/object positions to match
+    vec3 SetOriginChunk(ChunkCoord new_origin);
+    
+    // Delta persistence
+    ChunkDelta BuildDelta(const Chunk& chunk) const;
+    void ApplyDelta(Chunk& chunk, const ChunkDelta& delta);
+    void ApplyLoadedDeltas();
+    void ReleaseChunkAssets(Chunk& chunk);
+    void SyncEntityPosition(const WorldObject& object);  // Saved state -> entity transform
+    
+    // Dense chunk storage helpers (keep objects/entities/index in sync)
+    void InsertIntoChunk(Chunk& chunk, const WorldObject& object);
+    void SwapRemoveFromChunk(Chunk& chunk, u32 slot);
+    void RemoveObjectAt(ObjectLocation loc);
+    void UpdateObjectAt(ObjectLocation loc, const vec3& position, const vec4& color);
     
     WorldManagerConfig m_config;
     
     // Loaded chunks
     std::unordered_map<ChunkCoord, Chunk, ChunkCoordHash> m_chunks;
     
-    // Entity-to-Chunk index for O(1) lookup (instead of O(chunks * objects))
-    std::unordered_map<Entity, ChunkCoord> m_entity_to_chunk;
+    // Object locations, for O(1) lookup by entity or persistent ID
+    std::unordered_map<Entity, ObjectLocation> m_entity_to_chunk;
+    std::unordered_map<u32, ObjectLocation> m_persistent_to_chunk;  // Persistent objects, by persistent_id
+    
+    // Runtime chunk modifications (saved on unload, re-applied on load)
+    ChunkDeltaStore m_deltas;
+    std::vector<ChunkDelta> m_loaded_deltas;  // Scratch for ApplyLoadedDeltas
     
     // Streaming queue (sorted by priority)
     std::vector<ChunkCoord> m_load_queue;
     std::vector<ChunkCoord> m_unload_queue;
     
+    // Absolute chunk that local position (0, 0, 0) lies in
+    ChunkCoord m_origin_chunk{0, 0};
+    
     // Current player state
     vec3 m_player_pos;
     vec3 m_player_velocity;
@@ -170,12 +254,18 @@ private:
     
     // ECS reference for transform queries
     ECS* m_ecs = nullptr;
+    AssetManager* m_assets = nullptr;
+    
+    // Content hook and stats
+    ChunkLoadCallback m_chunk_load_callback;
+    StreamingStats m_stream_stats;
     
     // Memory tracking
     size_t m_memory_usage = 0;
     size_t m_memory_budget = 800_MB;  // For streaming pool
     
     float m_time = 0;
+    u32 m_sim_frame = 0;
 };
 
 } // namespace action
@@ -134,6 +134,11 @@ int main() {
     player_collider.layer = CollisionLayer::Player;
     player_collider.mask = CollisionLayer::Environment | CollisionLayer::Enemy;
     
+    // Registered so triggers (pickups, zones) get collision events for the player.
+    // The character controller's mask leaves out the Player layer, so its own
+    // sweeps never hit this collider.
+    physics.AddCollider(player);
+    
     // Character controller for kinematic movement
     auto& player_cc = ecs.AddComponent<CharacterControllerComponent>(player);
     player_cc.config.height = 1.8f;
@@ -0,0 +1,53 @@
+#version 450
+
+/*
+ * Forward Shader - Vertex Stage, packed vertex variant
+ *
+ * 16-byte vertices (VertexFormat::Packed16):
+ * - Position: unorm16 x3 within the mesh bounds; the dequantization
+ *   (offset + unorm * extent) is folded into push.model on the CPU
+ * - Normal: octahedral snorm16 x2
+ * - UV: half-float x2
+ *
+ * Outputs match forward.vert, so forward.frag is shared.
+ */
+
+layout(location = 0) in vec4 inPosition;  // xyz in [0, 1], w = padding
+layout(location = 1) in vec2 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(location = 0) out vec3 fragWorldPos;
+layout(location = 1) out vec3 fragNormal;
+layout(location = 2) out vec2 fragTexCoord;
+
+layout(set = 0, binding = 0) uniform CameraUBO {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 cameraPos;
+    float time;
+} camera;
+
+layout(push_constant) uniform PushConstants {
+    mat4 model;         // object transform * dequantization
+    mat4 normalMatrix;  // object transform only
+    vec4 color;
+} push;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main() {
+    vec4 worldPos = push.model * vec4(inPosition.xyz, 1.0);
+
+    fragWorldPos = worldPos.xyz;
+    fragNormal = mat3(push.normalMatrix) * decodeOctahedral(inNormal);
+    fragTexCoord = inTexCoord;
+
+    gl_Position = camera.viewProjection * worldPos;
+}
@@ -0,0 +1,217 @@
+#include "assets/asset_package.h"
+#include "core/logging.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+ * Asset Packer
+ *
+ * Packs a project's assets directory into one AssetPackage file, so the
+ * runtime opens a single file instead of thousands of small ones.
+ *
+ * - Package paths are <prefix>/<path relative to the input directory>; the
+ *   prefix defaults to the input directory's name, matching the paths the
+ *   game loads ("assets/models/rock.mesh")
+ * - Cooked meshes (.mesh) are stored uncompressed so they expand straight
+ *   out of the mapping; other files are compressed when it pays off
+ * - Hidden files/directories and temp files are skipped
+ *
+ * Usage:
+ *   AssetPacker <input_dir> <output.pak> [options]
+ */
+
+using namespace action;
+
+namespace {
+
+struct PackOptions {
+    std::string input_dir;
+    std::string output_path;
+    std::string prefix;
+    bool prefix_set = false;
+    u32 alignment = 64;
+    bool compress = true;
+    std::vector<std::string> store_extensions = {".mesh"};
+    std::vector<std::string> exclude_extensions = {".tmp", ".ddc"};
+    bool verbose = false;
+};
+
+void PrintUsage() {
+    std::printf(
+        "Usage: AssetPacker <input_dir> <output.pak> [options]\n"
+        "  --prefix <path>        Package path prefix (default: input directory name, \"\" for none)\n"
+        "  --align <bytes>        Entry alignment, power of two >= 16 (default 64)\n"
+        "  --no-compress          Store every entry uncompressed\n"
+        "  --store <.ext>         Never compress this extension (repeatable; default .mesh)\n"
+        "  --exclude <.ext>       Skip this extension (repeatable; default .tmp .ddc)\n"
+        "  --verbose              List every packed file\n");
+}
+
+std::vector<std::string> SplitExtensions(const std::string& value) {
+    std::vector<std::string> extensions;
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t end = value.find(',', start);
+        if (end == std::string::npos) end = value.size();
+        std::string extension = value.substr(start, end - start);
+        if (!extension.empty()) {
+            if (extension[0] != '.') extension = "." + extension;
+            extensions.push_back(extension);
+        }
+        start = end + 1;
+    }
+    return extensions;
+}
+
+bool ParseOptions(int argc, char** argv, PackOptions& options) {
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+        if (arg == "--no-compress") {
+            options.compress = false;
+            continue;
+        }
+        if (arg == "--verbose") {
+            options.verbose = true;
+            continue;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--prefix") {
+            options.prefix = value;
+            options.prefix_set = true;
+        } else if (arg == "--align") {
+            options.alignment = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--store") {
+            auto extensions = SplitExtensions(value);
+            options.store_extensions.insert(options.store_extensions.end(), extensions.begin(), extensions.end());
+        } else if (arg == "--exclude") {
+            auto extensions = SplitExtensions(value);
+            options.exclude_extensions.insert(options.exclude_extensions.end(), extensions.begin(), extensions.end());
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if (positional.size() != 2) {
+        PrintUsage();
+        return false;
+    }
+    options.input_dir = positional[0];
+    options.output_path = positional[1];
+
+    if (!options.prefix_set) {
+        std::filesystem::path input = std::filesystem::path(options.input_dir).lexically_normal();
+        if (!input.has_filename()) input = input.parent_path();
+        options.prefix = input.filename().string();
+    }
+    return true;
+}
+
+bool HasExtension(const std::vector<std::string>& extensions, const std::string& extension) {
+    return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+bool IsHidden(const std::filesystem::path& relative) {
+    for (const auto& part : relative) {
+        std::string name = part.string();
+        if (name.size() > 1 && name[0] == '.' && name != "..") return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    PackOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Logger::Get().SetLevel(LogLevel::Warn);
+
+    std::error_code ec;
+    if (!std::filesystem::is_directory(options.input_dir, ec)) {
+        std::fprintf(stderr, "Not a directory: %s\n", options.input_dir.c_str());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Gather first so the package never contains itself
+    std::filesystem::path output = std::filesystem::absolute(options.output_path, ec);
+    std::vector<std::filesystem::path> files;
+    for (auto it = std::filesystem::recursive_directory_iterator(options.input_dir, ec);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (ec) break;
+        if (!it->is_regular_file(ec)) continue;
+
+        std::filesystem::path relative = it->path().lexically_relative(options.input_dir);
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        if (IsHidden(relative) || HasExtension(options.exclude_extensions, extension)) continue;
+        if (std::filesystem::absolute(it->path(), ec) == output) continue;
+
+        files.push_back(it->path());
+    }
+    if (ec) {
+        std::fprintf(stderr, "Cannot scan %s: %s\n", options.input_dir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    AssetPackageWriter writer;
+    writer.SetAlignment(options.alignment);
+
+    for (const auto& file : files) {
+        std::string relative = file.lexically_relative(options.input_dir).generic_string();
+        std::string asset_path = options.prefix.empty() ? relative : options.prefix + "/" + relative;
+
+        std::string extension = file.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        bool compress = options.compress && !HasExtension(options.store_extensions, extension);
+
+        if (options.verbose) {
+            std::printf("  %s%s\n", asset_path.c_str(), compress ? "" : " (stored)");
+        }
+        writer.AddFile(asset_path, file.string(), compress);
+    }
+
+    AssetPackageStats stats;
+    if (!writer.Write(options.output_path, &stats)) {
+        std::fprintf(stderr, "Failed to write %s\n", options.output_path.c_str());
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double ratio = stats.raw_size > 0 ? static_cast<double>(stats.stored_size) / stats.raw_size : 1.0;
+    std::printf("Packed %u files (%u compressed) into %s\n", stats.entry_count, stats.compressed_count,
+                options.output_path.c_str());
+    std::printf("  %.2f MB -> %.2f MB (%.0f%%), package %.2f MB, %.2fs\n",
+                stats.raw_size / (1024.0 * 1024.0), stats.stored_size / (1024.0 * 1024.0), ratio * 100.0,
+                stats.file_size / (1024.0 * 1024.0), seconds);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "physics/physics_world.h"
+#include "core/logging.h"
+#include "core/jobs/job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Physics Benchmark
+ *
+ * Headless PhysicsWorld broad-phase benchmark: a field of mostly static
+ * colliders with a few dynamic ones wandering around, updated and queried
+ * every frame like Engine::Update does.
+ *
+ * Reports:
+ * - UpdateSpatialHash cost per frame (average, worst)
+ * - Dynamic colliders re-inserted per frame
+ * - DetectCollisions cost per frame and touching pairs
+ * - Cost of the per-frame overlap and raycast queries
+ *
+ * --full-rebuild re-inserts every collider every frame, for comparison with
+ * a rebuild-everything broad-phase.
+ *
+ * Usage:
+ *   PhysicsBench [options]
+ */
+
+using namespace action;
+
+namespace {
+
+struct BenchOptions {
+    u32 colliders = 20000;
+    float dynamic_fraction = 0.05f;
+    u32 frames = 600;
+    float dt = 1.0f / 60.0f;
+    float world_size = 1000.0f;   // Colliders spread over world_size x world_size meters
+    float cell_size = 4.0f;
+    float speed = 5.0f;           // m/s of dynamic colliders
+    u32 queries = 200;            // Overlaps and raycasts per frame (each)
+    u32 seed = 1;
+    u32 workers = 0;              // Job system workers for DetectCollisions (0 = serial)
+    bool full_rebuild = false;
+};
+
+void PrintUsage() {
+    std::printf(
+        "Usage: PhysicsBench [options]\n"
+        "  --colliders <n>          Total colliders (default 20000)\n"
+        "  --dynamic <fraction>     Fraction of dynamic colliders (default 0.05)\n"
+        "  --frames <n>             Frames to simulate (default 600)\n"
+        "  --dt <s>                 Frame time (default 1/60)\n"
+        "  --world-size <m>         Side of the populated square (default 1000)\n"
+        "  --cell-size <m>          Spatial hash cell size (default 4)\n"
+        "  --speed <m/s>            Dynamic collider speed (default 5)\n"
+        "  --queries <n>            Overlaps and raycasts per frame (default 200)\n"
+        "  --seed <n>               Random seed (default 1)\n"
+        "  --workers <n>            Job workers for collision detection (default 0: serial)\n"
+        "  --full-rebuild           Re-insert every collider every frame\n");
+}
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+        if (arg == "--full-rebuild") {
+            options.full_rebuild = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--colliders") options.colliders = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--dynamic") options.dynamic_fraction = std::strtof(value, nullptr);
+        else if (arg == "--frames") options.frames = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--dt") options.dt = std::strtof(value, nullptr);
+        else if (arg == "--world-size") options.world_size = std::strtof(value, nullptr);
+        else if (arg == "--cell-size") options.cell_size = std::strtof(value, nullptr);
+        else if (arg == "--speed") options.speed = std::strtof(value, nullptr);
+        else if (arg == "--queries") options.queries = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--seed") options.seed = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--workers") options.workers = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            PrintUsage();
+            return false;
+        }
+    }
+    return options.colliders > 0 && options.cell_size > 0.0f && options.world_size > 0.0f;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Logger::Get().SetLevel(LogLevel::Warn);
+
+    ECS ecs;
+    PhysicsWorld world;
+    world.Initialize(&ecs, options.cell_size);
+
+    JobSystem jobs;
+    if (options.workers > 0 && jobs.Initialize(options.workers)) {
+        world.SetJobSystem(&jobs);
+    }
+
+    std::mt19937 rng(options.seed);
+    float half = options.world_size * 0.5f;
+    std::uniform_real_distribution<float> position(-half, half);
+    std::uniform_real_distribution<float> size(0.25f, 2.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // Static props (boxes, rocks) and dynamic characters (capsules)
+    std::vector<Entity> colliders;
+    std::vector<Entity> dynamic;
+    std::vector<vec3> velocities;
+    colliders.reserve(options.colliders);
+    for (u32 i = 0; i < options.colliders; ++i) {
+        bool is_dynamic = static_cast<float>(i) < options.colliders * options.dynamic_fraction;
+
+        Entity entity = ecs.CreateEntity();
+        auto& transform = ecs.AddComponent<TransformComponent>(entity);
+        transform.position = {position(rng), 0.0f, position(rng)};
+
+        auto& collider = ecs.AddComponent<ColliderComponent>(entity);
+        if (is_dynamic) {
+            collider.type = ColliderType::Capsule;
+            collider.radius = 0.4f;
+            collider.height = 1.8f;
+            collider.layer = CollisionLayer::Enemy;
+
+            dynamic.push_back(entity);
+            vec3 direction{unit(rng), 0.0f, unit(rng)};
+            velocities.push_back(direction.length() > EPSILON ? direction.normalized() * options.speed : vec3{options.speed, 0, 0});
+        } else {
+            collider.type = i % 2 ? ColliderType::Box : ColliderType::Sphere;
+            collider.half_extents = {size(rng), size(rng), size(rng)};
+            collider.radius = size(rng);
+            collider.layer = CollisionLayer::Environment;
+            collider.is_static = true;
+        }
+
+        world.AddCollider(entity);
+        colliders.push_back(entity);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    world.UpdateSpatialHash();
+    double initial_ms = MillisecondsSince(start);
+
+    double update_total = 0.0;
+    double update_worst = 0.0;
+    double query_total = 0.0;
+    double detect_total = 0.0;
+    u64 pair_total = 0;
+    u64 moved_total = 0;
+    u64 overlap_hits = 0;
+    u64 ray_hits = 0;
+    std::vector<Entity> overlaps;
+
+    for (u32 frame = 0; frame < options.frames; ++frame) {
+        // Wander, bouncing off the edges of the populated square
+        for (size_t i = 0; i < dynamic.size(); ++i) {
+            auto* transform = ecs.GetComponent<TransformComponent>(dynamic[i]);
+            vec3& velocity = velocities[i];
+            transform->position = transform->position + velocity * options.dt;
+            if (std::abs(transform->position.x) > half) velocity.x = -velocity.x;
+            if (std::abs(transform->position.z) > half) velocity.z = -velocity.z;
+        }
+
+        start = std::chrono::steady_clock::now();
+        if (options.full_rebuild) {
+            for (Entity entity : colliders) {
+                world.RefreshCollider(entity);
+            }
+        }
+        world.UpdateSpatialHash();
+        double update_ms = MillisecondsSince(start);
+        update_total += update_ms;
+        update_worst = std::max(update_worst, update_ms);
+
+        start = std::chrono::steady_clock::now();
+        world.DetectCollisions();
+        detect_total += MillisecondsSince(start);
+        pair_total += world.GetContactPairCount();
+        moved_total += world.GetMovedColliderCount();
+
+        start = std::chrono::steady_clock::now();
+        for (u32 q = 0; q < options.queries; ++q) {
+            vec3 origin{position(rng), 1.0f, position(rng)};
+            world.OverlapSphere(origin, 3.0f, overlaps);
+            overlap_hits += overlaps.size();
+
+            vec3 direction{unit(rng), 0.0f, unit(rng)};
+            if (world.Raycast(origin, direction, 50.0f, CollisionLayer::Environment)) {
+                ++ray_hits;
+            }
+        }
+        query_total += MillisecondsSince(start);
+    }
+
+    u32 frames = std::max(options.frames, 1u);
+    std::printf("PhysicsBench: %u colliders (%zu dynamic), %u frames, cell %.1fm%s\n",
+                world.GetColliderCount(), dynamic.size(), options.frames, options.cell_size,
+                options.full_rebuild ? ", full rebuild" : "");
+    std::printf("  initial insert    %8.3f ms\n", initial_ms);
+    std::printf("  UpdateSpatialHash %8.3f ms avg, %.3f ms worst\n", update_total / frames, update_worst);
+    std::printf("  moved per frame   %8.1f colliders\n", static_cast<double>(moved_total) / frames);
+    std::printf("  DetectCollisions  %8.3f ms avg, %.1f touching pairs (%u workers)\n",
+                detect_total / frames, static_cast<double>(pair_total) / frames, options.workers);
+    std::printf("  queries per frame %8.3f ms (%u overlaps, %u rays; %.2f overlaps/query, %.0f%% rays hit)\n",
+                query_total / frames, options.queries, options.queries,
+                options.queries > 0 ? static_cast<double>(overlap_hits) / (static_cast<double>(options.queries) * frames) : 0.0,
+                options.queries > 0 ? 100.0 * ray_hits / (static_cast<double>(options.queries) * frames) : 0.0);
+    if (options.workers > 0) {
+        jobs.Shutdown();
+    }
+    return 0;
+}
@@ -0,0 +1,458 @@
+#include "world/world_manager.h"
+#include "core/logging.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * Streaming Simulator
+ *
+ * Headless replay of a camera path through WorldManager streaming.
+ * No window, renderer or GPU - chunks are filled with synthetic content
+ * so zone radii, prediction and per-frame budgets can be tuned offline.
+ *
+ * Reports:
+ * - Pop-in: chunk inside the view frustum and draw distance, not yet loaded
+ * - Peak streaming memory and loaded chunk count
+ * - Load/unload queue and delta I/O queue depth
+ * - WorldManager::Update cost per frame (and UpdateObject cost with --moving-objects)
+ *
+ * Usage:
+ *   StreamingSim [--path file.csv | --pattern line|circle|zigzag] [options]
+ *
+ * Path CSV: one "t,x,y,z" row per waypoint (seconds, meters), '#' comments.
+ */
+
+using namespace action;
+
+namespace {
+
+struct SimOptions {
+    std::string path_file;
+    std::string pattern = "line";
+    std::string csv_out;
+    std::string delta_dir;
+
+    float speed = 30.0f;        // m/s for scripted patterns
+    float dt = 1.0f / 60.0f;
+    u32 frames = 0;             // 0 = length of the path
+    float duration = 60.0f;     // Scripted pattern length (seconds)
+
+    u32 objects_per_chunk = 200;
+    u32 bytes_per_object = 64 * 1024;
+    u32 moving_objects = 0;
+
+    WorldManagerConfig world;
+};
+
+struct Waypoint {
+    float time;
+    vec3 position;
+};
+
+void PrintUsage() {
+    std::printf(
+        "Usage: StreamingSim [options]\n"
+        "  --path <file.csv>         Replay waypoints (t,x,y,z)\n"
+        "  --pattern <name>          line | circle | zigzag (default line)\n"
+        "  --speed <m/s>             Pattern speed (default 30)\n"
+        "  --duration <s>            Pattern length (default 60)\n"
+        "  --frames <n>              Frames to simulate (default: whole path)\n"
+        "  --dt <s>                  Frame time (default 1/60)\n"
+        "  --chunk-size <m>          Chunk size\n"
+        "  --hot/--warm/--cold <m>   Zone radii\n"
+        "  --draw-distance <m>       Pop-in test distance\n"
+        "  --prediction <s>          Velocity look-ahead\n"
+        "  --max-loads <n>           Chunk loads per frame\n"
+        "  --max-unloads <n>         Chunk unloads per frame\n"
+        "  --objects-per-chunk <n>   Synthetic objects per chunk (default 200)\n"
+        "  --bytes-per-object <n>    Synthetic memory per object (default 64K)\n"
+        "  --moving-objects <n>      Objects moved every frame via UpdateObject\n"
+        "  --delta-dir <dir>         Persist chunk deltas (exercises delta I/O)\n"
+        "  --csv <file>              Write per-frame stats\n");
+}
+
+bool ParseOptions(int argc, char** argv, SimOptions& options) {
+    options.world.origin_rebase_distance = 0.0f;  // Path coordinates stay absolute
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--path") options.path_file = value;
+        else if (arg == "--pattern") options.pattern = value;
+        else if (arg == "--csv") options.csv_out = value;
+        else if (arg == "--delta-dir") options.delta_dir = value;
+        else if (arg == "--speed") options.speed = std::strtof(value, nullptr);
+        else if (arg == "--duration") options.duration = std::strtof(value, nullptr);
+        else if (arg == "--frames") options.frames = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--dt") options.dt = std::strtof(value, nullptr);
+        else if (arg == "--chunk-size") options.world.chunk_size = std::strtof(value, nullptr);
+        else if (arg == "--hot") options.world.hot_zone_radius = std::strtof(value, nullptr);
+        else if (arg == "--warm") options.world.warm_zone_radius = std::strtof(value, nullptr);
+        else if (arg == "--cold") options.world.cold_zone_radius = std::strtof(value, nullptr);
+        else if (arg == "--draw-distance") options.world.draw_distance = std::strtof(value, nullptr);
+        else if (arg == "--prediction") options.world.prediction_time = std::strtof(value, nullptr);
+        else if (arg == "--max-loads") options.world.max_loads_per_frame = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--max-unloads") options.world.max_unloads_per_frame = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--objects-per-chunk") options.objects_per_chunk = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--bytes-per-object") options.bytes_per_object = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--moving-objects") options.moving_objects = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if (options.dt <= 0.0f || options.world.chunk_size <= 0.0f) {
+        std::fprintf(stderr, "--dt and --chunk-size must be positive\n");
+        return false;
+    }
+
+    options.world.delta_directory = options.delta_dir;
+    return true;
+}
+
+bool LoadPath(const std::string& file, std::vector<Waypoint>& out) {
+    std::ifstream in(file);
+    if (!in) {
+        std::fprintf(stderr, "Cannot open path %s\n", file.c_str());
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::replace(line.begin(), line.end(), ',', ' ');
+
+        std::istringstream row(line);
+        Waypoint wp{};
+        if (row >> wp.time >> wp.position.x >> wp.position.y >> wp.position.z) {
+            out.push_back(wp);
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](const Waypoint& a, const Waypoint& b) {
+        return a.time < b.time;
+    });
+
+    if (out.size() < 2) {
+        std::fprintf(stderr, "Path %s needs at least two waypoints\n", file.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool BuildPattern(const SimOptions& options, std::vector<Waypoint>& out) {
+    constexpr u32 SAMPLES = 512;
+
+    for (u32 i = 0; i <= SAMPLES; ++i) {
+        float t = options.duration * static_cast<float>(i) / SAMPLES;
+        float d = options.speed * t;
+        vec3 p;
+
+        if (options.pattern == "line") {
+            p = vec3(d, 2.0f, 0.0f);
+        } else if (options.pattern == "circle") {
+            float radius = std::max(options.world.chunk_size * 2.0f, 1.0f);
+            float angle = d / radius;
+            p = vec3(std::cos(angle) * radius, 2.0f, std::sin(angle) * radius);
+        } else if (options.pattern == "zigzag") {
+            // Sharp turns every 300m defeat velocity prediction
+            float leg = 300.0f;
+            float along = std::fmod(d, 2.0f * leg);
+            float side = along < leg ? along : 2.0f * leg - along;
+            p = vec3(d * 0.7071f, 2.0f, side);
+        } else {
+            std::fprintf(stderr, "Unknown pattern %s\n", options.pattern.c_str());
+            return false;
+        }
+
+        out.push_back({t, p});
+    }
+    return true;
+}
+
+vec3 SamplePath(const std::vector<Waypoint>& path, float time) {
+    if (time <= path.front().time) return path.front().position;
+    if (time >= path.back().time) return path.back().position;
+
+    auto it = std::upper_bound(path.begin(), path.end(), time, [](float t, const Waypoint& wp) {
+        return t < wp.time;
+    });
+    const Waypoint& b = *it;
+    const Waypoint& a = *(it - 1);
+
+    float span = b.time - a.time;
+    float f = span > 0.0f ? (time - a.time) / span : 0.0f;
+    return a.position + (b.position - a.position) * f;
+}
+
+// Deterministic per-chunk noise so repeated runs stream identical content
+u32 HashCoord(ChunkCoord coord, u32 salt) {
+    u32 h = static_cast<u32>(coord.x) * 73856093u ^ static_cast<u32>(coord.z) * 19349663u ^ salt * 83492791u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return h;
+}
+
+float Percentile(std::vector<double> values, float p) {
+    if (values.empty()) return 0.0f;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * static_cast<float>(values.size() - 1));
+    return static_cast<float>(values[index]);
+}
+
+struct FrameSample {
+    double update_ms = 0.0;
+    double object_update_ms = 0.0;
+    u32 loaded_chunks = 0;
+    size_t memory = 0;
+    u32 pop_ins = 0;
+    StreamingStats stream;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Streaming logs every chunk at Debug/Info; keep the report readable
+    Logger::Get().SetLevel(LogLevel::Warn);
+
+    std::vector<Waypoint> path;
+    bool path_ok = options.path_file.empty() ? BuildPattern(options, path)
+                                             : LoadPath(options.path_file, path);
+    if (!path_ok) {
+        return 1;
+    }
+
+    u32 frame_count = options.frames;
+    if (frame_count == 0) {
+        frame_count = static_cast<u32>((path.back().time - path.front().time) / options.dt) + 1;
+    }
+
+    WorldManager world;
+    if (!world.Initialize(options.world)) {
+        std::fprintf(stderr, "WorldManager initialization failed\n");
+        return 1;
+    }
+
+    const WorldManagerConfig& config = world.GetConfig();
+
+    // Synthetic authored content: static scenery scattered over each chunk
+    world.SetChunkLoadCallback([&options, &config](Chunk& chunk) {
+        chunk.objects.reserve(chunk.objects.size() + options.objects_per_chunk);
+        chunk.entities.reserve(chunk.entities.size() + options.objects_per_chunk);
+
+        for (u32 i = 0; i < options.objects_per_chunk; ++i) {
+            u32 h = HashCoord(chunk.coord, i);
+            float u = static_cast<float>(h & 0xFFFF) / 65535.0f;
+            float v = static_cast<float>(h >> 16) / 65535.0f;
+
+            WorldObject obj;
+            obj.position = vec3(chunk.bounds.min.x + u * config.chunk_size, 0.0f,
+                                chunk.bounds.min.z + v * config.chunk_size);
+            obj.bounds = AABB(obj.position - vec3(1.0f, 1.0f, 1.0f), obj.position + vec3(1.0f, 1.0f, 1.0f));
+            obj.lod_level = 0;
+            obj.visible = true;
+
+            chunk.objects.push_back(obj);
+            chunk.entities.push_back(INVALID_ENTITY);
+        }
+
+        chunk.memory_usage += static_cast<size_t>(options.objects_per_chunk) * options.bytes_per_object;
+    });
+
+    // Dynamic objects orbiting the camera (exercises UpdateObject at scale)
+    std::vector<Entity> movers(options.moving_objects);
+    vec3 start = SamplePath(path, path.front().time);
+    for (u32 i = 0; i < options.moving_objects; ++i) {
+        movers[i] = MakeEntity(i, 0);
+
+        WorldObject obj;
+        obj.entity = movers[i];
+        obj.position = start;
+        obj.bounds = AABB(start - vec3(0.5f, 0.5f, 0.5f), start + vec3(0.5f, 0.5f, 0.5f));
+        obj.lod_level = 0;
+        obj.visible = true;
+        world.AddObject(obj);
+    }
+
+    std::ofstream csv;
+    if (!options.csv_out.empty()) {
+        csv.open(options.csv_out, std::ios::out | std::ios::trunc);
+        csv << "frame,time,x,z,update_ms,object_update_ms,loaded_chunks,memory_bytes,"
+               "pop_ins,loads,unloads,load_queue,unload_queue,delta_reads,delta_writes\n";
+    }
+
+    Camera camera;
+    camera.up = vec3(0.0f, 1.0f, 0.0f);
+    camera.forward = vec3(1.0f, 0.0f, 0.0f);
+    camera.far_plane = config.draw_distance;
+
+    std::vector<FrameSample> samples;
+    samples.reserve(frame_count);
+
+    std::unordered_set<ChunkCoord, ChunkCoordHash> missing;
+    std::unordered_set<ChunkCoord, ChunkCoordHash> missing_now;
+    u32 pop_in_events = 0;
+    u32 pop_in_frames = 0;
+
+    using Clock = std::chrono::steady_clock;
+    i32 chunk_radius = static_cast<i32>(std::ceil(config.draw_distance / config.chunk_size));
+
+    vec3 prev_pos = start;
+    for (u32 frame = 0; frame < frame_count; ++frame) {
+        float time = path.front().time + static_cast<float>(frame) * options.dt;
+        vec3 pos = SamplePath(path, time);
+        vec3 velocity = (pos - prev_pos) * (1.0f / options.dt);
+        prev_pos = pos;
+
+        FrameSample sample;
+
+        if (!movers.empty()) {
+            auto begin = Clock::now();
+            for (u32 i = 0; i < static_cast<u32>(movers.size()); ++i) {
+                float angle = time * 0.5f + static_cast<float>(i) * 0.001f;
+                float radius = 20.0f + static_cast<float>(i % 64) * 4.0f;
+                vec3 p = pos + vec3(std::cos(angle) * radius, 0.0f, std::sin(angle) * radius);
+                world.UpdateObject(movers[i], p, vec4(0.8f, 0.8f, 0.8f, 1.0f));
+            }
+            sample.object_update_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        }
+
+        auto begin = Clock::now();
+        world.Update(pos, velocity, options.dt);
+        sample.update_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+        // Camera looks along the direction of travel
+        if (length(velocity) > EPSILON) {
+            camera.forward = normalize(vec3(velocity.x, 0.0f, velocity.z));
+        }
+        camera.position = pos;
+        Frustum frustum = camera.GetFrustum();
+
+        // Pop-in: visible chunk that is not ready yet. Counted once per
+        // episode, not once per frame it stays missing.
+        missing_now.clear();
+        ChunkCoord center = world.GetChunkCoord(pos);
+        for (i32 dz = -chunk_radius; dz <= chunk_radius; ++dz) {
+            for (i32 dx = -chunk_radius; dx <= chunk_radius; ++dx) {
+                ChunkCoord coord{center.x + dx, center.z + dz};
+                AABB bounds = world.GetChunkBounds(coord);
+
+                vec3 closest(std::clamp(pos.x, bounds.min.x, bounds.max.x),
+                             std::clamp(pos.y, bounds.min.y, bounds.max.y),
+                             std::clamp(pos.z, bounds.min.z, bounds.max.z));
+                if (length(closest - pos) > config.draw_distance) continue;
+                if (!frustum.intersects(bounds)) continue;
+
+                Chunk* chunk = world.GetChunk(coord);
+                bool ready = chunk && (chunk->state == ChunkState::Loaded ||
+                                       chunk->state == ChunkState::Active);
+                if (ready) continue;
+
+                missing_now.insert(coord);
+                if (!missing.contains(coord)) {
+                    ++pop_in_events;
+                }
+            }
+        }
+        missing.swap(missing_now);
+        sample.pop_ins = static_cast<u32>(missing.size());
+        if (sample.pop_ins > 0) ++pop_in_frames;
+
+        sample.loaded_chunks = world.GetLoadedChunkCount();
+        sample.memory = world.GetMemoryUsage();
+        sample.stream = world.GetStreamingStats();
+        samples.push_back(sample);
+
+        if (csv.is_open()) {
+            csv << frame << ',' << time << ',' << pos.x << ',' << pos.z << ','
+                << sample.update_ms << ',' << sample.object_update_ms << ','
+                << sample.loaded_chunks << ',' << sample.memory << ',' << sample.pop_ins << ','
+                << sample.stream.chunks_loaded << ',' << sample.stream.chunks_unloaded << ','
+                << sample.stream.load_queue_depth << ',' << sample.stream.unload_queue_depth << ','
+                << sample.stream.pending_delta_reads << ',' << sample.stream.pending_delta_writes << '\n';
+        }
+    }
+
+    world.Shutdown();
+
+    // Summary
+    std::vector<double> update_ms;
+    std::vector<double> object_ms;
+    update_ms.reserve(samples.size());
+    object_ms.reserve(samples.size());
+
+    size_t peak_memory = 0;
+    u32 peak_chunks = 0;
+    u32 peak_load_queue = 0;
+    u32 peak_delta_queue = 0;
+    u32 total_loads = 0;
+    u32 total_unloads = 0;
+    double load_queue_sum = 0.0;
+    double update_sum = 0.0;
+
+    for (const auto& s : samples) {
+        update_ms.push_back(s.update_ms);
+        update_sum += s.update_ms;
+        object_ms.push_back(s.object_update_ms);
+        peak_memory = std::max(peak_memory, s.memory);
+        peak_chunks = std::max(peak_chunks, s.loaded_chunks);
+        peak_load_queue = std::max(peak_load_queue, s.stream.load_queue_depth);
+        peak_delta_queue = std::max(peak_delta_queue,
+                                    s.stream.pending_delta_reads + s.stream.pending_delta_writes);
+        total_loads += s.stream.chunks_loaded;
+        total_unloads += s.stream.chunks_unloaded;
+        load_queue_sum += s.stream.load_queue_depth;
+    }
+
+    std::printf("Streaming simulation: %u frames (%.1fs), %s\n",
+                frame_count, frame_count * options.dt,
+                options.path_file.empty() ? options.pattern.c_str() : options.path_file.c_str());
+    std::printf("  config   chunk %.0fm  hot/warm/cold %.0f/%.0f/%.0fm  draw %.0fm  predict %.1fs  budget %u/%u\n",
+                config.chunk_size, config.hot_zone_radius, config.warm_zone_radius,
+                config.cold_zone_radius, config.draw_distance, config.prediction_time,
+                config.max_loads_per_frame, config.max_unloads_per_frame);
+    std::printf("  pop-in   %u events, %u frames (%.2f%%)\n",
+                pop_in_events, pop_in_frames,
+                frame_count ? 100.0 * pop_in_frames / frame_count : 0.0);
+    std::printf("  memory   peak %.1f MB, peak %u chunks\n",
+                peak_memory / (1024.0 * 1024.0), peak_chunks);
+    std::printf("  queues   loads %u, unloads %u, load queue avg %.1f peak %u, delta I/O peak %u\n",
+                total_loads, total_unloads,
+                samples.empty() ? 0.0 : load_queue_sum / samples.size(),
+                peak_load_queue, peak_delta_queue);
+    std::printf("  update   avg %.3f ms  p95 %.3f ms  max %.3f ms\n",
+                samples.empty() ? 0.0 : update_sum / samples.size(),
+                Percentile(update_ms, 0.95f), Percentile(update_ms, 1.0f));
+    if (!movers.empty()) {
+        std::printf("  objects  %u moving, UpdateObject p95 %.3f ms/frame\n",
+                    options.moving_objects, Percentile(object_ms, 0.95f));
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "world/world_manager.h"
+#include "core/logging.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * World Benchmark
+ *
+ * Headless WorldManager object-index benchmark: moving objects spread over
+ * many chunks. Every frame each object is moved with UpdateObject, and a
+ * fraction of them is removed with RemoveObject and added back.
+ *
+ * Reports:
+ * - UpdateObject cost per frame (average, worst) and per call
+ * - Moves that crossed a chunk boundary
+ * - RemoveObject cost per call
+ *
+ * Usage:
+ *   WorldBench [options]
+ */
+
+using namespace action;
+
+namespace {
+
+struct BenchOptions {
+    u32 objects = 10000;
+    u32 frames = 600;
+    float dt = 1.0f / 60.0f;
+    float world_size = 2048.0f;   // Objects spread over world_size x world_size meters
+    float chunk_size = 64.0f;
+    float speed = 10.0f;          // m/s
+    float churn = 0.01f;          // Fraction removed and re-added per frame
+    u32 seed = 1;
+};
+
+void PrintUsage() {
+    std::printf(
+        "Usage: WorldBench [options]\n"
+        "  --objects <n>            Moving objects (default 10000)\n"
+        "  --frames <n>             Frames to simulate (default 600)\n"
+        "  --dt <s>                 Frame time (default 1/60)\n"
+        "  --world-size <m>         Side of the populated square (default 2048)\n"
+        "  --chunk-size <m>         Chunk size (default 64)\n"
+        "  --speed <m/s>            Object speed (default 10)\n"
+        "  --churn <fraction>       Objects removed and re-added per frame (default 0.01)\n"
+        "  --seed <n>               Random seed (default 1)\n");
+}
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (arg == "--objects") options.objects = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--frames") options.frames = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--dt") options.dt = std::strtof(value, nullptr);
+        else if (arg == "--world-size") options.world_size = std::strtof(value, nullptr);
+        else if (arg == "--chunk-size") options.chunk_size = std::strtof(value, nullptr);
+        else if (arg == "--speed") options.speed = std::strtof(value, nullptr);
+        else if (arg == "--churn") options.churn = std::strtof(value, nullptr);
+        else if (arg == "--seed") options.seed = static_cast<u32>(std::strtoul(value, nullptr, 10));
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            PrintUsage();
+            return false;
+        }
+    }
+    return options.objects > 0 && options.chunk_size > 0.0f && options.world_size > 0.0f;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+WorldObject MakeObject(Entity entity, const vec3& position) {
+    WorldObject obj;
+    obj.entity = entity;
+    obj.position = position;
+    obj.bounds = AABB(position - vec3(0.5f, 0.5f, 0.5f), position + vec3(0.5f, 0.5f, 0.5f));
+    obj.lod_level = 0;
+    obj.visible = true;
+    return obj;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Chunk loads log at Debug; keep the report readable
+    Logger::Get().SetLevel(LogLevel::Warn);
+
+    WorldManagerConfig config;
+    config.chunk_size = options.chunk_size;
+    config.origin_rebase_distance = 0.0f;
+    WorldManager world;
+    if (!world.Initialize(config)) {
+        std::fprintf(stderr, "WorldManager initialization failed\n");
+        return 1;
+    }
+
+    std::mt19937 rng(options.seed);
+    float half = options.world_size * 0.5f;
+    std::uniform_real_distribution<float> coordinate(-half, half);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<Entity> entities(options.objects);
+    std::vector<vec3> positions(options.objects);
+    std::vector<vec3> velocities(options.objects);
+    for (u32 i = 0; i < options.objects; ++i) {
+        entities[i] = MakeEntity(i, 0);
+        positions[i] = {coordinate(rng), 0.0f, coordinate(rng)};
+        vec3 direction{unit(rng), 0.0f, unit(rng)};
+        velocities[i] = length(direction) > EPSILON ? normalize(direction) * options.speed : vec3{options.speed, 0, 0};
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < options.objects; ++i) {
+        world.AddObject(MakeObject(entities[i], positions[i]));
+    }
+    double add_ms = MillisecondsSince(start);
+
+    u32 churn_count = std::min(options.objects, static_cast<u32>(static_cast<float>(options.objects) * options.churn));
+    std::uniform_int_distribution<u32> pick(0, options.objects - 1);
+    std::vector<u32> churned(churn_count);
+
+    double update_total = 0.0;
+    double update_worst = 0.0;
+    double remove_total = 0.0;
+    u64 crossings = 0;
+    u64 removals = 0;
+    const vec4 color(0.8f, 0.8f, 0.8f, 1.0f);
+
+    for (u32 frame = 0; frame < options.frames; ++frame) {
+        // Bounce off the edges of the populated square
+        for (u32 i = 0; i < options.objects; ++i) {
+            vec3 next = positions[i] + velocities[i] * options.dt;
+            if (std::abs(next.x) > half) velocities[i].x = -velocities[i].x;
+            if (std::abs(next.z) > half) velocities[i].z = -velocities[i].z;
+            if (world.GetChunkCoord(next) != world.GetChunkCoord(positions[i])) ++crossings;
+            positions[i] = next;
+        }
+
+        start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < options.objects; ++i) {
+            world.UpdateObject(entities[i], positions[i], color);
+        }
+        double update_ms = MillisecondsSince(start);
+        update_total += update_ms;
+        update_worst = std::max(update_worst, update_ms);
+
+        // Despawn a few objects and spawn them again (AddObject is not timed)
+        for (u32& index : churned) {
+            index = pick(rng);
+        }
+        start = std::chrono::steady_clock::now();
+        for (u32 index : churned) {
+            world.RemoveObject(entities[index]);
+        }
+        remove_total += MillisecondsSince(start);
+        removals += churned.size();
+        for (u32 index : churned) {
+            world.AddObject(MakeObject(entities[index], positions[index]));
+        }
+    }
+
+    u32 frames = std::max(options.frames, 1u);
+    double updates = static_cast<double>(options.objects) * frames;
+    std::printf("WorldBench: %u objects, %u frames, chunk %.0fm, %u chunks loaded\n",
+                options.objects, options.frames, options.chunk_size, world.GetLoadedChunkCount());
+    std::printf("  initial add       %8.3f ms\n", add_ms);
+    std::printf("  UpdateObject      %8.3f ms/frame avg, %.3f ms worst, %.1f ns/call\n",
+                update_total / frames, update_worst, update_total * 1e6 / updates);
+    std::printf("  chunk crossings   %8.1f per frame\n", static_cast<double>(crossings) / frames);
+    std::printf("  RemoveObject      %8.1f ns/call (%u per frame)\n",
+                removals > 0 ? remove_total * 1e6 / static_cast<double>(removals) : 0.0, churn_count);
+
+    world.Shutdown();
+    return 0;
+}